@@ -6,7 +6,7 @@
 
 #include "const_torque_control.hpp"
 #include <fstream>
-#include "real_time_tools/spinner.hpp"
+#include "blmc_drivers/utils/hybrid_spinner.hpp"
 #include "real_time_tools/timer.hpp"
 
 namespace blmc_drivers
@@ -23,7 +23,7 @@ void ConstTorqueControl::loop()
     // here is the control in current (Ampere)
     double desired_current = 0.0;
 
-    real_time_tools::Spinner spinner;
+    blmc_drivers::HybridSpinner spinner;
     spinner.set_period(0.001);  // here we spin every 1ms
     real_time_tools::Timer time_logger;
     size_t count = 0;
@@ -68,6 +68,7 @@ void ConstTorqueControl::loop()
         }  // endfor
     }      // endwhile
     time_logger.dump_measurements("/tmp/demo_pd_control_time_measurement");
+    spinner.print_statistics();
 }
 
 void ConstTorqueControl::stop_loop()
@@ -10,6 +10,7 @@
 #include "blmc_drivers/devices/can_bus.hpp"
 #include "blmc_drivers/devices/motor.hpp"
 #include "blmc_drivers/devices/motor_board.hpp"
+#include "blmc_drivers/utils/hybrid_spinner.hpp"
 
 typedef std::tuple<std::shared_ptr<blmc_drivers::MotorInterface>,
                    std::shared_ptr<blmc_drivers::AnalogSensorInterface>>
@@ -29,7 +30,7 @@ static THREAD_FUNCTION_RETURN_TYPE control_loop(void *hardware_ptr)
     Hardware &hardware = *(static_cast<Hardware *>(hardware_ptr));
 
     // torque controller -------------------------------------------------------
-    real_time_tools::Spinner spinner;
+    blmc_drivers::HybridSpinner spinner;
     spinner.set_period(0.001);
     while (true)
     {
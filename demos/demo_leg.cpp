@@ -8,7 +8,7 @@
 #include <blmc_drivers/devices/analog_sensor.hpp>
 #include <blmc_drivers/devices/leg.hpp>
 #include <blmc_drivers/devices/motor.hpp>
-#include "real_time_tools/spinner.hpp"
+#include "blmc_drivers/utils/hybrid_spinner.hpp"
 #include "real_time_tools/timer.hpp"
 
 #include <signal.h>
@@ -90,7 +90,7 @@ private:
      */
     void loop()
     {
-        real_time_tools::Spinner time_spinner;
+        blmc_drivers::HybridSpinner time_spinner;
         time_spinner.set_period(0.001);  // 1kz loop
         size_t count = 0;
         while (true)
@@ -189,7 +189,7 @@ private:
      */
     void loop()
     {
-        real_time_tools::Spinner spinner;
+        blmc_drivers::HybridSpinner spinner;
         spinner.set_period(0.001);  // 1kz loop
         size_t count = 0;
         while (!stop_loop_)
@@ -0,0 +1,81 @@
+/**
+ * @file demo_robot_description.cpp
+ * @copyright Copyright (c) 2026, Max Planck Gesellschaft, License
+ * BSD-3-Clause
+ * @brief Bring up a robot from a description file (see
+ * doc/robot_description.md) and print its joint angles.
+ */
+
+#include <signal.h>
+#include <atomic>
+#include <iostream>
+
+#include <blmc_drivers/blmc_robot.hpp>
+#include "blmc_drivers/utils/hybrid_spinner.hpp"
+
+/**
+ * @brief This boolean is here to kill cleanly the application upon ctrl+c
+ */
+std::atomic_bool StopDemos(false);
+
+/**
+ * @brief This function is the callback upon a ctrl+c call from the terminal.
+ */
+void my_handler(int)
+{
+    StopDemos = true;
+}
+
+/**
+ * @brief This is the main demo program.
+ *
+ * @param argc
+ * @param argv is the path of the robot description.
+ * @return int
+ */
+int main(int argc, char **argv)
+{
+    if (argc != 2)
+    {
+        std::cout << "Usage: " << argv[0] << " <robot description>"
+                  << std::endl;
+        return 1;
+    }
+
+    // make sure we catch the ctrl+c signal to kill the application properly.
+    struct sigaction sigIntHandler;
+    sigIntHandler.sa_handler = my_handler;
+    sigemptyset(&sigIntHandler.sa_mask);
+    sigIntHandler.sa_flags = 0;
+    sigaction(SIGINT, &sigIntHandler, NULL);
+    StopDemos = false;
+
+    blmc_drivers::BlmcRobot robot(
+        blmc_drivers::load_robot_description(argv[1]));
+    std::vector<std::string> joint_names = robot.get_joint_names();
+    auto joints = robot.get_joint_modules();
+
+    // hold the joints with zero torques and print their angles.
+    Eigen::VectorXd torques = Eigen::VectorXd::Zero(joints->size());
+    Eigen::VectorXd angles(joints->size());
+    blmc_drivers::HybridSpinner spinner(0.001);
+    size_t count = 0;
+    while (!StopDemos)
+    {
+        joints->set_torques(torques);
+        joints->send_torques();
+        joints->get_measured_angles(angles);
+
+        if ((count % 1000) == 0)
+        {
+            for (size_t i = 0; i < joints->size(); i++)
+            {
+                rt_printf("%s: %f ", joint_names[i].c_str(), angles[i]);
+            }
+            rt_printf("\n");
+        }
+        count++;
+        spinner.spin();
+    }
+    return 0;
+}
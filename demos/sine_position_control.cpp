@@ -6,7 +6,7 @@
 
 #include "sine_position_control.hpp"
 #include <fstream>
-#include "real_time_tools/spinner.hpp"
+#include "blmc_drivers/utils/hybrid_spinner.hpp"
 #include "real_time_tools/timer.hpp"
 
 namespace blmc_drivers
@@ -30,7 +30,7 @@ void SinePositionControl::loop()
     double desired_velocity = 0.0;
     double desired_current = 0.0;
 
-    real_time_tools::Spinner spinner;
+    blmc_drivers::HybridSpinner spinner;
     spinner.set_period(control_period);  // here we spin every 1ms
     real_time_tools::Timer time_logger;
     size_t count = 0;
@@ -94,6 +94,7 @@ void SinePositionControl::loop()
 
     }  // endwhile
     time_logger.dump_measurements("/tmp/demo_pd_control_time_measurement");
+    spinner.print_statistics();
 }
 
 void SinePositionControl::stop_loop()
@@ -12,11 +12,17 @@
 #include <math.h>
 #include <array>
 #include <iostream>
+#include <memory>
 #include <stdexcept>
+#include <type_traits>
+#include <vector>
 
 #include <Eigen/Eigen>
 
 #include "blmc_drivers/devices/motor.hpp"
+#include "blmc_drivers/utils/alpha_beta_gamma_filter.hpp"
+#include "blmc_drivers/utils/friction_table.hpp"
+#include "blmc_drivers/utils/hybrid_spinner.hpp"
 #include "blmc_drivers/utils/polynome.hpp"
 
 namespace blmc_drivers
@@ -53,6 +59,140 @@ enum class GoToReturnCode
     FAILED
 };
 
+/**
+ * @brief Possible return values of the calibrations
+ */
+enum class CalibrationReturnCode
+{
+    //! Calibration was not initialized and can therefore not be performed.
+    NOT_INITIALIZED = 0,
+    //! Calibration is currently running.
+    RUNNING,
+    //! Calibration is succeeded.
+    SUCCEEDED,
+    //! Calibration failed.
+    FAILED
+};
+
+/**
+ * @brief Parameters of the friction calibration, see
+ * BlmcJointModule::init_friction_calibration().
+ */
+struct FrictionCalibrationParameters
+{
+    //! Lower end of the swept range (joint angle, rad).
+    double position_min = -M_PI;
+    //! Upper end of the swept range (joint angle, rad).
+    double position_max = M_PI;
+    //! Number of position nodes of the table.
+    size_t position_node_count = 64;
+    //! If the table repeats with period position_max - position_min.
+    bool is_periodic = false;
+    //! Highest sweep velocity (rad/s).
+    double max_velocity = 2.0;
+    //! Number of sweep velocities, evenly spaced up to max_velocity.
+    size_t velocity_level_count = 4;
+    //! P gain of the velocity controller (Nm s/rad).
+    double gain_p = 0.2;
+    //! I gain of the velocity controller (Nm/rad).
+    double gain_i = 2.0;
+    //! Max. torque of the velocity controller (Nm).
+    double max_torque = 0.5;
+    //! Time after each reversal before samples are taken (s).
+    double settling_time_s = 0.2;
+    //! Max. velocity error of samples, relative to the sweep velocity.
+    double velocity_tolerance = 0.2;
+    //! Period of the calls to update_friction_calibration() (s).
+    double control_period_s = 0.001;
+};
+
+/**
+ * @brief State variables required for the friction calibration.
+ */
+struct FrictionCalibrationState
+{
+    //! Parameters given to the initialization.
+    FrictionCalibrationParameters parameters;
+    //! Current sweep velocity, 1 to velocity_level_count.
+    size_t velocity_level = 0;
+    //! Direction of the current sweep (1 or -1).
+    double direction = -1.0;
+    //! Moving to position_min before the first sweep.
+    bool is_approaching = true;
+    //! Integral part of the velocity controller (Nm).
+    double torque_integral = 0.0;
+    //! Number of steps since the last reversal.
+    uint32_t step_count = 0;
+    //! Sum of the measured torques per node of the table.
+    std::vector<double> torque_sums;
+    //! Number of samples per node of the table.
+    std::vector<uint32_t> sample_counts;
+    //! The resulting table, only set when status is SUCCEEDED.
+    std::shared_ptr<FrictionTable> table;
+    //! Current status of the calibration.
+    CalibrationReturnCode status = CalibrationReturnCode::NOT_INITIALIZED;
+};
+
+/**
+ * @brief Parameters of the calibration on the encoder index, see
+ * BlmcJointModule::update_calibration().
+ */
+struct CalibrationParameters
+{
+    //! Velocity of the search for the encoder index (rad/s).  Set to a
+    //! negative value to search in negative direction.
+    double search_velocity = 0.8;
+    //! D gain of the velocity controller of the search (Nm s/rad).
+    double search_gain_d = 0.2;
+    //! Duration of the trajectory from the index to the zero position (s).
+    double return_duration_s = 2.0;
+    //! P gain of the position controller of the return (Nm/rad).
+    double gain_p = 2.5;
+    //! I gain of the position controller of the return (Nm/(rad s)).
+    double gain_i = 0.5;
+    //! Max. integral part of the position controller (Nm).
+    double max_torque_integral = 0.1;
+    //! Distance to the zero position at which it is reached (rad).
+    double position_tolerance = 1e-2;
+    //! Max. duration of the search and of the return after its trajectory
+    //! ended (s).
+    double timeout_s = 10.0;
+    //! Period of the calls to update_calibration() (s).
+    double control_period_s = 0.001;
+};
+
+/**
+ * @brief State variables required for the calibration on the encoder index.
+ */
+struct CalibrationState
+{
+    //! Id of the joint.  Just used for debug prints.
+    int joint_id = 0;
+    //! Parameters given to the initialization.
+    CalibrationParameters parameters;
+    //! If the zero position is set from the starting position.
+    bool mechanical_calibration = false;
+    //! Angle between the encoder index and the zero position (rad).
+    double angle_zero_to_index = 0.0;
+    //! Angle at which the index was found, relative to the boot position.
+    double index_angle = 0.0;
+    //! Position at which the calibration is started.
+    double start_position = 0.0;
+    //! Position at which the return to zero is started.
+    double return_start_position = 0.0;
+    //! Timestamp from when the encoder index was seen the last time (of the
+    //! encoder index events if the motor provides them).
+    long int last_encoder_index_time_index = 0;
+    //! Searching the encoder index, else returning to zero.
+    bool is_searching_index = true;
+    //! Number of steps since the start of the current phase.
+    uint32_t step_count = 0;
+    //! Integral part of the position controller (Nm).
+    double torque_integral = 0.0;
+    //! Current status of the calibration.
+    CalibrationReturnCode status = CalibrationReturnCode::NOT_INITIALIZED;
+};
+
 /**
  * @brief State variables required for the homing.
  */
@@ -66,7 +206,8 @@ struct HomingState
     double home_offset_rad = 0.0;
     //! Step size for the position profile.
     double profile_step_size_rad = 0.0;
-    //! Timestamp from when the encoder index was seen the last time.
+    //! Timestamp from when the encoder index was seen the last time (of the
+    //! encoder index events if the motor provides them).
     long int last_encoder_index_time_index = 0;
     //! Number of profile steps already taken.
     uint32_t step_count = 0;
@@ -116,12 +257,37 @@ public:
                     const double& max_current = 2.1);
 
     /**
-     * @brief Set the joint torque to be sent.
+     * @brief Set the joint torque to be sent.  The friction compensation, if
+     * any, is added to it.
      *
      * @param desired_torque (Nm)
      */
     void set_torque(const double& desired_torque);
 
+    /**
+     * @brief Add the torque of a table, looked up at the measured angle and
+     * velocity, to all torques set (feed-forward compensation of friction and
+     * cogging).  The sum is limited to the max. torque.
+     *
+     * The table is in joint angles, i.e. relative to the zero angle: use it
+     * only after the same homing it was calibrated with.
+     *
+     * @param table is e.g. the result of the friction calibration (nullptr
+     * to remove the compensation).
+     */
+    void set_friction_compensation(std::shared_ptr<const FrictionTable> table)
+    {
+        friction_compensation_ = table;
+    }
+
+    /**
+     * @brief Get the table of the friction compensation (may be nullptr).
+     */
+    std::shared_ptr<const FrictionTable> get_friction_compensation() const
+    {
+        return friction_compensation_;
+    }
+
     /**
      * @brief Set the zero_angle. The zero_angle is the angle between the
      * closest positive motor index and the zero configuration.
@@ -187,6 +353,104 @@ public:
      */
     double get_measured_index_angle() const;
 
+    /**
+     * @brief Get the encoder indices seen by the motor.
+     *
+     * @return nullptr if the motor does not provide them.
+     */
+    std::shared_ptr<const MotorInterface::EncoderIndexEventTimeseries>
+    get_encoder_index_events() const
+    {
+        return encoder_index_events_;
+    }
+
+    /**
+     * @brief Check if the homing or calibration searches the encoder index
+     * and the motor saw one which update_homing() or update_calibration()
+     * did not process yet.
+     */
+    bool has_pending_encoder_index() const;
+
+    /**
+     * @brief Wait until the motor saw an encoder index which the running
+     * homing or calibration did not process yet, so that the next update
+     * can react to it at once instead of at the next period.
+     *
+     * Only blocks if the motor provides encoder index events, otherwise
+     * returns has_pending_encoder_index().
+     *
+     * @param timeout_s is the max. time to wait (s).
+     * @return true if there is such an index.
+     */
+    bool wait_for_pending_encoder_index(const double& timeout_s) const;
+
+    /**
+     * @brief Get the time index of the newest motor position measurement.
+     *
+     * @return long int the time index or -1 if there is no measurement yet.
+     */
+    long int get_newest_position_index() const;
+
+    /**
+     * @brief Get a motor position measurement from the history together with
+     * the time at which it was received.
+     *
+     * @param time_index is the time index of the measurement.
+     * @param[out] motor_position (rad) on the motor side, with the joint
+     * polarity applied.
+     * @param[out] timestamp_s (s) is the time at which it was received.
+     * @return true if the measurement is in the history.
+     * @return false if it is not (anymore).
+     */
+    bool get_motor_position_sample(const long int& time_index,
+                                   double& motor_position,
+                                   double& timestamp_s) const;
+
+    /**
+     * @brief Get the time index of the newest motor measurement of the given
+     * kind.
+     *
+     * @param measurement_id see blmc_drivers::MotorInterface::MeasurementIndex
+     * @return long int the time index or -1 if there is no measurement yet.
+     */
+    long int get_motor_measurement_index(const mi& measurement_id) const;
+
+    /**
+     * @brief Get a measurement from the history, converted to the joint (as
+     * by get_measured_angle() etc.), together with the time at which it was
+     * received.
+     *
+     * @param measurement_id is the kind of measurement, the current is
+     * converted to a torque.
+     * @param time_index is the time index of the measurement.
+     * @param[out] value (rad, rad/s or Nm).
+     * @param[out] timestamp_s (s) is the time at which it was received.
+     * @return true if the measurement is in the history.
+     * @return false if it is not (anymore).
+     */
+    bool get_joint_sample(const mi& measurement_id,
+                          const long int& time_index,
+                          double& value,
+                          double& timestamp_s) const;
+
+    /**
+     * @brief Convert a motor position (as given by get_motor_position_sample)
+     * to a joint angle.
+     *
+     * @param motor_position (rad).
+     * @return double (rad).
+     */
+    double motor_position_to_joint_angle(const double& motor_position) const;
+
+    /**
+     * @brief Convert a motor velocity (or acceleration) with the joint
+     * polarity applied to a joint velocity (or acceleration).
+     *
+     * @param motor_velocity (rad/s).
+     * @return double (rad/s).
+     */
+    double motor_velocity_to_joint_velocity(const double& motor_velocity) const;
+
     /**
      * @brief Get the zero_angle_. These are the angle between the starting pose
      * and the theoretical zero pose.
@@ -218,18 +482,81 @@ public:
      * the closest (in positive torque) motor index and the theoretical zero
      * pose. Warning, this method should be called in a real time thread!
      *
+     * Blocks until init_calibration() and update_calibration() are done, see
+     * BlmcJointModules::calibrate_all() to calibrate several joints at once.
+     *
      * @param[in][out] angle_zero_to_index (rad) this is the angle between the
      * closest (in positive torque) motor index and the theoretical zero pose.
      * @param[out] index_angle (rad) is the angle where we met the index. This
      * angle is relative to the configuration when the robot booted.
      * @param[in] mechanical_calibration defines if the leg started in the zero
      * configuration or not
+     * @param[in] parameters of the controllers and profiles.
      * @return true if success.
      * @return false if problem arose.
      */
-    bool calibrate(double& angle_zero_to_index,
-                   double& index_angle,
-                   bool mechanical_calibration = false);
+    bool calibrate(
+        double& angle_zero_to_index,
+        double& index_angle,
+        bool mechanical_calibration = false,
+        const CalibrationParameters& parameters = CalibrationParameters());
+
+    /**
+     * @brief Initialize the calibration on the encoder index.
+     *
+     * This has to be called before update_calibration().
+     *
+     * @param joint_id ID of the joint.  This is only used for debug prints.
+     * @param angle_zero_to_index (rad) is the angle between the encoder index
+     * and the zero position.  Ignored with mechanical_calibration.
+     * @param mechanical_calibration if the joint starts in the zero position,
+     * the angle between the encoder index and it is measured then.
+     * @param parameters of the controllers and profiles.
+     */
+    void init_calibration(
+        int joint_id,
+        double angle_zero_to_index,
+        bool mechanical_calibration = false,
+        const CalibrationParameters& parameters = CalibrationParameters());
+
+    /**
+     * @brief Perform one step of the calibration on the encoder index.
+     *
+     * The joint is moved at the search velocity with a D velocity controller
+     * until the next encoder index is seen, which sets the zero angle.  Then
+     * it follows a linear trajectory to the zero position with a PI position
+     * controller, until it is within the position tolerance.  After success,
+     * the joint is held at the zero position.
+     *
+     * Only performs one step, so this method needs to be called in a loop
+     * with the control period of the parameters.  This method only set the
+     * control, one *MUST* send the control for the motor after calling this
+     * method.
+     *
+     * The calibration fails if the index is not found or the zero position
+     * not reached within the timeout.
+     *
+     * @return Status of the calibration.
+     */
+    CalibrationReturnCode update_calibration();
+
+    /**
+     * @brief Get the angle between the encoder index and the zero position
+     * used (or, with mechanical calibration, measured) by the calibration.
+     */
+    double get_calibration_angle_zero_to_index() const
+    {
+        return calibration_state_.angle_zero_to_index;
+    }
+
+    /**
+     * @brief Get the angle at which the calibration found the encoder index,
+     * relative to the boot position.
+     */
+    double get_calibration_index_angle() const
+    {
+        return calibration_state_.index_angle;
+    }
 
     /**
      * @brief Set zero position relative to current position
@@ -297,7 +624,100 @@ public:
      */
     double get_distance_travelled_during_homing() const;
 
+    /**
+     * @brief Initialize the friction calibration.
+     *
+     * This has to be called before update_friction_calibration(), it
+     * allocates the memory of the calibration and removes the friction
+     * compensation.
+     *
+     * @param parameters of the sweeps and of the resulting table.
+     * @throw std::invalid_argument if the parameters give an empty table.
+     */
+    void init_friction_calibration(
+        const FrictionCalibrationParameters& parameters);
+
+    /**
+     * @brief Perform one step of the friction calibration.
+     *
+     * The joint is moved to position_min and then swept back and forth over
+     * [position_min, position_max] with a PI velocity controller, once at
+     * each of the velocity levels.
+     * After the settling time, the measured torque is averaged per position
+     * node while the velocity is within the tolerance.  The torque needed to
+     * move at a constant velocity is the friction (and cogging) torque.
+     *
+     * The resulting table has the velocity nodes -max_velocity, ...,
+     * max_velocity (2 * velocity_level_count + 1).  Nodes which were not
+     * visited get the value of the closest visited position, the node at
+     * zero velocity gets the mean of its neighbours, i.e. the cogging
+     * without the Coulomb friction, so that the compensation does not
+     * chatter at standstill.
+     *
+     * Only performs one step, so this method needs to be called in a loop
+     * with the control period of the parameters.  This method only set the
+     * control, one *MUST* send the control for the motor after calling this
+     * method.  Does not allocate memory.
+     *
+     * The calibration fails if a sweep does not reach its end within twice
+     * the expected time plus one second (e.g. at an obstacle).
+     *
+     * @return Status of the calibration.
+     */
+    CalibrationReturnCode update_friction_calibration();
+
+    /**
+     * @brief Get the table of the friction calibration.
+     *
+     * @return std::shared_ptr<FrictionTable> nullptr unless the calibration
+     * succeeded.
+     */
+    std::shared_ptr<FrictionTable> get_friction_calibration_table() const
+    {
+        return friction_calibration_state_.table;
+    }
+
 private:
+    /**
+     * @brief Check if the homing or calibration searches the encoder index.
+     *
+     * @param[out] last_index of the last index seen by it.
+     */
+    bool is_searching_encoder_index(long int& last_index) const;
+
+    /**
+     * @brief Get the time index of the newest encoder index, from the events
+     * if the motor provides them, else from the measurements.
+     *
+     * @return long int the time index or -1 if there is none yet.
+     */
+    long int get_newest_encoder_index() const;
+
+    /**
+     * @brief Get the encoder index seen after the given one, if any.
+     *
+     * @param[in][out] last_index time index of the last seen index, set to
+     * the newest one.
+     * @param[out] index_angle (rad) of the newest index.
+     * @return true if there is a new index.
+     */
+    bool get_new_encoder_index(long int& last_index,
+                               double& index_angle) const;
+
+    /**
+     * @brief PI position controller of the calibration, clamped to 90% of
+     * the max. torque.
+     *
+     * @param target_position_rad  Target position (rad).
+     * @return Torque command (Nm).
+     */
+    double execute_calibration_controller(double target_position_rad);
+
+    /**
+     * @brief Build the table from the collected samples.
+     */
+    void build_friction_table();
+
     /**
      * @brief Convert from joint torque to motor current.
      *
@@ -324,19 +744,27 @@ private:
     double get_motor_measurement(const mi& measurement_id) const;
 
     /**
-     * @brief Get the last motor measurement index for a specific data. If there
-     * was no data yet, return NaN
-     *
-     * @param measurement_id is the id of the measurement you want to get.
-     * check: blmc_drivers::MotorInterface::MeasurementIndex
-     * @return double the measurement.
+     * @brief This is the pointer to the motor interface.
      */
-    long int get_motor_measurement_index(const mi& measurement_id) const;
+    std::shared_ptr<blmc_drivers::MotorInterface> motor_;
 
     /**
-     * @brief This is the pointer to the motor interface.
+     * @brief Handles to the measurements of the motor, resolved at
+     * construction so that reading them in the control loop does not touch
+     * reference counts.
      */
-    std::shared_ptr<blmc_drivers::MotorInterface> motor_;
+    std::array<ScalarChannel, mi::measurement_count> measurements_;
+
+    /**
+     * @brief Handle to the current targets sent to the motor.
+     */
+    ScalarChannel sent_current_target_;
+
+    /**
+     * @brief The encoder indices seen by the motor (may be nullptr).
+     */
+    std::shared_ptr<const MotorInterface::EncoderIndexEventTimeseries>
+        encoder_index_events_;
 
     /**
      * @brief This is the torque constant of the motor:
@@ -369,6 +797,21 @@ private:
     double position_control_gain_d_;
 
     struct HomingState homing_state_;
+
+    /**
+     * @brief State of the calibration on the encoder index.
+     */
+    CalibrationState calibration_state_;
+
+    /**
+     * @brief State of the friction calibration.
+     */
+    FrictionCalibrationState friction_calibration_state_;
+
+    /**
+     * @brief Table added to the torques (may be nullptr).
+     */
+    std::shared_ptr<const FrictionTable> friction_compensation_;
 };
 
 /**
@@ -381,7 +824,12 @@ typedef std::shared_ptr<BlmcJointModule> BlmcJointModule_ptr;
  * @brief This class defines an interface to a collection of BLMC joints. It
  * creates a BLMCJointModule for every blmc_driver::MotorInterface provided.
  *
- * @tparam COUNT
+ * With COUNT = Eigen::Dynamic the number of joints is the number of motors
+ * given at construction (e.g. from a configuration file).  All storage is
+ * allocated there, the getters filling a Vector, set_torques(),
+ * send_torques() and update_state_estimation() do not allocate memory.
+ *
+ * @tparam COUNT is the number of joints (may be Eigen::Dynamic).
  */
 template <int COUNT>
 class BlmcJointModules
@@ -393,6 +841,21 @@ public:
      */
     typedef Eigen::Matrix<double, COUNT, 1> Vector;
 
+    /**
+     * @brief Container with one element per joint, a std::vector if COUNT is
+     * Eigen::Dynamic.
+     */
+    template <typename Type>
+    using Array = typename std::conditional<
+        COUNT == Eigen::Dynamic,
+        std::vector<Type>,
+        std::array<Type, (COUNT > 0 ? COUNT : 0)>>::type;
+
+    /**
+     * @brief The motors of the joints.
+     */
+    typedef Array<std::shared_ptr<blmc_drivers::MotorInterface>> MotorArray;
+
     /**
      * @brief Construct a new BlmcJointModules object.
      *
@@ -401,13 +864,11 @@ public:
      * @param gear_ratios
      * @param zero_angles
      */
-    BlmcJointModules(
-        const std::array<std::shared_ptr<blmc_drivers::MotorInterface>, COUNT>&
-            motors,
-        const Vector& motor_constants,
-        const Vector& gear_ratios,
-        const Vector& zero_angles,
-        const Vector& max_currents)
+    BlmcJointModules(const MotorArray& motors,
+                     const Vector& motor_constants,
+                     const Vector& gear_ratios,
+                     const Vector& zero_angles,
+                     const Vector& max_currents)
     {
         set_motor_array(
             motors, motor_constants, gear_ratios, zero_angles, max_currents);
@@ -425,16 +886,32 @@ public:
      * @param motor_constants
      * @param gear_ratios
      * @param zero_angles
+     * @throw std::invalid_argument if the sizes do not match.
      */
-    void set_motor_array(
-        const std::array<std::shared_ptr<blmc_drivers::MotorInterface>, COUNT>&
-            motors,
-        const Vector& motor_constants,
-        const Vector& gear_ratios,
-        const Vector& zero_angles,
-        const Vector& max_currents)
+    void set_motor_array(const MotorArray& motors,
+                         const Vector& motor_constants,
+                         const Vector& gear_ratios,
+                         const Vector& zero_angles,
+                         const Vector& max_currents)
     {
-        for (size_t i = 0; i < COUNT; i++)
+        const Eigen::Index count = motors.size();
+        if (motor_constants.size() != count || gear_ratios.size() != count ||
+            zero_angles.size() != count || max_currents.size() != count)
+        {
+            throw std::invalid_argument(
+                "BlmcJointModules: need one parameter per motor");
+        }
+
+        resize_array(modules_, count);
+        resize_array(last_estimated_position_index_, count);
+        state_estimator_ = AlphaBetaGammaFilter<COUNT>(count);
+        sample_positions_.resize(count);
+        sample_times_.resize(count);
+        estimated_angles_.resize(count);
+        estimated_velocities_.resize(count);
+        estimated_accelerations_.resize(count);
+
+        for (size_t i = 0; i < size(); i++)
         {
             modules_[i] = std::make_shared<BlmcJointModule>(motors[i],
                                                             motor_constants[i],
@@ -443,13 +920,33 @@ public:
                                                             false,
                                                             max_currents[i]);
         }
+        init_state_estimation();
     }
+
+    /**
+     * @brief Get the number of joints.
+     */
+    size_t size() const
+    {
+        return modules_.size();
+    }
+
+    /**
+     * @brief Get the module of a joint.
+     *
+     * @param joint_id  ID of the joint (in range `[0, size())`).
+     */
+    std::shared_ptr<BlmcJointModule> get_module(size_t joint_id) const
+    {
+        return modules_[joint_id];
+    }
+
     /**
      * @brief Send the registered torques to all modules.
      */
     void send_torques()
     {
-        for (size_t i = 0; i < COUNT; i++)
+        for (size_t i = 0; i < size(); i++)
         {
             modules_[i]->send_torque();
         }
@@ -461,9 +958,9 @@ public:
      *
      * @param reverse_polarity
      */
-    void set_joint_polarities(std::array<bool, COUNT> reverse_polarities)
+    void set_joint_polarities(const Array<bool>& reverse_polarities)
     {
-        for (size_t i = 0; i < COUNT; i++)
+        for (size_t i = 0; i < size(); i++)
         {
             modules_[i]->set_joint_polarity(reverse_polarities[i]);
         }
@@ -475,7 +972,7 @@ public:
      */
     void set_torques(const Vector& desired_torques)
     {
-        for (size_t i = 0; i < COUNT; i++)
+        for (size_t i = 0; i < size(); i++)
         {
             modules_[i]->set_torque(desired_torques(i));
         }
@@ -488,8 +985,8 @@ public:
      */
     Vector get_max_torques()
     {
-        Vector max_torques;
-        for (size_t i = 0; i < COUNT; ++i)
+        Vector max_torques(size());
+        for (size_t i = 0; i < size(); ++i)
         {
             max_torques[i] = modules_[i]->get_max_torque();
         }
@@ -503,13 +1000,23 @@ public:
      */
     Vector get_sent_torques() const
     {
-        Vector torques;
+        Vector torques(size());
+        get_sent_torques(torques);
+        return torques;
+    }
 
-        for (size_t i = 0; i < COUNT; i++)
+    /**
+     * @brief Get the previously sent torques, without allocating memory.
+     *
+     * @param[out] torques (Nm), resized if needed.
+     */
+    void get_sent_torques(Vector& torques) const
+    {
+        torques.resize(size());
+        for (size_t i = 0; i < size(); i++)
         {
             torques(i) = modules_[i]->get_sent_torque();
         }
-        return torques;
     }
 
     /**
@@ -519,13 +1026,23 @@ public:
      */
     Vector get_measured_torques() const
     {
-        Vector torques;
+        Vector torques(size());
+        get_measured_torques(torques);
+        return torques;
+    }
 
-        for (size_t i = 0; i < COUNT; i++)
+    /**
+     * @brief Get the measured joint torques, without allocating memory.
+     *
+     * @param[out] torques (Nm), resized if needed.
+     */
+    void get_measured_torques(Vector& torques) const
+    {
+        torques.resize(size());
+        for (size_t i = 0; i < size(); i++)
         {
             torques(i) = modules_[i]->get_measured_torque();
         }
-        return torques;
     }
 
     /**
@@ -535,13 +1052,23 @@ public:
      */
     Vector get_measured_angles() const
     {
-        Vector positions;
+        Vector positions(size());
+        get_measured_angles(positions);
+        return positions;
+    }
 
-        for (size_t i = 0; i < COUNT; i++)
+    /**
+     * @brief Get the measured joint angles, without allocating memory.
+     *
+     * @param[out] positions (rad), resized if needed.
+     */
+    void get_measured_angles(Vector& positions) const
+    {
+        positions.resize(size());
+        for (size_t i = 0; i < size(); i++)
         {
             positions(i) = modules_[i]->get_measured_angle();
         }
-        return positions;
     }
 
     /**
@@ -551,13 +1078,23 @@ public:
      */
     Vector get_measured_velocities() const
     {
-        Vector velocities;
+        Vector velocities(size());
+        get_measured_velocities(velocities);
+        return velocities;
+    }
 
-        for (size_t i = 0; i < COUNT; i++)
+    /**
+     * @brief Get the measured joint velocities, without allocating memory.
+     *
+     * @param[out] velocities (rad/s), resized if needed.
+     */
+    void get_measured_velocities(Vector& velocities) const
+    {
+        velocities.resize(size());
+        for (size_t i = 0; i < size(); i++)
         {
             velocities(i) = modules_[i]->get_measured_velocity();
         }
-        return velocities;
     }
 
     /**
@@ -568,7 +1105,7 @@ public:
      */
     void set_zero_angles(const Vector& zero_angles)
     {
-        for (size_t i = 0; i < COUNT; i++)
+        for (size_t i = 0; i < size(); i++)
         {
             modules_[i]->set_zero_angle(zero_angles(i));
         }
@@ -581,9 +1118,9 @@ public:
      */
     Vector get_zero_angles() const
     {
-        Vector positions;
+        Vector positions(size());
 
-        for (size_t i = 0; i < COUNT; i++)
+        for (size_t i = 0; i < size(); i++)
         {
             positions(i) = modules_[i]->get_zero_angle();
         }
@@ -597,9 +1134,9 @@ public:
      */
     Vector get_measured_index_angles() const
     {
-        Vector index_angles;
+        Vector index_angles(size());
 
-        for (size_t i = 0; i < COUNT; i++)
+        for (size_t i = 0; i < size(); i++)
         {
             index_angles(i) = modules_[i]->get_measured_index_angle();
         }
@@ -609,7 +1146,7 @@ public:
     /**
      * @brief Set position control gains for the specified joint.
      *
-     * @param joint_id  ID of the joint (in range `[0, COUNT)`).
+     * @param joint_id  ID of the joint (in range `[0, size())`).
      * @param kp P gain.
      * @param kd D gain.
      */
@@ -626,12 +1163,26 @@ public:
      */
     void set_position_control_gains(Vector kp, Vector kd)
     {
-        for (size_t i = 0; i < COUNT; i++)
+        for (size_t i = 0; i < size(); i++)
         {
             set_position_control_gains(i, kp[i], kd[i]);
         }
     }
 
+    /**
+     * @brief Set the period of the loops of execute_homing(), calibrate_all(),
+     * execute_friction_calibration() and go_to() (default 1 ms).
+     *
+     * Note that the homing moves by the profile step size per period, i.e.
+     * a shorter period makes the homing faster.
+     *
+     * @param control_period_s
+     */
+    void set_control_period(double control_period_s)
+    {
+        control_period_s_ = control_period_s;
+    }
+
     /**
      * @brief Perform homing for all joints at endstops.
      *
@@ -644,7 +1195,7 @@ public:
     HomingReturnCode execute_homing_at_current_position(Vector home_offset_rad)
     {
         // Initialise homing for all joints
-        for (size_t i = 0; i < COUNT; i++)
+        for (size_t i = 0; i < size(); i++)
         {
             modules_[i]->homing_at_current_position(home_offset_rad[i]);
         }
@@ -658,7 +1209,8 @@ public:
      * If one of the joints fails, the complete homing fails.  Otherwise it
      * loops until all joints finished.
      * If a joint is finished while others are still running, it is held at the
-     * home position.
+     * home position.  When a joint passes its encoder index, the next step
+     * runs at once instead of at the next period.
      *
      * See BlmcJointModule::update_homing for details on the homing procedure.
      *
@@ -667,13 +1219,12 @@ public:
      * @return Final status of the homing procedure (either SUCCESS if all
      *     joints succeeded or the return code of the first joint that failed).
      */
-    HomingReturnCode execute_homing(
-        double search_distance_limit_rad,
-        Vector home_offset_rad,
-        Vector profile_step_size_rad = Vector::Constant(0.001))
+    HomingReturnCode execute_homing(double search_distance_limit_rad,
+                                    Vector home_offset_rad,
+                                    Vector profile_step_size_rad)
     {
         // Initialise homing for all joints
-        for (size_t i = 0; i < COUNT; i++)
+        for (size_t i = 0; i < size(); i++)
         {
             modules_[i]->init_homing((int)i,
                                      search_distance_limit_rad,
@@ -682,15 +1233,14 @@ public:
         }
 
         // run homing for all joints until all of them are done
-        real_time_tools::Spinner spinner;
-        spinner.set_period(0.001);  // TODO magic number
+        HybridSpinner spinner(control_period_s_);
         HomingReturnCode homing_status;
         do
         {
             bool all_succeeded = true;
             homing_status = HomingReturnCode::RUNNING;
 
-            for (size_t i = 0; i < COUNT; i++)
+            for (size_t i = 0; i < size(); i++)
             {
                 HomingReturnCode joint_result = modules_[i]->update_homing();
 
@@ -706,7 +1256,7 @@ public:
             }
             if (homing_status == HomingReturnCode::RUNNING)
             {
-                for (unsigned i = 0; i < COUNT; ++i)
+                for (unsigned i = 0; i < size(); ++i)
                 {
                     modules_[i]->send_torque();
                 }
@@ -717,17 +1267,153 @@ public:
                 homing_status = HomingReturnCode::SUCCEEDED;
             }
 
-            spinner.spin();
+            spin_or_wait_for_encoder_index(spinner);
         } while (homing_status == HomingReturnCode::RUNNING);
 
+        if (spinner.get_overrun_count() > 0)
+        {
+            rt_printf("homing overran the control period %lu times\n",
+                      (unsigned long)spinner.get_overrun_count());
+        }
+
         return homing_status;
     }
 
+    /**
+     * @brief Perform homing for all joints with a profile step size of
+     * 0.001 rad, see above.
+     */
+    HomingReturnCode execute_homing(double search_distance_limit_rad,
+                                    Vector home_offset_rad)
+    {
+        return execute_homing(search_distance_limit_rad,
+                              home_offset_rad,
+                              Vector::Constant(size(), 0.001));
+    }
+
+    /**
+     * @brief Calibrate all joints on their encoder index at once.
+     *
+     * All joints are advanced in the same loop, with one send per period.
+     * If one of the joints fails, the complete calibration fails.  A joint
+     * that finished while others are still running is held at its zero
+     * position.  When a joint passes its encoder index, the next step runs at
+     * once instead of at the next period.  At the end, zero torques are
+     * sent.
+     *
+     * See BlmcJointModule::update_calibration for details on the
+     * calibration, the control period of the parameters is replaced by the
+     * one of this class.
+     *
+     * @param[in][out] angle_zero_to_index (rad) see
+     * BlmcJointModule::init_calibration, set to the measured ones with
+     * mechanical_calibration.
+     * @param[out] index_angle (rad) where the joints met their index,
+     * relative to the boot position.
+     * @param mechanical_calibration if the joints start in the zero position.
+     * @param parameters of each joint.
+     * @return Final status of the calibration (either SUCCEEDED if all
+     *     joints succeeded or FAILED).
+     */
+    CalibrationReturnCode calibrate_all(
+        Vector& angle_zero_to_index,
+        Vector& index_angle,
+        bool mechanical_calibration,
+        const Array<CalibrationParameters>& parameters)
+    {
+        for (size_t i = 0; i < size(); i++)
+        {
+            CalibrationParameters joint_parameters = parameters[i];
+            joint_parameters.control_period_s = control_period_s_;
+            modules_[i]->init_calibration((int)i,
+                                          angle_zero_to_index[i],
+                                          mechanical_calibration,
+                                          joint_parameters);
+        }
+
+        CalibrationReturnCode status = run_calibrations(
+            &BlmcJointModule::update_calibration, true, "calibration");
+
+        for (size_t i = 0; i < size(); i++)
+        {
+            modules_[i]->set_torque(0.0);
+            angle_zero_to_index[i] =
+                modules_[i]->get_calibration_angle_zero_to_index();
+            index_angle[i] = modules_[i]->get_calibration_index_angle();
+        }
+        send_torques();
+        return status;
+    }
+
+    /**
+     * @brief Calibrate all joints with the default parameters, see above.
+     */
+    CalibrationReturnCode calibrate_all(Vector& angle_zero_to_index,
+                                        Vector& index_angle,
+                                        bool mechanical_calibration = false)
+    {
+        Array<CalibrationParameters> parameters;
+        resize_array(parameters, size());
+        return calibrate_all(angle_zero_to_index,
+                             index_angle,
+                             mechanical_calibration,
+                             parameters);
+    }
+
+    /**
+     * @brief Calibrate the friction compensation of all joints at once.
+     *
+     * All joints are swept in the same loop, with one send per period.  If
+     * one of the joints fails, the complete calibration fails.  A joint that
+     * finished while others are still running gets zero torque.  On success,
+     * the resulting tables are used as friction compensation of the joints.
+     *
+     * See BlmcJointModule::update_friction_calibration for details on the
+     * calibration, the control period of the parameters is replaced by the
+     * one of this class.
+     *
+     * @param parameters of each joint.
+     * @return Final status of the calibration (either SUCCEEDED if all
+     *     joints succeeded or the return code of the first joint that failed).
+     */
+    CalibrationReturnCode execute_friction_calibration(
+        const Array<FrictionCalibrationParameters>& parameters)
+    {
+        for (size_t i = 0; i < size(); i++)
+        {
+            FrictionCalibrationParameters joint_parameters = parameters[i];
+            joint_parameters.control_period_s = control_period_s_;
+            modules_[i]->init_friction_calibration(joint_parameters);
+        }
+
+        CalibrationReturnCode status =
+            run_calibrations(&BlmcJointModule::update_friction_calibration,
+                             false,
+                             "friction calibration");
+
+        if (status == CalibrationReturnCode::FAILED)
+        {
+            // stop all joints.
+            for (size_t i = 0; i < size(); i++)
+            {
+                modules_[i]->set_torque(0.0);
+            }
+            send_torques();
+            return status;
+        }
+        for (size_t i = 0; i < size(); i++)
+        {
+            modules_[i]->set_friction_compensation(
+                modules_[i]->get_friction_calibration_table());
+        }
+        return status;
+    }
+
     //! @see BlmcJointModule::get_distance_travelled_during_homing
     Vector get_distance_travelled_during_homing() const
     {
-        Vector dist;
-        for (unsigned i = 0; i < COUNT; ++i)
+        Vector dist(size());
+        for (unsigned i = 0; i < size(); ++i)
         {
             dist[i] = modules_[i]->get_distance_travelled_during_homing();
         }
@@ -753,8 +1439,9 @@ public:
                                 .maxCoeff() /
                             average_speed_rad_per_sec;
 
-        std::array<TimePolynome<5>, COUNT> min_jerk_trajs;
-        for (unsigned i = 0; i < COUNT; i++)
+        Array<TimePolynome<5>> min_jerk_trajs;
+        resize_array(min_jerk_trajs, size());
+        for (unsigned i = 0; i < size(); i++)
         {
             min_jerk_trajs[i].set_parameters(final_time,
                                              initial_joint_positions[i],
@@ -763,22 +1450,21 @@ public:
         }
 
         // run got_to for all joints
-        real_time_tools::Spinner spinner;
-        double sampling_period = 0.001;  // TODO magic number
-        spinner.set_period(sampling_period);
+        double sampling_period = control_period_s_;
+        HybridSpinner spinner(sampling_period);
         GoToReturnCode go_to_status;
         double current_time = 0.0;
         do
         {
             // TODO: add a security if error gets too big
-            for (unsigned i = 0; i < COUNT; i++)
+            for (unsigned i = 0; i < size(); i++)
             {
                 double desired_pose = min_jerk_trajs[i].compute(current_time);
                 double desired_torque =
                     modules_[i]->execute_position_controller(desired_pose);
                 modules_[i]->set_torque(desired_torque);
             }
-            for (unsigned i = 0; i < COUNT; ++i)
+            for (unsigned i = 0; i < size(); ++i)
             {
                 modules_[i]->send_torque();
             }
@@ -789,12 +1475,18 @@ public:
 
         } while (current_time < (final_time + sampling_period));
 
+        if (spinner.get_overrun_count() > 0)
+        {
+            rt_printf("go_to overran the control period %lu times\n",
+                      (unsigned long)spinner.get_overrun_count());
+        }
+
         // Stop all motors (0 torques) after the destination achieved
-        for (unsigned i = 0; i < COUNT; i++)
+        for (unsigned i = 0; i < size(); i++)
         {
             modules_[i]->set_torque(0.0);
         }
-        for (unsigned i = 0; i < COUNT; ++i)
+        for (unsigned i = 0; i < size(); ++i)
         {
             modules_[i]->send_torque();
         }
@@ -811,11 +1503,324 @@ public:
         return go_to_status;
     }
 
+    /**
+     * @brief Initialize the estimation of joint angles, velocities and
+     * accelerations from the timestamped position measurements.
+     *
+     * The estimation is done by an alpha-beta-gamma filter for all joints at
+     * once (see AlphaBetaGammaFilter).  It is based on the positions only, so
+     * it does not suffer from the low resolution and the filtering of the
+     * velocity measured on the board.
+     *
+     * @param smoothing in [0, 1), see AlphaBetaGammaFilter::set_smoothing.
+     */
+    void init_state_estimation(double smoothing = 0.8)
+    {
+        state_estimator_.set_smoothing(smoothing);
+        state_estimator_.reset();
+        for (size_t i = 0; i < size(); i++)
+        {
+            // only use measurements received from now on.
+            last_estimated_position_index_[i] =
+                modules_[i]->get_newest_position_index() - 1;
+        }
+        estimated_angles_.setConstant(std::numeric_limits<double>::quiet_NaN());
+        estimated_velocities_.setConstant(
+            std::numeric_limits<double>::quiet_NaN());
+        estimated_accelerations_.setConstant(
+            std::numeric_limits<double>::quiet_NaN());
+    }
+
+    /**
+     * @brief Feed all position measurements received since the last call to
+     * the estimator and extrapolate the state to the given time.
+     *
+     * Call this once per control tick, before using get_estimated_angles()
+     * etc.  It does not allocate memory.
+     *
+     * @param time_s (s) is the time to which the state is extrapolated (on the
+     * clock of real_time_tools::Timer).  By default the current time, which
+     * compensates the delay between reception of the measurements and the
+     * control tick.
+     */
+    void update_state_estimation(
+        double time_s = std::numeric_limits<double>::quiet_NaN())
+    {
+        bool has_pending_samples = true;
+        while (has_pending_samples)
+        {
+            has_pending_samples = false;
+            for (size_t i = 0; i < size(); i++)
+            {
+                sample_times_[i] = std::numeric_limits<double>::quiet_NaN();
+
+                long int newest_index = modules_[i]->get_newest_position_index();
+                long int next_index = last_estimated_position_index_[i] + 1;
+                if (newest_index < 0 || next_index > newest_index)
+                {
+                    continue;
+                }
+
+                if (modules_[i]->get_motor_position_sample(
+                        next_index, sample_positions_[i], sample_times_[i]))
+                {
+                    last_estimated_position_index_[i] = next_index;
+                }
+                else
+                {
+                    // the sample dropped out of the history, continue with
+                    // the newest one.
+                    last_estimated_position_index_[i] = newest_index - 1;
+                }
+                has_pending_samples |=
+                    last_estimated_position_index_[i] < newest_index;
+            }
+            state_estimator_.update(sample_times_, sample_positions_);
+        }
+
+        if (std::isnan(time_s))
+        {
+            time_s = real_time_tools::Timer::get_current_time_sec();
+        }
+        state_estimator_.predict(time_s,
+                                 estimated_angles_,
+                                 estimated_velocities_,
+                                 estimated_accelerations_);
+
+        for (size_t i = 0; i < size(); i++)
+        {
+            estimated_angles_[i] =
+                modules_[i]->motor_position_to_joint_angle(estimated_angles_[i]);
+            estimated_velocities_[i] =
+                modules_[i]->motor_velocity_to_joint_velocity(
+                    estimated_velocities_[i]);
+            estimated_accelerations_[i] =
+                modules_[i]->motor_velocity_to_joint_velocity(
+                    estimated_accelerations_[i]);
+        }
+    }
+
+    /**
+     * @brief Get the estimated joint angles at the time of the last
+     * update_state_estimation().
+     *
+     * @return Vector (rad)
+     */
+    Vector get_estimated_angles() const
+    {
+        return estimated_angles_;
+    }
+
+    /**
+     * @brief Same as above, without allocating memory.
+     *
+     * @param[out] angles (rad), resized if needed.
+     */
+    void get_estimated_angles(Vector& angles) const
+    {
+        angles = estimated_angles_;
+    }
+
+    /**
+     * @brief Get the estimated joint velocities at the time of the last
+     * update_state_estimation().
+     *
+     * @return Vector (rad/s)
+     */
+    Vector get_estimated_velocities() const
+    {
+        return estimated_velocities_;
+    }
+
+    /**
+     * @brief Same as above, without allocating memory.
+     *
+     * @param[out] velocities (rad/s), resized if needed.
+     */
+    void get_estimated_velocities(Vector& velocities) const
+    {
+        velocities = estimated_velocities_;
+    }
+
+    /**
+     * @brief Get the estimated joint accelerations at the time of the last
+     * update_state_estimation().
+     *
+     * @return Vector (rad/s^2)
+     */
+    Vector get_estimated_accelerations() const
+    {
+        return estimated_accelerations_;
+    }
+
+    /**
+     * @brief Same as above, without allocating memory.
+     *
+     * @param[out] accelerations (rad/s^2), resized if needed.
+     */
+    void get_estimated_accelerations(Vector& accelerations) const
+    {
+        accelerations = estimated_accelerations_;
+    }
+
 private:
+    /**
+     * @brief Resize a std::vector.
+     */
+    template <typename Type>
+    static void resize_array(std::vector<Type>& array, const size_t& size)
+    {
+        array.resize(size);
+    }
+
+    /**
+     * @brief Check the size of a std::array.
+     */
+    template <typename Type, size_t SIZE>
+    static void resize_array(std::array<Type, SIZE>& /*array*/,
+                             const size_t& size)
+    {
+        if (size != SIZE)
+        {
+            throw std::invalid_argument(
+                "BlmcJointModules: number of joints does not match COUNT");
+        }
+    }
+
+    /**
+     * @brief Advance the initialized calibrations of all joints, with one
+     * send per period, until all of them succeeded or one failed.
+     *
+     * @param update_calibration is the step of the calibration of a joint,
+     * e.g. BlmcJointModule::update_calibration.
+     * @param reacts_to_encoder_index if the next step runs at once when a
+     * joint passes its encoder index (see spin_or_wait_for_encoder_index()).
+     * @param name of the calibration, for the overrun message.
+     * @return CalibrationReturnCode SUCCEEDED or FAILED.
+     */
+    CalibrationReturnCode run_calibrations(
+        CalibrationReturnCode (BlmcJointModule::*update_calibration)(),
+        const bool& reacts_to_encoder_index,
+        const char* name)
+    {
+        HybridSpinner spinner(control_period_s_);
+        CalibrationReturnCode status;
+        do
+        {
+            bool all_succeeded = true;
+            status = CalibrationReturnCode::RUNNING;
+
+            for (size_t i = 0; i < size(); i++)
+            {
+                CalibrationReturnCode joint_result =
+                    (modules_[i].get()->*update_calibration)();
+
+                all_succeeded &=
+                    (joint_result == CalibrationReturnCode::SUCCEEDED);
+
+                if (joint_result == CalibrationReturnCode::FAILED)
+                {
+                    status = joint_result;
+                }
+            }
+            send_torques();
+
+            if (all_succeeded)
+            {
+                status = CalibrationReturnCode::SUCCEEDED;
+            }
+
+            if (reacts_to_encoder_index)
+            {
+                spin_or_wait_for_encoder_index(spinner);
+            }
+            else
+            {
+                spinner.spin();
+            }
+        } while (status == CalibrationReturnCode::RUNNING);
+
+        if (spinner.get_overrun_count() > 0)
+        {
+            rt_printf("%s overran the control period %lu times\n",
+                      name,
+                      (unsigned long)spinner.get_overrun_count());
+        }
+        return status;
+    }
+
+    /**
+     * @brief Wait for the end of the period of the spinner, but return at
+     * once (and start a new period) when a joint saw an encoder index its
+     * homing or calibration has to react to.
+     *
+     * The joints are polled every ENCODER_INDEX_POLL_PERIOD_S until shortly
+     * before the deadline, so the reaction to an index does not wait for the
+     * next period.
+     */
+    void spin_or_wait_for_encoder_index(HybridSpinner& spinner) const
+    {
+        const int64_t poll_period_ns = ENCODER_INDEX_POLL_PERIOD_S * 1e9;
+        const int64_t poll_end_ns =
+            spinner.get_deadline_ns() -
+            int64_t(HybridSpinner::DEFAULT_BUSY_WAIT_S * 1e9);
+
+        int64_t now_ns = HybridSpinner::get_monotonic_time_ns();
+        while (now_ns < poll_end_ns)
+        {
+            for (size_t i = 0; i < size(); i++)
+            {
+                if (modules_[i]->has_pending_encoder_index())
+                {
+                    spinner.initialize();
+                    return;
+                }
+            }
+            now_ns = HybridSpinner::wait_until(
+                std::min(now_ns + poll_period_ns, poll_end_ns), 0);
+        }
+        spinner.spin();
+    }
+
+    /**
+     * @brief Period (s) at which execute_homing() and calibrate_all() check
+     * for encoder indices between their control periods.
+     */
+    static constexpr double ENCODER_INDEX_POLL_PERIOD_S = 50e-6;
+
     /**
      * @brief These are the BLMCJointModule objects corresponding to a robot.
      */
-    std::array<std::shared_ptr<BlmcJointModule>, COUNT> modules_;
+    Array<std::shared_ptr<BlmcJointModule>> modules_;
+
+    /**
+     * @brief Period of the loops of execute_homing() and go_to().
+     */
+    double control_period_s_ = 0.001;
+
+    /**
+     * @brief Estimates the joint states from the position measurements (in
+     * motor space).
+     */
+    AlphaBetaGammaFilter<COUNT> state_estimator_;
+
+    /**
+     * @brief Time index of the last position measurement given to the
+     * estimator for each joint.
+     */
+    Array<long int> last_estimated_position_index_;
+
+    //! @brief Position measurements given to the estimator.
+    Vector sample_positions_;
+    //! @brief Reception times of the position measurements.
+    Vector sample_times_;
+
+    //! @brief Estimated joint angles.
+    Vector estimated_angles_;
+    //! @brief Estimated joint velocities.
+    Vector estimated_velocities_;
+    //! @brief Estimated joint accelerations.
+    Vector estimated_accelerations_;
 };
 
 }  // namespace blmc_drivers
@@ -0,0 +1,178 @@
+/**
+ * @file blmc_robot.hpp
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, Max Planck Gesellschaft.
+ * @brief Drivers of a whole robot, instantiated from a RobotDescription.
+ */
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "blmc_drivers/blmc_joint_module.hpp"
+#include "blmc_drivers/devices/analog_sensor.hpp"
+#include "blmc_drivers/devices/can_bus.hpp"
+#include "blmc_drivers/devices/motor.hpp"
+#include "blmc_drivers/devices/motor_board.hpp"
+#include "blmc_drivers/devices/motor_board_state_publisher.hpp"
+#include "blmc_drivers/devices/shared_memory_motor_board.hpp"
+#include "blmc_drivers/robot_description.hpp"
+
+namespace blmc_drivers
+{
+/**
+ * @brief Owns the buses, boards, motors, sensors and joint modules of a
+ * robot, as given by a RobotDescription.
+ *
+ * The buses are brought up in parallel: each one is opened, its board is
+ * created and waited for in a thread of its own, so the bring-up takes about
+ * as long as for the slowest bus instead of the sum over all buses.
+ *
+ * Example:
+ * \code
+ * BlmcRobot robot(load_robot_description("solo.ini"));
+ * auto joints = robot.get_joint_modules();
+ * joints->set_torques(Eigen::VectorXd::Zero(joints->size()));
+ * joints->send_torques();
+ * \endcode
+ */
+class BlmcRobot
+{
+public:
+    /**
+     * @brief The joint modules of all joints.
+     */
+    typedef BlmcJointModules<Eigen::Dynamic> JointModules;
+
+    /**
+     * @brief Instantiate the drivers and wait until all boards are ready.
+     *
+     * @param description of the robot.
+     * @throw std::runtime_error if a bus can not be opened.
+     */
+    BlmcRobot(const RobotDescription& description);
+
+    /**
+     * @brief Stop serving and publishing, then disable the boards.
+     */
+    ~BlmcRobot();
+
+    /**
+     * @brief Get the description the robot was built from.
+     */
+    const RobotDescription& get_description() const
+    {
+        return description_;
+    }
+
+    /**
+     * @brief Get the time the bring-up took.
+     *
+     * @return double (s)
+     */
+    double get_bring_up_duration_s() const
+    {
+        return bring_up_duration_s_;
+    }
+
+    /**
+     * @brief Get the joint modules, in the order of the joints of the
+     * description.
+     */
+    std::shared_ptr<JointModules> get_joint_modules() const
+    {
+        return joint_modules_;
+    }
+
+    /**
+     * @brief Get the names of the joints, in the order of the joint vectors.
+     */
+    std::vector<std::string> get_joint_names() const;
+
+    /**
+     * @brief Get a bus by name.
+     *
+     * @throw std::invalid_argument if there is no such bus.
+     */
+    std::shared_ptr<CanBusInterface> get_can_bus(const std::string& name) const;
+
+    /**
+     * @brief Get a board by name.
+     *
+     * @throw std::invalid_argument if there is no such board.
+     */
+    std::shared_ptr<CanBusMotorBoard> get_motor_board(
+        const std::string& name) const;
+
+    /**
+     * @brief Get the motor of a joint by name.
+     *
+     * @throw std::invalid_argument if there is no such joint.
+     */
+    std::shared_ptr<SafeMotor> get_motor(const std::string& joint_name) const;
+
+    /**
+     * @brief Get an analog sensor by name.
+     *
+     * @throw std::invalid_argument if there is no such sensor.
+     */
+    std::shared_ptr<AnalogSensor> get_analog_sensor(
+        const std::string& name) const;
+
+private:
+    /**
+     * @brief Open a bus and create its board, called in parallel for all
+     * buses.
+     *
+     * @param bus_index in the description.
+     */
+    void bring_up_bus(const size_t& bus_index);
+
+    /**
+     * @brief The description the robot was built from.
+     */
+    RobotDescription description_;
+
+    /**
+     * @brief Buses, in the order of the description.
+     */
+    std::vector<std::shared_ptr<CanBusInterface>> can_buses_;
+
+    /**
+     * @brief Boards, in the order of the description.
+     */
+    std::vector<std::shared_ptr<CanBusMotorBoard>> motor_boards_;
+
+    /**
+     * @brief Motors, in the order of the joints.
+     */
+    std::vector<std::shared_ptr<SafeMotor>> motors_;
+
+    /**
+     * @brief Analog sensors, in the order of the description.
+     */
+    std::vector<std::shared_ptr<AnalogSensor>> analog_sensors_;
+
+    /**
+     * @brief Joint modules of all joints.
+     */
+    std::shared_ptr<JointModules> joint_modules_;
+
+    /**
+     * @brief Exporters of the board states requested by `publish`.
+     */
+    std::vector<std::unique_ptr<MotorBoardStatePublisher>> publishers_;
+
+    /**
+     * @brief Servers of the boards requested by `serve`.
+     */
+    std::vector<std::unique_ptr<MotorBoardServer>> servers_;
+
+    /**
+     * @brief Time the bring-up took.
+     */
+    double bring_up_duration_s_;
+};
+
+}  // namespace blmc_drivers
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <string>
 
@@ -20,6 +21,8 @@
 #include <time_series/time_series.hpp>
 
 #include "blmc_drivers/devices/device_interface.hpp"
+#include "blmc_drivers/utils/can_bus_statistics.hpp"
+#include "blmc_drivers/utils/latency_histogram.hpp"
 #include "blmc_drivers/utils/os_interface.hpp"
 
 namespace blmc_drivers
@@ -98,6 +101,22 @@ public:
      */
     typedef time_series::TimeSeries<CanBusFrame> CanframeTimeseries;
 
+    /**
+     * @brief Error state of the CAN controller.
+     */
+    enum ControllerState
+    {
+        //! @brief Normal operation.
+        ERROR_ACTIVE,
+        //! @brief The error counters reached the warning level.
+        ERROR_WARNING,
+        //! @brief The controller no longer signals errors on the bus.
+        ERROR_PASSIVE,
+        //! @brief The controller is disconnected from the bus, no frames are
+        //! sent or received until it is restarted.
+        BUS_OFF
+    };
+
     /**
      * getters
      */
@@ -144,6 +163,132 @@ public:
      * @brief send all the input frame to the can network
      */
     virtual void send_if_input_changed() = 0;
+
+    /**
+     * Error state
+     */
+
+    /**
+     * @brief Get the error state of the CAN controller.
+     *
+     * @return ControllerState
+     */
+    virtual ControllerState get_controller_state() const
+    {
+        return ERROR_ACTIVE;
+    }
+
+    /**
+     * @brief Get the number of times the controller went bus-off.
+     *
+     * @return size_t
+     */
+    virtual size_t get_bus_off_count() const
+    {
+        return 0;
+    }
+};
+
+/**
+ * @brief Tracks the error state of a CAN controller from the error frames
+ * it reports, and decides when a controller which is bus-off is restarted.
+ *
+ * All methods except the getters must be called from one thread (the
+ * receiving thread of the bus), the getters from any thread.
+ */
+class CanControllerMonitor
+{
+public:
+    /**
+     * @brief Construct a new CanControllerMonitor object, the controller is
+     * assumed to be error active.
+     *
+     * @param name of the interface, for the messages.
+     * @param restart_delay_s is the time (s) the controller is left bus-off
+     * before it is restarted, and between two restart requests.
+     */
+    CanControllerMonitor(const std::string& name,
+                         const double& restart_delay_s);
+
+    /**
+     * @brief Update the state from an error frame.
+     *
+     * @param error_frame is a frame with the CAN_ERR_FLAG set.
+     * @param time_s is the time (s) it was received.
+     * @return true if the controller just went bus-off.
+     */
+    bool process_error_frame(const CanBusFrame& error_frame,
+                             const double& time_s);
+
+    /**
+     * @brief Update the state on a regular frame: if one is received the
+     * controller which was bus-off was restarted.
+     */
+    void process_frame();
+
+    /**
+     * @brief Check if the controller should be restarted now, i.e. it is
+     * bus-off since restart_delay_s or the last restart was requested
+     * restart_delay_s ago.  If so, the request is assumed to be done.
+     *
+     * @param time_s is the current time (s).
+     * @return true if the controller should be restarted.
+     */
+    bool should_restart(const double& time_s);
+
+    /**
+     * @brief Get the error state of the controller.
+     *
+     * @return CanBusInterface::ControllerState
+     */
+    CanBusInterface::ControllerState get_state() const
+    {
+        return CanBusInterface::ControllerState(state_.load());
+    }
+
+    /**
+     * @brief Get the number of times the controller went bus-off.
+     *
+     * @return size_t
+     */
+    size_t get_bus_off_count() const
+    {
+        return bus_off_count_;
+    }
+
+private:
+    /**
+     * @brief Set the state and print its changes.
+     *
+     * @param state
+     */
+    void set_state(const CanBusInterface::ControllerState& state);
+
+    /**
+     * @brief Name of the interface.
+     */
+    std::string name_;
+
+    /**
+     * @brief Time (s) the controller waits in bus-off before it is
+     * restarted.
+     */
+    double restart_delay_s_;
+
+    /**
+     * @brief Error state of the CAN controller (a ControllerState).
+     */
+    std::atomic<int> state_;
+
+    /**
+     * @brief Number of times the controller went bus-off.
+     */
+    std::atomic<size_t> bus_off_count_;
+
+    /**
+     * @brief Time (s) of the bus-off or of the last restart request.
+     */
+    double bus_off_time_s_;
 };
 
 /**
@@ -157,10 +302,17 @@ public:
      *
      * @param can_interface_name
      * @param history_length
+     * @param cpu_id is the cpu of the receiving thread (-1 for any).
+     * @param bitrate is the configured bitrate (bit/s) of the bus, used to
+     * estimate the bus load.
+     * @param priority of the receiving thread (-1 for 90 if a cpu is given,
+     * otherwise the default of real_time_tools).
      */
     CanBus(const std::string& can_interface_name,
            const size_t& history_length = 1000,
-	   const int& cpu_id = -1);
+	   const int& cpu_id = -1,
+           const double& bitrate = 1e6,
+           const int& priority = -1);
 
     /**
      * @brief Destroy the CanBus object
@@ -224,6 +376,52 @@ public:
      */
     virtual void send_if_input_changed();
 
+    /**
+     * @brief Get the latencies from set_input_frame() until the frame is
+     * written to the socket.
+     *
+     * @return const LatencyHistogram&
+     */
+    const LatencyHistogram& get_send_latency() const
+    {
+        return send_latency_;
+    }
+
+    /**
+     * @brief Get the error state of the CAN controller.
+     *
+     * When the controller goes bus-off, frames to be sent are dropped and the
+     * controller is restarted after BUS_OFF_RESTART_DELAY_S (unless the
+     * interface restarts it automatically, see "restart-ms" of "ip link").
+     *
+     * @return ControllerState
+     */
+    virtual ControllerState get_controller_state() const
+    {
+        return controller_monitor_.get_state();
+    }
+
+    /**
+     * @brief Get the number of times the controller went bus-off.
+     *
+     * @return size_t
+     */
+    virtual size_t get_bus_off_count() const
+    {
+        return controller_monitor_.get_bus_off_count();
+    }
+
+    /**
+     * @brief Get the traffic statistics of the bus.  They can be read from
+     * any thread.
+     *
+     * @return const CanBusStatistics&
+     */
+    const CanBusStatistics& get_statistics() const
+    {
+        return statistics_;
+    }
+
     /**
      * private attributes and methods
      */
@@ -247,9 +445,20 @@ private:
      */
     void loop();
 
+    /**
+     * @brief Wait until a frame can be received or the object is destroyed.
+     *
+     * @return true if a frame can be received.
+     * @return false if the loop has to stop.
+     */
+    bool wait_for_frame();
+
     /**
      * @brief Send input data
      *
+     * Retries until the frame is sent, a frame is only dropped (and counted
+     * as a send failure) while the controller is bus-off.
+     *
      * @param unstamped_can_frame is a frame without id nor time.
      */
     void send_frame(const CanBusFrame& unstamped_can_frame);
@@ -257,9 +466,16 @@ private:
     /**
      * @brief Get the output frame from the bus
      *
-     * @return CanBusFrame is the output frame data.
+     * @param[out] frame is the output frame data.
+     * @return true if a frame was received.
+     * @return false if receiving failed.
+     */
+    bool receive_frame(CanBusFrame& frame);
+
+    /**
+     * @brief Ask the interface to restart the controller after a bus-off.
      */
-    CanBusFrame receive_frame();
+    void restart_controller();
 
     /**
      * @brief Setup and initialize the CanBus object.
@@ -298,11 +514,39 @@ private:
      */
     std::shared_ptr<time_series::TimeSeries<CanBusFrame> > output_;
 
+    /**
+     * @brief Latencies from set_input_frame() until the frame is written to
+     * the socket.
+     */
+    LatencyHistogram send_latency_;
+
+    /**
+     * @brief Traffic statistics of the bus.
+     */
+    CanBusStatistics statistics_;
+
+    /**
+     * @brief Time (s) the controller waits in bus-off before it is
+     * restarted.
+     */
+    static constexpr double BUS_OFF_RESTART_DELAY_S = 0.1;
+
+    /**
+     * @brief Error state of the CAN controller.
+     */
+    CanControllerMonitor controller_monitor_;
+
     /**
      * @brief This boolean makes sure that the loop is not active upon
      * destruction of the current object
      */
-    bool is_loop_active_;
+    std::atomic<bool> is_loop_active_;
+
+    /**
+     * @brief eventfd used to wake up the loop waiting for a frame upon
+     * destruction of the current object (-1 if not available).
+     */
+    int wakeup_fd_;
 
     /**
      * @brief rt_thread_ is the thread object allowing us to spawn real-time
@@ -0,0 +1,138 @@
+/**
+ * @file loopback_can_bus.hpp
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, Max Planck Gesellschaft.
+ * @brief CAN bus simulating an ideal motor board, for tests without
+ * hardware.
+ */
+
+#pragma once
+
+#include <memory>
+
+#include <time_series/time_series.hpp>
+
+#include "blmc_drivers/devices/can_bus.hpp"
+#include "blmc_drivers/utils/can_bus_statistics.hpp"
+#include "blmc_drivers/utils/latency_histogram.hpp"
+
+namespace blmc_drivers
+{
+/**
+ * @brief LoopbackCanBus is a CanBusInterface without hardware, which answers
+ * the frames sent to it like an ideal motor board.
+ *
+ * - Current references are answered with a current measurement of exactly
+ *   the requested currents.
+ * - Commands are answered with a status in which system and motors are
+ *   enabled and ready.
+ *
+ * The answers are available as soon as send_if_input_changed() returns, so a
+ * CanBusMotorBoard on top of it can be used to test the driver stack (or
+ * measure its latencies) in continuous integration.
+ */
+class LoopbackCanBus : public CanBusInterface
+{
+public:
+    /**
+     * @brief Construct a new LoopbackCanBus object
+     *
+     * @param history_length
+     */
+    LoopbackCanBus(const size_t& history_length = 1000);
+
+    /**
+     * Getters
+     */
+
+    virtual std::shared_ptr<const CanframeTimeseries> get_output_frame() const
+    {
+        return output_;
+    }
+
+    virtual std::shared_ptr<const CanframeTimeseries> get_input_frame()
+    {
+        return input_;
+    }
+
+    virtual std::shared_ptr<const CanframeTimeseries> get_sent_input_frame()
+    {
+        return sent_input_;
+    }
+
+    /**
+     * Setters
+     */
+
+    virtual void set_input_frame(const CanBusFrame& input_frame)
+    {
+        input_->append(input_frame);
+    }
+
+    /**
+     * Sender
+     */
+
+    /**
+     * @brief "Send" the newest input frame and append the answer of the board
+     * to the output frames.
+     */
+    virtual void send_if_input_changed();
+
+    /**
+     * @brief Get the latencies from set_input_frame() until the frame is
+     * answered.
+     *
+     * @return const LatencyHistogram&
+     */
+    const LatencyHistogram& get_send_latency() const
+    {
+        return send_latency_;
+    }
+
+    /**
+     * @brief Get the traffic statistics of the bus.
+     *
+     * @return const CanBusStatistics&
+     */
+    const CanBusStatistics& get_statistics() const
+    {
+        return statistics_;
+    }
+
+private:
+    /**
+     * @brief Append the answer of an ideal board to a frame.
+     *
+     * @param frame is the frame sent to the board.
+     */
+    void answer(const CanBusFrame& frame);
+
+    /**
+     * @brief input_ is a list of time stamped frame to be send to the can
+     * network.
+     */
+    std::shared_ptr<CanframeTimeseries> input_;
+
+    /**
+     * @brief sent_inupt_ is the list of the input already sent to the network.
+     */
+    std::shared_ptr<CanframeTimeseries> sent_input_;
+
+    /**
+     * @brief output_ is the list of the frames received from the can network.
+     */
+    std::shared_ptr<CanframeTimeseries> output_;
+
+    /**
+     * @brief Latencies from set_input_frame() until the frame is answered.
+     */
+    LatencyHistogram send_latency_;
+
+    /**
+     * @brief Traffic statistics of the bus.
+     */
+    CanBusStatistics statistics_;
+};
+
+}  // namespace blmc_drivers
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <array>
 #include <memory>
 #include <string>
 
@@ -16,6 +17,8 @@
 
 #include "blmc_drivers/devices/device_interface.hpp"
 #include "blmc_drivers/devices/motor_board.hpp"
+#include "blmc_drivers/utils/channel_handle.hpp"
+#include "blmc_drivers/utils/thermal_limiter.hpp"
 
 namespace blmc_drivers
 {
@@ -31,6 +34,11 @@ public:
      * @brief This is a useful alias.
      */
     typedef time_series::TimeSeries<double> ScalarTimeseries;
+    /**
+     * @brief This is a useful alias.
+     */
+    typedef MotorBoardInterface::EncoderIndexEventTimeseries
+        EncoderIndexEventTimeseries;
     /**
      * @brief This a useful alias for the shared Pointer creation.
      *
@@ -93,6 +101,52 @@ public:
      */
     virtual Ptr<const ScalarTimeseries> get_sent_current_target() const = 0;
 
+    /**
+     * @brief Get the encoder indices seen by the motor, see
+     * MotorBoardInterface::get_encoder_index_events.
+     *
+     * @return Ptr<const EncoderIndexEventTimeseries> nullptr if the motor
+     * does not provide them.
+     */
+    virtual Ptr<const EncoderIndexEventTimeseries> get_encoder_index_events()
+        const
+    {
+        return nullptr;
+    }
+
+    /**
+     * @brief Get a handle to a measurement. Resolve it once and read it in
+     * the control loop, it involves no reference counting (see
+     * ChannelHandle).
+     *
+     * @param index
+     * @return ScalarChannel valid as long as this motor exists.
+     */
+    virtual ScalarChannel get_measurement_channel(const int& index = 0) const
+    {
+        return ScalarChannel(get_measurement(index).get());
+    }
+
+    /**
+     * @brief Get a handle to the current targets to be sent.
+     *
+     * @return ScalarChannel valid as long as this motor exists.
+     */
+    virtual ScalarChannel get_current_target_channel() const
+    {
+        return ScalarChannel(get_current_target().get());
+    }
+
+    /**
+     * @brief Get a handle to the sent current targets.
+     *
+     * @return ScalarChannel valid as long as this motor exists.
+     */
+    virtual ScalarChannel get_sent_current_target_channel() const
+    {
+        return ScalarChannel(get_sent_current_target().get());
+    }
+
     /**
      * Setters
      */
@@ -175,6 +229,45 @@ public:
      */
     virtual Ptr<const ScalarTimeseries> get_sent_current_target() const;
 
+    /**
+     * @brief Get the encoder indices seen by the motor.
+     *
+     * @return Ptr<const EncoderIndexEventTimeseries>
+     */
+    virtual Ptr<const EncoderIndexEventTimeseries> get_encoder_index_events()
+        const
+    {
+        return board_->get_encoder_index_events(motor_id_);
+    }
+
+    /**
+     * @brief Get a handle to a measurement, see MotorInterface.
+     *
+     * @param index see MotorInterface::MeasurementIndex.
+     * @return ScalarChannel
+     */
+    virtual ScalarChannel get_measurement_channel(const int& index = 0) const;
+
+    /**
+     * @brief Get a handle to the current targets to be sent.
+     *
+     * @return ScalarChannel
+     */
+    virtual ScalarChannel get_current_target_channel() const
+    {
+        return ScalarChannel(control_.get());
+    }
+
+    /**
+     * @brief Get a handle to the sent current targets.
+     *
+     * @return ScalarChannel
+     */
+    virtual ScalarChannel get_sent_current_target_channel() const
+    {
+        return ScalarChannel(sent_control_.get());
+    }
+
     /**
      * Setters
      */
@@ -210,6 +303,22 @@ protected:
      * @brief The id of the motor on the MotorBoard.
      */
     bool motor_id_;
+
+    /**
+     * @brief The measurements of this motor, resolved at construction so
+     * that the getters do not branch on the ids.
+     */
+    std::array<Ptr<const ScalarTimeseries>, measurement_count> measurements_;
+
+    /**
+     * @brief The current targets of this motor on the board.
+     */
+    Ptr<const ScalarTimeseries> control_;
+
+    /**
+     * @brief The sent current targets of this motor on the board.
+     */
+    Ptr<const ScalarTimeseries> sent_control_;
 };
 
 /**
@@ -253,6 +362,16 @@ public:
         return current_target_;
     }
 
+    /**
+     * @brief Get a handle to the current targets (before limiting).
+     *
+     * @return ScalarChannel
+     */
+    virtual ScalarChannel get_current_target_channel() const
+    {
+        return ScalarChannel(current_target_.get());
+    }
+
     /**
      * Setters
      */
@@ -284,12 +403,51 @@ public:
         max_velocity_ = max_velocity;
     }
 
+    /**
+     * @brief Limit the current additionally by a model of the winding
+     * temperature (see ThermalLimiter), which allows peaks above the
+     * continuous current while the motor is cool.  The model starts cold.
+     *
+     * The max_current_target_ still applies, set it to at least the peak
+     * current.
+     *
+     * @param parameters of the model.
+     * @throw std::invalid_argument if the parameters are inconsistent.
+     */
+    void enable_thermal_limit(const ThermalLimiterParameters& parameters);
+
+    /**
+     * @brief Get the thermal model, nullptr if the thermal limit is not
+     * enabled.
+     */
+    const ThermalLimiter* get_thermal_limiter() const
+    {
+        return thermal_limiter_.get();
+    }
+
 private:
     /**
      * @brief max_current_target_ is the limit of the current.
      */
     double max_current_target_;
 
+    /**
+     * @brief thermal_limiter_ limits the current depending on the modelled
+     * temperature (may be nullptr).
+     */
+    std::unique_ptr<ThermalLimiter> thermal_limiter_;
+
+    /**
+     * @brief Limited current target of the last call to
+     * set_current_target(), heating the motor until the next call.
+     */
+    double last_safe_current_target_;
+
+    /**
+     * @brief Time of the last call to set_current_target() (s), NaN if none.
+     */
+    double last_current_target_time_s_;
+
     /**
      * @brief max_velocity_ limits the motor velocity.
      */
@@ -8,7 +8,10 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <string_view>
 
 #include <real_time_tools/thread.hpp>
@@ -17,7 +20,10 @@
 
 #include "blmc_drivers/devices/can_bus.hpp"
 #include "blmc_drivers/devices/device_interface.hpp"
+#include "blmc_drivers/utils/latency_histogram.hpp"
 #include "blmc_drivers/utils/os_interface.hpp"
+#include "blmc_drivers/utils/position_unwrapper.hpp"
+#include "blmc_drivers/utils/q24_decoder.hpp"
 
 namespace blmc_drivers {
 //==============================================================================
@@ -199,6 +205,37 @@ public:
   }
 };
 
+//==============================================================================
+/**
+ * @brief An encoder index seen by a motor board, with the position samples
+ * around it.
+ *
+ * The board sends the position of the index as soon as it passes it, i.e.
+ * between two POS frames.  The time at which the index was passed is
+ * interpolated from the preceding position sample and velocity, which
+ * resolves it below the period of the position samples.
+ */
+struct EncoderIndexEvent {
+  //! @brief Time (s) at which the frame was received.
+  double received_time_s = 0.0;
+  //! @brief Motor of the board (0 or 1).
+  int motor = 0;
+  //! @brief Unwrapped motor position of the index (rad).
+  double index_position = 0.0;
+  //! @brief Newest motor position received before the index (rad), NaN if
+  //! none.
+  double previous_position = 0.0;
+  //! @brief Time (s) at which previous_position was received.
+  double previous_position_time_s = 0.0;
+  //! @brief Newest motor velocity received before the index (rad/s), NaN
+  //! if none.
+  double velocity = 0.0;
+  //! @brief Estimated time (s) at which the index was passed, between
+  //! previous_position_time_s and received_time_s (received_time_s if it
+  //! cannot be interpolated).
+  double crossing_time_s = 0.0;
+};
+
 //==============================================================================
 /**
  * @brief MotorBoardInterface declares an API to inacte with a MotorBoard.
@@ -230,6 +267,11 @@ public:
    * @brief A useful shortcut
    */
   typedef time_series::TimeSeries<MotorBoardCommand> CommandTimeseries;
+  /**
+   * @brief A useful shortcut
+   */
+  typedef time_series::TimeSeries<EncoderIndexEvent>
+      EncoderIndexEventTimeseries;
   /**
    * @brief A useful shortcut
    */
@@ -283,6 +325,22 @@ public:
    */
   virtual Ptr<const StatusTimeseries> get_status() const = 0;
 
+  /**
+   * @brief Get the encoder indices seen by a motor.
+   *
+   * Unlike the encoder_index measurements, the events carry the time and
+   * the surrounding position samples.  Wait for the next one with
+   * wait_for_timeindex(newest_timeindex(false) + 1, timeout_s).
+   *
+   * @param motor is the motor of the board (0 or 1).
+   * @return Ptr<const EncoderIndexEventTimeseries> nullptr if the board does
+   * not provide them.
+   */
+  virtual Ptr<const EncoderIndexEventTimeseries>
+  get_encoder_index_events(const int & /*motor*/) const {
+    return nullptr;
+  }
+
   /**
    * input logs
    */
@@ -369,6 +427,70 @@ create_vector_of_pointers(const size_t &size, const size_t &length) {
   return vector;
 }
 
+//==============================================================================
+/**
+ * @brief MotorBoardListener gets notified by a CanBusMotorBoard about every
+ * measurement and status it receives, e.g. to forward them to other processes.
+ *
+ * The methods are called from the real-time thread of the board, after the
+ * data was appended to the time series of the board.  They must not allocate
+ * memory, and every time they spend delays the processing of the following
+ * frames, for all listeners of the board.  Sending controls to the board (or
+ * other boards) is allowed, the fatal errors of sending then call exit(-1) in
+ * the thread of the board.
+ */
+class MotorBoardListener {
+public:
+  /**
+   * @brief Destroy the MotorBoardListener object
+   */
+  virtual ~MotorBoardListener() {}
+
+  /**
+   * @brief Called after a measurement has been appended to its time series.
+   *
+   * @param index is the MotorBoardInterface::MeasurementIndex.
+   * @param value is the measurement.
+   */
+  virtual void on_measurement(const int &index, const double &value) = 0;
+
+  /**
+   * @brief Called after a status has been appended to its time series.
+   *
+   * @param status
+   */
+  virtual void on_status(const MotorBoardStatus &status) = 0;
+
+  /**
+   * @brief Called after each batch of received frames, e.g. to wake up
+   * readers once for all data of the batch.
+   */
+  virtual void on_batch_end() {}
+};
+
+//==============================================================================
+/**
+ * @brief Latencies of the stages between setting a control and receiving the
+ * resulting current measurement, as recorded by a CanBusMotorBoard.
+ *
+ * The board measures the current at a fixed rate, independent of the
+ * controls, so the latencies up to the current measurement are the time until
+ * the first measurement after the control was sent.
+ */
+struct MotorBoardLatencies {
+  //! @brief From set_control() until the controls are written to the bus.
+  LatencyHistogram control_to_sent;
+  //! @brief From writing the controls to the bus until the next current
+  //! measurement is available.
+  LatencyHistogram sent_to_current_measurement;
+  //! @brief From set_control() until the next current measurement is
+  //! available.
+  LatencyHistogram control_to_current_measurement;
+  //! @brief From receiving a frame on the bus until its measurements are
+  //! available.
+  LatencyHistogram received_to_measurement;
+};
+
 //==============================================================================
 /**
  * @brief This class CanBusMotorBoard implements a MotorBoardInterface specific
@@ -376,16 +498,30 @@ create_vector_of_pointers(const size_t &size, const size_t &length) {
  */
 class CanBusMotorBoard : public MotorBoardInterface {
 public:
+  /**
+   * @brief The max. position (in motor revolutions) measured by the board.
+   * Beyond it the position rolls over to -MAX_MOTOR_POSITION_MREV.
+   *
+   * The positions published by this class are unwrapped, i.e. they stay
+   * continuous over such rollovers.
+   */
+  static constexpr double MAX_MOTOR_POSITION_MREV = 100;
+
   /**
    * @brief Construct a new CanBusMotorBoard object
    *
    * @param can_bus
    * @param history_length
+   * @param control_timeout_ms
+   * @param cpu_id is the cpu of the thread of the board (-1 for any).
+   * @param priority of the thread of the board (-1 for 90 if a cpu is given,
+   * otherwise the default of real_time_tools).
    */
   CanBusMotorBoard(std::shared_ptr<CanBusInterface> can_bus,
                    const size_t &history_length = 1000,
                    const int &control_timeout_ms = 100,
-		   const int &cpu_id = -1);
+		   const int &cpu_id = -1,
+                   const int &priority = -1);
 
   /**
    * @brief Destroy the CanBusMotorBoard object
@@ -414,6 +550,18 @@ public:
    */
   virtual Ptr<const StatusTimeseries> get_status() const { return status_; }
 
+  /**
+   * @brief Get the encoder indices seen by a motor, see
+   * MotorBoardInterface::get_encoder_index_events.
+   *
+   * @param motor is the motor of the board (0 or 1).
+   * @return Ptr<const EncoderIndexEventTimeseries>
+   */
+  virtual Ptr<const EncoderIndexEventTimeseries>
+  get_encoder_index_events(const int &motor) const {
+    return encoder_index_events_[motor];
+  }
+
   /**
    * @brief Get the controls to be sent.
    *
@@ -440,7 +588,7 @@ public:
    * @return Ptr<const ScalarTimeseries> is the list of the sent cotnrols.
    */
   virtual Ptr<const ScalarTimeseries> get_sent_control(const int &index) const {
-    return control_[index];
+    return sent_control_[index];
   }
 
   /**
@@ -496,6 +644,63 @@ public:
    */
   void disable_can_recv_timeout();
 
+  /**
+   * @brief Disable the error the board raises when its position rolls over.
+   *
+   * Use this for joints which rotate continuously (e.g. wheels).  The
+   * positions are unwrapped on the host, so they stay continuous anyway.
+   */
+  void disable_position_rollover_error();
+
+  /**
+   * @brief Maximum number of listeners of a board.
+   */
+  static constexpr size_t MAX_LISTENER_COUNT = 4;
+
+  /**
+   * @brief Add a listener which is notified about all received data, after
+   * the listeners added before it.
+   *
+   * Takes effect with the next batch of received frames.
+   *
+   * @param listener
+   * @throw std::invalid_argument if the listener is nullptr or already added.
+   * @throw std::runtime_error if the board has MAX_LISTENER_COUNT listeners.
+   */
+  void add_listener(std::shared_ptr<MotorBoardListener> listener);
+
+  /**
+   * @brief Remove a listener added with add_listener().
+   *
+   * Waits until the batch of received frames being processed is done, so
+   * the listener is not notified anymore once this returns and the caller
+   * keeps the last reference to it.  Must not be called from a listener
+   * (i.e. from the thread of the board).
+   *
+   * @param listener
+   * @return false if the listener was not added.
+   */
+  bool remove_listener(const std::shared_ptr<MotorBoardListener> &listener);
+
+  /**
+   * @brief Get the latencies of the communication with the board.
+   *
+   * @return const MotorBoardLatencies&
+   */
+  const MotorBoardLatencies &get_latencies() const { return latencies_; }
+
+  /**
+   * @brief Get the newest sent value of a control without taking the mutex
+   * of a time series, e.g. from a listener.  The two controls may be from
+   * different sends if a send is in progress.
+   *
+   * @param index is the MotorBoardInterface::ControlIndex.
+   * @return double NaN if no control was sent yet.
+   */
+  double get_newest_sent_control(const int &index) const {
+    return newest_sent_controls_[index].load(std::memory_order_relaxed);
+  }
+
   /**
    * @brief Display details of this object.
    */
@@ -576,12 +781,65 @@ private:
    */
   void loop();
 
+  /**
+   * @brief Get the factor converting the decoded Q24 values of a frame into
+   * SI units (rad, rad/s, A).
+   *
+   * @param can_id is the id of the received frame.
+   * @return double the unit scale.
+   */
+  static double get_unit_scale(const can_id_t &can_id);
+
+  /**
+   * @brief Store the content of one received frame in the corresponding
+   * time series.
+   *
+   * @param can_frame is the received frame.
+   * @param received_time_s is the time at which the frame was received.
+   * @param measurement_0 is the first decoded value of the frame.
+   * @param measurement_1 is the second decoded value of the frame.
+   */
+  void process_frame(const CanBusFrame &can_frame,
+                     const double &received_time_s,
+                     const double &measurement_0,
+                     const double &measurement_1);
+
+  /**
+   * @brief Append the encoder index of a motor to its measurements and
+   * events.
+   *
+   * @param motor is the motor of the board (0 or 1).
+   * @param received_time_s is the time at which the frame was received.
+   * @param index_position is the unwrapped position of the index.
+   */
+  void append_encoder_index(const int &motor, const double &received_time_s,
+                            const double &index_position);
+
+  /**
+   * @brief Append a measurement to its time series and notify the listener.
+   *
+   * @param index is the kind of measurement.
+   * @param value is the measurement.
+   */
+  void append_measurement(const int &index, const double &value);
+
 private:
   /**
    * @brief This is the pointer to the can bus to communicate with.
    */
   std::shared_ptr<CanBusInterface> can_bus_;
 
+  /**
+   * @brief Maximum number of received frames decoded at once by loop().
+   */
+  static constexpr size_t MAX_DECODE_BATCH_SIZE = 16;
+
+  /**
+   * @brief Max. time (s) the loop waits for a frame before checking whether
+   * it has to stop.
+   */
+  static constexpr double LOOP_WAKEUP_PERIOD_S = 0.005;
+
   /**
    * @brief These are the frame IDs that define the kind of data we acquiere
    * from the CAN bus
@@ -612,6 +870,76 @@ private:
    */
   Ptr<StatusTimeseries> status_;
 
+  /**
+   * @brief The encoder indices seen by each motor.
+   */
+  std::array<Ptr<EncoderIndexEventTimeseries>, 2> encoder_index_events_;
+
+  /**
+   * @brief Time (s) at which the newest POS frame was received (NaN if
+   * none).
+   */
+  double position_received_time_s_;
+
+  /**
+   * @brief Turn the rolling over positions of the two motors into
+   * continuous ones.
+   */
+  std::array<PositionUnwrapper, 2> position_unwrappers_;
+
+  /**
+   * @brief The listeners added with add_listener(), the free slots are
+   * nullptr.  Owns them, guarded by listeners_mutex_.
+   */
+  std::array<std::shared_ptr<MotorBoardListener>, MAX_LISTENER_COUNT>
+      listeners_;
+
+  /**
+   * @brief The listeners_ read by the loop at the start of each batch.
+   */
+  std::array<std::atomic<MotorBoardListener *>, MAX_LISTENER_COUNT>
+      listener_slots_;
+
+  /**
+   * @brief Incremented by the loop at the start and at the end of each batch
+   * (i.e. odd while a batch is processed), for remove_listener() to wait for
+   * the batch.
+   */
+  std::atomic<uint64_t> batch_generation_;
+
+  /**
+   * @brief Serializes add_listener() and remove_listener().
+   */
+  std::mutex listeners_mutex_;
+
+  /**
+   * @brief The listeners notified about the current batch of received
+   * frames.  Only accessed by the loop.
+   */
+  std::array<MotorBoardListener *, MAX_LISTENER_COUNT> active_listeners_;
+
+  /**
+   * @brief Number of active_listeners_.
+   */
+  size_t active_listener_count_;
+
+  /**
+   * @brief Latencies of the communication with the board.
+   */
+  MotorBoardLatencies latencies_;
+
+  /**
+   * @brief Time (s) at which the controls waiting for the next current
+   * measurement were set (NaN if none).
+   */
+  std::atomic<double> pending_control_set_time_s_;
+
+  /**
+   * @brief Time (s) at which the controls waiting for the next current
+   * measurement were sent (NaN if none).
+   */
+  std::atomic<double> pending_control_sent_time_s_;
+
   /**
    * Inputs
    */
@@ -635,6 +963,12 @@ private:
    */
   Vector<Ptr<ScalarTimeseries>> sent_control_;
 
+  /**
+   * @brief The newest element of each of sent_control_, for lock-free
+   * reading.
+   */
+  std::array<std::atomic<double>, control_count> newest_sent_controls_;
+
   /**
    * @brief This is the history of the already sent commands.
    */
@@ -648,7 +982,7 @@ private:
    * @brief This boolean makes sure that the loop is stopped upon destruction
    * of this object.
    */
-  bool is_loop_active_;
+  std::atomic<bool> is_loop_active_;
 
   /**
    * @brief Are motor in idle mode = 0 torques?
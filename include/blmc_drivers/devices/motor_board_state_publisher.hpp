@@ -0,0 +1,143 @@
+/**
+ * @file motor_board_state_publisher.hpp
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, Max Planck Gesellschaft.
+ * @brief Export of the state of a motor board to shared memory, for
+ * monitoring from other processes.
+ */
+
+#pragma once
+
+#include <array>
+#include <memory>
+#include <string>
+
+#include "blmc_drivers/devices/can_bus.hpp"
+#include "blmc_drivers/devices/motor_board.hpp"
+#include "blmc_drivers/utils/shared_memory_ring.hpp"
+
+namespace blmc_drivers
+{
+/**
+ * @brief Snapshot of a motor board as exported to shared memory.
+ *
+ * Values which were never received are NaN.
+ */
+struct MotorBoardStateRecord
+{
+    //! @brief Time (s) at which the snapshot was taken.
+    double timestamp_s;
+    //! @brief Newest value of each MotorBoardInterface::MeasurementIndex.
+    std::array<double, MotorBoardInterface::measurement_count> measurements;
+    //! @brief Number of values of each measurement received since the
+    //! publisher was created.
+    std::array<int64_t, MotorBoardInterface::measurement_count>
+        measurement_counts;
+    //! @brief Newest sent value of each MotorBoardInterface::ControlIndex.
+    std::array<double, MotorBoardInterface::control_count> sent_controls;
+    //! @brief Newest status of the board.
+    MotorBoardStatus status;
+    //! @brief False as long as no status was received.
+    bool has_status;
+    //! @brief Number of frames received on the CAN bus of the board (-1 if
+    //! the bus is not a CanBus).
+    int64_t can_bus_received_frames;
+    //! @brief Number of frames sent on the CAN bus of the board (-1 if the
+    //! bus is not a CanBus).
+    int64_t can_bus_sent_frames;
+};
+
+/**
+ * @brief Reader for the records exported by a MotorBoardStatePublisher.  It
+ * can be used in any process, see SharedMemoryRingReader.
+ */
+typedef SharedMemoryRingReader<MotorBoardStateRecord> MotorBoardStateReader;
+
+/**
+ * @brief Mirrors the measurements, status, sent controls and bus counters of
+ * a motor board into a lock-free ring in shared memory.
+ *
+ * The publisher is a listener of the board: the real-time thread of the
+ * board updates a snapshot with every received measurement and status, and
+ * appends it to the ring after each batch of frames containing a position
+ * measurement (i.e. once per board cycle).  No time series is read and no
+ * lock is taken, the sent controls and the bus counters are read from
+ * atomics.  Any number of MotorBoardStateReader can attach to the ring from
+ * other processes, without any influence on the driver.
+ */
+class MotorBoardStatePublisher
+{
+public:
+    /**
+     * @brief Construct a new MotorBoardStatePublisher object and start
+     * publishing.
+     *
+     * @param board is the board to export.
+     * @param can_bus is the bus of the board, used for the bus counters if it
+     * is a CanBus (may be nullptr).
+     * @param name of the shared memory segment (/dev/shm/<name>).
+     * @param capacity is the number of snapshots kept in the ring.
+     * @throw std::runtime_error if the board has too many listeners.
+     */
+    MotorBoardStatePublisher(std::shared_ptr<CanBusMotorBoard> board,
+                             std::shared_ptr<CanBusInterface> can_bus,
+                             const std::string& name,
+                             const size_t& capacity = 10000);
+
+    /**
+     * @brief Stop publishing and remove the shared memory segment.
+     */
+    ~MotorBoardStatePublisher();
+
+private:
+    /**
+     * @brief Collects the data received by the board and appends the
+     * snapshots to the ring.
+     */
+    class SnapshotWriter : public MotorBoardListener
+    {
+    public:
+        /**
+         * @param board is the exported board, which outlives the writer.
+         * @param can_bus is the bus of the board (may be nullptr).
+         * @param name of the shared memory segment.
+         * @param capacity is the number of snapshots kept in the ring.
+         */
+        SnapshotWriter(const CanBusMotorBoard* board,
+                       const CanBus* can_bus,
+                       const std::string& name,
+                       const size_t& capacity);
+
+        virtual void on_measurement(const int& index, const double& value);
+
+        virtual void on_status(const MotorBoardStatus& status);
+
+        virtual void on_batch_end();
+
+    private:
+        const CanBusMotorBoard* board_;
+        const CanBus* can_bus_;
+        SharedMemoryRingWriter<MotorBoardStateRecord> ring_;
+        //! @brief The snapshot, updated by the thread of the board.
+        MotorBoardStateRecord record_;
+        //! @brief True if the current batch contained a position.
+        bool has_new_position_;
+    };
+
+    /**
+     * @brief The exported board.
+     */
+    std::shared_ptr<CanBusMotorBoard> board_;
+
+    /**
+     * @brief The bus of the board (may be nullptr).
+     */
+    std::shared_ptr<CanBusInterface> can_bus_;
+
+    /**
+     * @brief The listener writing the snapshots.
+     */
+    std::shared_ptr<SnapshotWriter> snapshot_writer_;
+};
+
+}  // namespace blmc_drivers
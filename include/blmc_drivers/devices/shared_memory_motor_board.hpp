@@ -0,0 +1,336 @@
+/**
+ * @file shared_memory_motor_board.hpp
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, Max Planck Gesellschaft.
+ * @brief Access to a motor board driven by another process (e.g. the
+ * blmc_driver_daemon) through shared memory.
+ */
+
+#pragma once
+
+#include <array>
+#include <memory>
+#include <string>
+
+#include <real_time_tools/thread.hpp>
+#include <time_series/time_series.hpp>
+
+#include "blmc_drivers/devices/motor_board.hpp"
+#include "blmc_drivers/utils/shared_memory_ring.hpp"
+
+namespace blmc_drivers
+{
+/**
+ * @brief A measurement or status received from a board, as forwarded to the
+ * clients.
+ */
+struct MotorBoardEvent
+{
+    //! @brief MotorBoardInterface::MeasurementIndex, or -1 for a status.
+    int32_t measurement_index;
+    //! @brief The measurement (unused for a status).
+    double value;
+    //! @brief The status (unused for a measurement).
+    MotorBoardStatus status;
+};
+
+/**
+ * @brief Controls or a command sent by a client to the board.
+ */
+struct MotorBoardRequest
+{
+    /**
+     * @brief The kinds of requests.
+     */
+    enum Type
+    {
+        CONTROLS,
+        COMMAND
+    };
+
+    //! @brief The Type of the request.
+    int32_t type;
+    //! @brief Value of each MotorBoardInterface::ControlIndex (for CONTROLS).
+    std::array<double, MotorBoardInterface::control_count> controls;
+    //! @brief The command (for COMMAND).
+    MotorBoardCommand command;
+};
+
+/**
+ * @brief Get the name of the ring the events of a board are forwarded to.
+ */
+inline std::string get_motor_board_event_ring_name(const std::string& name)
+{
+    return name + "_measurements";
+}
+
+/**
+ * @brief Get the name of the ring the requests to a board are read from.
+ */
+inline std::string get_motor_board_request_ring_name(const std::string& name)
+{
+    return name + "_requests";
+}
+
+/**
+ * @brief Makes a CanBusMotorBoard available to other processes.
+ *
+ * Every measurement and status received by the board is forwarded (from the
+ * real-time thread of the board, without blocking) to a ring in shared
+ * memory.  Controls and commands of a SharedMemoryMotorBoard are read from a
+ * second ring by a thread of this object and sent to the board.
+ *
+ * Only one client can send requests at a time.  If a client crashes the
+ * board stops the motors once its control timeout expires, and a new client
+ * can take over.
+ */
+class MotorBoardServer
+{
+public:
+    /**
+     * @brief Construct a new MotorBoardServer object and start serving.
+     *
+     * @param board is the board to serve.
+     * @param name is the prefix of the shared memory segments, the clients
+     * use the same name.
+     * @param capacity is the number of events (requests) kept in the rings.
+     * @param cpu_id is the cpu the request thread runs on (-1 for any).
+     */
+    MotorBoardServer(std::shared_ptr<CanBusMotorBoard> board,
+                     const std::string& name,
+                     const size_t& capacity = 10000,
+                     const int& cpu_id = -1);
+
+    /**
+     * @brief Stop serving and remove the shared memory segments.
+     */
+    ~MotorBoardServer();
+
+private:
+    /**
+     * @brief Appends the data received by the board to the event ring.
+     */
+    class EventForwarder : public MotorBoardListener
+    {
+    public:
+        EventForwarder(const std::string& name, const size_t& capacity)
+            : events_(get_motor_board_event_ring_name(name), capacity)
+        {
+        }
+
+        virtual void on_measurement(const int& index, const double& value);
+
+        virtual void on_status(const MotorBoardStatus& status);
+
+        virtual void on_batch_end();
+
+    private:
+        SharedMemoryRingWriter<MotorBoardEvent> events_;
+    };
+
+    /**
+     * @brief Helper to spawn the thread.
+     *
+     * @param instance_pointer is the current object.
+     * @return THREAD_FUNCTION_RETURN_TYPE depends on the current OS.
+     */
+    static THREAD_FUNCTION_RETURN_TYPE loop(void* instance_pointer)
+    {
+        ((MotorBoardServer*)(instance_pointer))->loop();
+        return THREAD_FUNCTION_RETURN_VALUE;
+    }
+
+    /**
+     * @brief Send the requests of the clients to the board.
+     */
+    void loop();
+
+    /**
+     * @brief The served board.
+     */
+    std::shared_ptr<CanBusMotorBoard> board_;
+
+    /**
+     * @brief The listener forwarding the events of the board.
+     */
+    std::shared_ptr<EventForwarder> event_forwarder_;
+
+    /**
+     * @brief The ring the clients write their requests to.
+     */
+    SharedMemoryRingReader<MotorBoardRequest> requests_;
+
+    /**
+     * @brief Index of the first request sent to the board.
+     */
+    int64_t first_request_index_;
+
+    /**
+     * @brief This boolean makes sure that the loop is stopped upon destruction
+     * of this object.
+     */
+    bool is_loop_active_;
+
+    /**
+     * @brief The thread sending the requests.
+     */
+    real_time_tools::RealTimeThread thread_;
+};
+
+/**
+ * @brief Client of a MotorBoardServer, i.e. a MotorBoardInterface to a board
+ * which is driven by another process.
+ *
+ * The time series behave like the ones of CanBusMotorBoard, so the client
+ * can be used with Motor, SafeMotor, BlmcJointModule etc.  Only the data
+ * received after construction is available.
+ */
+class SharedMemoryMotorBoard : public MotorBoardInterface
+{
+public:
+    /**
+     * @brief Connect to a board.
+     *
+     * @param name is the name of the MotorBoardServer.
+     * @param history_length is the length of the local time series.
+     * @param cpu_id is the cpu the receiving thread runs on (-1 for any).
+     * @throw std::runtime_error if no server of this name is running or
+     * another client is connected.
+     */
+    SharedMemoryMotorBoard(const std::string& name,
+                           const size_t& history_length = 1000,
+                           const int& cpu_id = -1);
+
+    /**
+     * @brief Disconnect from the board.
+     */
+    ~SharedMemoryMotorBoard();
+
+    /**
+     * Getters
+     */
+
+    virtual Ptr<const ScalarTimeseries> get_measurement(const int& index) const
+    {
+        return measurement_[index];
+    }
+
+    virtual Ptr<const StatusTimeseries> get_status() const
+    {
+        return status_;
+    }
+
+    virtual Ptr<const ScalarTimeseries> get_control(const int& index) const
+    {
+        return control_[index];
+    }
+
+    virtual Ptr<const CommandTimeseries> get_command() const
+    {
+        return command_;
+    }
+
+    virtual Ptr<const ScalarTimeseries> get_sent_control(
+        const int& index) const
+    {
+        return sent_control_[index];
+    }
+
+    virtual Ptr<const CommandTimeseries> get_sent_command() const
+    {
+        return sent_command_;
+    }
+
+    /**
+     * Setters
+     */
+
+    virtual void set_control(const double& control, const int& index)
+    {
+        control_[index]->append(control);
+    }
+
+    virtual void set_command(const MotorBoardCommand& command)
+    {
+        command_->append(command);
+    }
+
+    /**
+     * @brief Send the new command and controls to the server.
+     */
+    virtual void send_if_input_changed();
+
+    /**
+     * @brief returns only once board and motors are ready.
+     */
+    void wait_until_ready();
+
+    /**
+     * @brief Check if board and motors are ready.
+     */
+    bool is_ready();
+
+private:
+    /**
+     * @brief Helper to spawn the thread.
+     *
+     * @param instance_pointer is the current object.
+     * @return THREAD_FUNCTION_RETURN_TYPE depends on the current OS.
+     */
+    static THREAD_FUNCTION_RETURN_TYPE loop(void* instance_pointer)
+    {
+        ((SharedMemoryMotorBoard*)(instance_pointer))->loop();
+        return THREAD_FUNCTION_RETURN_VALUE;
+    }
+
+    /**
+     * @brief Append the events of the server to the local time series.
+     */
+    void loop();
+
+    /**
+     * @brief The ring of the events of the board.
+     */
+    SharedMemoryRingReader<MotorBoardEvent> events_;
+
+    /**
+     * @brief The ring of the requests to the board.
+     */
+    SharedMemoryRingWriter<MotorBoardRequest> requests_;
+
+    /**
+     * @brief Index of the first event appended to the time series.
+     */
+    int64_t first_event_index_;
+
+    /**
+     * Outputs
+     */
+    Vector<Ptr<ScalarTimeseries>> measurement_;
+    Ptr<StatusTimeseries> status_;
+
+    /**
+     * Inputs
+     */
+    Vector<Ptr<ScalarTimeseries>> control_;
+    Ptr<CommandTimeseries> command_;
+
+    /**
+     * Log
+     */
+    Vector<Ptr<ScalarTimeseries>> sent_control_;
+    Ptr<CommandTimeseries> sent_command_;
+
+    /**
+     * @brief This boolean makes sure that the loop is stopped upon destruction
+     * of this object.
+     */
+    bool is_loop_active_;
+
+    /**
+     * @brief The receiving thread.
+     */
+    real_time_tools::RealTimeThread thread_;
+};
+
+}  // namespace blmc_drivers
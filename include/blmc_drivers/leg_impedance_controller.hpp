@@ -0,0 +1,220 @@
+/**
+ * @file leg_impedance_controller.hpp
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, Max Planck Gesellschaft.
+ * @brief Cartesian impedance control of a leg at the rate of its boards.
+ */
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <Eigen/Eigen>
+
+#include "blmc_drivers/devices/leg.hpp"
+#include "blmc_drivers/devices/motor_board.hpp"
+#include "blmc_drivers/leg_kinematics.hpp"
+#include "blmc_drivers/utils/triple_buffer.hpp"
+
+namespace blmc_drivers
+{
+/**
+ * @brief Setpoints and gains of the LegImpedanceController, in the foot
+ * space of LegKinematics.
+ *
+ * The default target applies no force.
+ */
+struct LegImpedanceTarget
+{
+    //! @brief Desired foot position (m).
+    Eigen::Vector2d foot_position = Eigen::Vector2d::Zero();
+    //! @brief Desired foot velocity (m/s).
+    Eigen::Vector2d foot_velocity = Eigen::Vector2d::Zero();
+    //! @brief Feed-forward force at the foot (N).
+    Eigen::Vector2d foot_force = Eigen::Vector2d::Zero();
+    //! @brief Cartesian stiffness (N/m).
+    Eigen::Matrix2d stiffness = Eigen::Matrix2d::Zero();
+    //! @brief Cartesian damping (Ns/m).
+    Eigen::Matrix2d damping = Eigen::Matrix2d::Zero();
+};
+
+/**
+ * @brief Cartesian impedance controller of a leg which runs in the threads of
+ * its motor boards, at the rate at which they send their measurements.
+ *
+ * Each time both the hip and the knee got a new position and velocity, the
+ * controller applies the foot force
+ * \f[
+ * f = K (p_{des} - p) + D (v_{des} - v) + f_{ff}
+ * \f]
+ * through the transposed Jacobian (see LegKinematics) and sends the currents
+ * at once, i.e. without the delay of a control loop in a separate thread.
+ *
+ * The target is passed from the user thread through a TripleBuffer, so
+ * neither side waits for the other.  Nothing is sent before the first
+ * set_target().
+ *
+ * The controller is a listener of the boards (see
+ * CanBusMotorBoard::add_listener()) and it sends the controls of its motors.
+ * So do not control these motors from elsewhere while the controller exists.
+ *
+ * The control step runs in the thread of a board and writes CAN frames, so
+ * the frames received meanwhile wait for it, and a fatal error while sending
+ * (which calls exit(-1), as in a control loop) happens in that thread.
+ *
+ * Example:
+ * \code
+ * LegImpedanceController controller(board, 0, board, 1, parameters);
+ * LegImpedanceTarget target;
+ * target.stiffness.diagonal() << 200, 200;
+ * target.damping.diagonal() << 2, 2;
+ * while (...)
+ * {
+ *     target.foot_position << 0.0, -0.25 + 0.05 * sin(t);
+ *     controller.set_target(target);
+ *     spinner.spin();
+ * }
+ * \endcode
+ */
+class LegImpedanceController
+{
+public:
+    /**
+     * @brief Construct a new LegImpedanceController object and start
+     * listening to the boards.
+     *
+     * The hip and the knee may be on the same board.
+     *
+     * @param hip_board is the board of the hip motor.
+     * @param hip_motor_id is the id of the hip motor on its board.
+     * @param knee_board is the board of the knee motor.
+     * @param knee_motor_id is the id of the knee motor on its board.
+     * @param parameters are the geometry and drive of the leg.
+     * @param max_current is the limit of the motor currents (A).
+     * @throw std::invalid_argument if both motors are the same or the
+     * parameters are invalid.
+     * @throw std::runtime_error if a board has too many listeners.
+     */
+    LegImpedanceController(std::shared_ptr<CanBusMotorBoard> hip_board,
+                           const bool& hip_motor_id,
+                           std::shared_ptr<CanBusMotorBoard> knee_board,
+                           const bool& knee_motor_id,
+                           const LegKinematicsParameters& parameters =
+                               LegKinematicsParameters(),
+                           const double& max_current = 2.0);
+
+    /**
+     * @brief Stop listening to the boards.  The motors keep the last
+     * currents until the control timeout of the boards.
+     */
+    ~LegImpedanceController();
+
+    /**
+     * @brief Set the target, used from the next measurement on.
+     *
+     * Must only be called from one thread at a time.
+     *
+     * @param target
+     */
+    void set_target(const LegImpedanceTarget& target);
+
+    /**
+     * @brief Get the leg, to read the measurements and the current targets.
+     * Do not set currents on it.
+     */
+    std::shared_ptr<const LegInterface> get_leg() const
+    {
+        return control_state_->leg;
+    }
+
+    /**
+     * @brief Get the number of control steps done so far.
+     */
+    uint64_t get_step_count() const
+    {
+        return control_state_->step_count.load(std::memory_order_relaxed);
+    }
+
+private:
+    /**
+     * @brief The state used by the board threads.  It is shared with the
+     * listeners, so it outlives a batch of frames a board processes while
+     * the controller is destroyed.
+     */
+    struct ControlState
+    {
+        ControlState(std::shared_ptr<Leg> leg,
+                     const LegKinematicsParameters& parameters)
+            : leg(leg), kinematics({leg}, {parameters}), fresh_data(0)
+        {
+        }
+
+        std::shared_ptr<Leg> leg;
+        LegKinematics<1> kinematics;
+        TripleBuffer<LegImpedanceTarget> targets;
+        //! @brief If set_target() was called and taken by the board threads.
+        bool has_target = false;
+        //! @brief Bits of the measurements received since the last step.
+        std::atomic<uint32_t> fresh_data;
+        std::atomic<uint64_t> step_count{0};
+    };
+
+    /**
+     * @brief Collects the measurements of the leg from one board and runs
+     * the control step when all of them are fresh.
+     */
+    class BoardListener : public MotorBoardListener
+    {
+    public:
+        BoardListener(std::shared_ptr<ControlState> control_state);
+
+        /**
+         * @brief Trigger the control step on the given measurement.
+         *
+         * @param index is the MotorBoardInterface::MeasurementIndex.
+         * @param bit of the measurement in ControlState::fresh_data.
+         */
+        void add_measurement(const int& index, const uint32_t& bit);
+
+        virtual void on_measurement(const int& index, const double& value);
+
+        virtual void on_status(const MotorBoardStatus& status);
+
+    private:
+        std::shared_ptr<ControlState> control_state_;
+
+        //! @brief Bit of each measurement of the board (0 if not used).
+        std::array<uint32_t, MotorBoardInterface::measurement_count> bits_;
+    };
+
+    //! @brief Bits of ControlState::fresh_data.
+    enum FreshDataBits : uint32_t
+    {
+        HIP_POSITION = 1 << 0,
+        HIP_VELOCITY = 1 << 1,
+        KNEE_POSITION = 1 << 2,
+        KNEE_VELOCITY = 1 << 3,
+        ALL_DATA = 0xF
+    };
+
+    /**
+     * @brief Compute and send the currents for the newest measurements.
+     */
+    static void control(ControlState& control_state);
+
+    std::shared_ptr<ControlState> control_state_;
+
+    /**
+     * @brief The boards the controller listens to (one or two).
+     */
+    std::vector<std::shared_ptr<CanBusMotorBoard>> boards_;
+
+    /**
+     * @brief The listener added to each of boards_.
+     */
+    std::vector<std::shared_ptr<BoardListener>> listeners_;
+};
+
+}  // namespace blmc_drivers
@@ -0,0 +1,247 @@
+/**
+ * @file leg_kinematics.hpp
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, Max Planck Gesellschaft.
+ * @brief Foot kinematics and force to torque mapping of the legs of a robot.
+ */
+#pragma once
+
+#include <memory>
+#include <stdexcept>
+
+#include <Eigen/Eigen>
+
+#include "blmc_drivers/blmc_joint_module.hpp"
+#include "blmc_drivers/devices/leg.hpp"
+
+namespace blmc_drivers
+{
+/**
+ * @brief Geometry and drive of a leg.
+ */
+struct LegKinematicsParameters
+{
+    //! @brief Distance from the hip to the knee (m).
+    double upper_leg_length = 0.16;
+    //! @brief Distance from the knee to the foot (m).
+    double lower_leg_length = 0.16;
+    //! @brief Gear ratios of the hip and the knee (motor per joint angle).
+    Eigen::Vector2d gear_ratios = Eigen::Vector2d(9.0, 9.0);
+    //! @brief Torque constants of the hip and knee motors (Nm/A).
+    Eigen::Vector2d motor_constants = Eigen::Vector2d(0.025, 0.025);
+    /**
+     * @brief Motor angles divided by the gear ratio (rad) at joint angle 0
+     * of the hip and knee, as BlmcJointModule::set_zero_angle().
+     */
+    Eigen::Vector2d zero_angles = Eigen::Vector2d::Zero();
+};
+
+/**
+ * @brief Forward kinematics, Jacobians and foot force to motor current
+ * mapping of COUNT planar legs at once.
+ *
+ * The hip and the knee turn about parallel axes (y).  The foot position is
+ * given in the frame of the hip, with x pointing forward and z up.  At zero
+ * joint angles the leg is stretched downwards; the knee angle is relative to
+ * the upper leg:
+ * \f{eqnarray*}{
+ * x &=& -l_1 \sin(q_{hip}) - l_2 \sin(q_{hip} + q_{knee}) \\
+ * z &=& -l_1 \cos(q_{hip}) - l_2 \cos(q_{hip} + q_{knee})
+ * \f}
+ *
+ * Vectors of the legs are 2 x COUNT matrices with one column per leg: rows
+ * (hip, knee) in joint space and (x, z) in foot space.  All legs are computed
+ * with Eigen array operations.  With COUNT = Eigen::Dynamic all storage is
+ * allocated at construction, update(), set_foot_forces() and the getters do
+ * not allocate memory.
+ *
+ * Example:
+ * \code
+ * LegKinematics<4> kinematics(legs, parameters);
+ * while (...)
+ * {
+ *     kinematics.update();
+ *     LegKinematics<4>::LegVectors forces =
+ *         -stiffness * (kinematics.get_foot_positions() - desired_positions);
+ *     kinematics.set_foot_forces(forces);
+ *     kinematics.send_if_input_changed();
+ *     spinner.spin();
+ * }
+ * \endcode
+ *
+ * @tparam COUNT is the number of legs (may be Eigen::Dynamic).
+ */
+template <int COUNT>
+class LegKinematics
+{
+public:
+    /**
+     * @brief One 2d vector per leg, in joint space (hip, knee) or foot space
+     * (x, z).
+     */
+    typedef Eigen::Matrix<double, 2, COUNT> LegVectors;
+
+    /**
+     * @brief Container with one element per leg, a std::vector if COUNT is
+     * Eigen::Dynamic.
+     */
+    template <typename Type>
+    using Array = typename BlmcJointModules<COUNT>::template Array<Type>;
+
+    /**
+     * @brief The legs.
+     */
+    typedef Array<std::shared_ptr<LegInterface>> LegArray;
+
+    /**
+     * @brief Construct a new LegKinematics object
+     *
+     * @param legs whose motors are read and commanded.
+     * @param parameters of each leg.
+     * @throw std::invalid_argument if there is not one parameter set per leg
+     * or a gear ratio or motor constant is 0.
+     */
+    LegKinematics(const LegArray& legs,
+                  const Array<LegKinematicsParameters>& parameters);
+
+    /**
+     * @brief Get the number of legs.
+     */
+    size_t size() const
+    {
+        return legs_.size();
+    }
+
+    /**
+     * @brief Read the newest motor measurements of all legs and compute the
+     * foot positions, velocities and Jacobians.
+     *
+     * Legs without measurement yet get NaN.
+     */
+    void update();
+
+    /**
+     * @brief Compute the foot positions, velocities and Jacobians from joint
+     * states instead of the measurements.
+     *
+     * @param joint_angles (rad).
+     * @param joint_velocities (rad/s).
+     */
+    void update(const LegVectors& joint_angles,
+                const LegVectors& joint_velocities);
+
+    //! @brief Joint angles (rad) of the last update.
+    const LegVectors& get_joint_angles() const
+    {
+        return joint_angles_;
+    }
+
+    //! @brief Joint velocities (rad/s) of the last update.
+    const LegVectors& get_joint_velocities() const
+    {
+        return joint_velocities_;
+    }
+
+    //! @brief Foot positions (m) of the last update.
+    const LegVectors& get_foot_positions() const
+    {
+        return foot_positions_;
+    }
+
+    //! @brief Foot velocities (m/s) of the last update.
+    const LegVectors& get_foot_velocities() const
+    {
+        return foot_velocities_;
+    }
+
+    /**
+     * @brief Get the Jacobian of the foot position of a leg at the last
+     * update.
+     *
+     * @param leg_id ID of the leg (in range `[0, size())`).
+     * @return d(x, z) / d(hip, knee).
+     */
+    Eigen::Matrix2d get_jacobian(const size_t& leg_id) const
+    {
+        return Eigen::Map<const Eigen::Matrix2d>(jacobians_.col(leg_id).data());
+    }
+
+    /**
+     * @brief Map forces at the feet to joint torques (J^T f) at the last
+     * update.
+     *
+     * @param foot_forces (N) in foot space.
+     * @param joint_torques (Nm) is set to the torques.  It must not be
+     * foot_forces.
+     */
+    void get_joint_torques(const LegVectors& foot_forces,
+                           LegVectors& joint_torques) const;
+
+    /**
+     * @brief Register the motor currents which apply the given forces at the
+     * feet.  They are sent with send_if_input_changed().
+     *
+     * @param foot_forces (N) in foot space.
+     */
+    void set_foot_forces(const LegVectors& foot_forces);
+
+    /**
+     * @brief Register the motor currents which apply the given joint
+     * torques.  They are sent with send_if_input_changed().
+     *
+     * @param joint_torques (Nm).
+     */
+    void set_joint_torques(const LegVectors& joint_torques);
+
+    /**
+     * @brief Send the registered currents of all legs.
+     */
+    void send_if_input_changed();
+
+private:
+    typedef Eigen::Array<double, 1, COUNT> LegArrays;
+    typedef Eigen::Array<double, 2, COUNT> JointArrays;
+
+    /**
+     * @brief The legs.
+     */
+    LegArray legs_;
+
+    //! @brief Distance hip to knee of each leg (m).
+    LegArrays upper_leg_lengths_;
+    //! @brief Distance knee to foot of each leg (m).
+    LegArrays lower_leg_lengths_;
+    //! @brief Gear ratios of the hip and knee of each leg.
+    JointArrays gear_ratios_;
+    //! @brief Motor currents per joint torque of each leg (A/Nm).
+    JointArrays currents_per_torque_;
+    //! @brief Joint angles at motor position 0 of each leg (rad).
+    JointArrays zero_angles_;
+
+    LegVectors joint_angles_;
+    LegVectors joint_velocities_;
+    LegVectors foot_positions_;
+    LegVectors foot_velocities_;
+
+    /**
+     * @brief The Jacobian of each leg in column-major order, i.e.
+     * (dx/dhip, dz/dhip, dx/dknee, dz/dknee).
+     */
+    Eigen::Matrix<double, 4, COUNT> jacobians_;
+
+    /*
+     * Work buffers, allocated once so that updating does not allocate memory
+     * even if COUNT is Eigen::Dynamic.
+     */
+    LegVectors motor_positions_;   /**< newest motor positions */
+    LegVectors motor_velocities_;  /**< newest motor velocities */
+    LegVectors joint_torques_;     /**< torques of set_foot_forces() */
+    LegArrays sin_hip_;            /**< sin of the hip angles */
+    LegArrays cos_hip_;            /**< cos of the hip angles */
+    LegArrays sin_foot_;           /**< sin of hip + knee angles */
+    LegArrays cos_foot_;           /**< cos of hip + knee angles */
+};
+
+}  // namespace blmc_drivers
+
+#include "blmc_drivers/leg_kinematics.hxx"
@@ -0,0 +1,180 @@
+/**
+ * @file leg_kinematics.hxx
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, Max Planck Gesellschaft.
+ * @brief Implementation of the LegKinematics.
+ */
+
+#pragma once
+
+#include <limits>
+
+namespace blmc_drivers
+{
+template <int COUNT>
+LegKinematics<COUNT>::LegKinematics(
+    const LegArray& legs, const Array<LegKinematicsParameters>& parameters)
+    : legs_(legs)
+{
+    const Eigen::Index count = legs.size();
+    if (Eigen::Index(parameters.size()) != count)
+    {
+        throw std::invalid_argument(
+            "LegKinematics: need one parameter set per leg");
+    }
+
+    upper_leg_lengths_.resize(1, count);
+    lower_leg_lengths_.resize(1, count);
+    gear_ratios_.resize(2, count);
+    currents_per_torque_.resize(2, count);
+    zero_angles_.resize(2, count);
+    joint_angles_.resize(2, count);
+    joint_velocities_.resize(2, count);
+    foot_positions_.resize(2, count);
+    foot_velocities_.resize(2, count);
+    jacobians_.resize(4, count);
+    motor_positions_.resize(2, count);
+    motor_velocities_.resize(2, count);
+    joint_torques_.resize(2, count);
+    sin_hip_.resize(1, count);
+    cos_hip_.resize(1, count);
+    sin_foot_.resize(1, count);
+    cos_foot_.resize(1, count);
+
+    for (Eigen::Index i = 0; i < count; i++)
+    {
+        const LegKinematicsParameters& leg_parameters = parameters[i];
+        if ((leg_parameters.gear_ratios.array() == 0.0).any() ||
+            (leg_parameters.motor_constants.array() == 0.0).any())
+        {
+            throw std::invalid_argument(
+                "LegKinematics: gear ratios and motor constants must not be "
+                "0");
+        }
+        upper_leg_lengths_(i) = leg_parameters.upper_leg_length;
+        lower_leg_lengths_(i) = leg_parameters.lower_leg_length;
+        gear_ratios_.col(i) = leg_parameters.gear_ratios.array();
+        currents_per_torque_.col(i) =
+            1.0 / (leg_parameters.gear_ratios.array() *
+                   leg_parameters.motor_constants.array());
+        zero_angles_.col(i) = leg_parameters.zero_angles.array();
+    }
+
+    motor_positions_.setConstant(std::numeric_limits<double>::quiet_NaN());
+    motor_velocities_.setConstant(std::numeric_limits<double>::quiet_NaN());
+    update(motor_positions_, motor_velocities_);
+}
+
+template <int COUNT>
+void LegKinematics<COUNT>::update()
+{
+    for (size_t i = 0; i < size(); i++)
+    {
+        for (int joint = 0; joint < LegInterface::motor_count; joint++)
+        {
+            auto positions =
+                legs_[i]->get_motor_measurement(joint, LegInterface::position);
+            auto velocities =
+                legs_[i]->get_motor_measurement(joint, LegInterface::velocity);
+            motor_positions_(joint, i) =
+                positions->length() > 0
+                    ? positions->newest_element()
+                    : std::numeric_limits<double>::quiet_NaN();
+            motor_velocities_(joint, i) =
+                velocities->length() > 0
+                    ? velocities->newest_element()
+                    : std::numeric_limits<double>::quiet_NaN();
+        }
+    }
+
+    joint_velocities_ = (motor_velocities_.array() / gear_ratios_).matrix();
+    joint_angles_ =
+        (motor_positions_.array() / gear_ratios_ - zero_angles_).matrix();
+    update(joint_angles_, joint_velocities_);
+}
+
+template <int COUNT>
+void LegKinematics<COUNT>::update(const LegVectors& joint_angles,
+                                  const LegVectors& joint_velocities)
+{
+    // copying onto itself is fine, update() passes the members.
+    joint_angles_ = joint_angles;
+    joint_velocities_ = joint_velocities;
+
+    auto hip_angles = joint_angles_.row(0).array();
+    auto foot_angles = hip_angles + joint_angles_.row(1).array();
+    sin_hip_ = hip_angles.sin();
+    cos_hip_ = hip_angles.cos();
+    sin_foot_ = foot_angles.sin();
+    cos_foot_ = foot_angles.cos();
+
+    foot_positions_.row(0) =
+        -(upper_leg_lengths_ * sin_hip_ + lower_leg_lengths_ * sin_foot_)
+             .matrix();
+    foot_positions_.row(1) =
+        -(upper_leg_lengths_ * cos_hip_ + lower_leg_lengths_ * cos_foot_)
+             .matrix();
+
+    // dx/dhip = z and dz/dhip = -x, the knee only moves the lower leg.
+    jacobians_.row(0) = foot_positions_.row(1);
+    jacobians_.row(1) = -foot_positions_.row(0);
+    jacobians_.row(2) = -(lower_leg_lengths_ * cos_foot_).matrix();
+    jacobians_.row(3) = (lower_leg_lengths_ * sin_foot_).matrix();
+
+    auto hip_velocities = joint_velocities_.row(0).array();
+    auto knee_velocities = joint_velocities_.row(1).array();
+    foot_velocities_.row(0) =
+        (jacobians_.row(0).array() * hip_velocities +
+         jacobians_.row(2).array() * knee_velocities)
+            .matrix();
+    foot_velocities_.row(1) =
+        (jacobians_.row(1).array() * hip_velocities +
+         jacobians_.row(3).array() * knee_velocities)
+            .matrix();
+}
+
+template <int COUNT>
+void LegKinematics<COUNT>::get_joint_torques(const LegVectors& foot_forces,
+                                             LegVectors& joint_torques) const
+{
+    auto forces_x = foot_forces.row(0).array();
+    auto forces_z = foot_forces.row(1).array();
+    joint_torques.row(0) = (jacobians_.row(0).array() * forces_x +
+                            jacobians_.row(1).array() * forces_z)
+                               .matrix();
+    joint_torques.row(1) = (jacobians_.row(2).array() * forces_x +
+                            jacobians_.row(3).array() * forces_z)
+                               .matrix();
+}
+
+template <int COUNT>
+void LegKinematics<COUNT>::set_foot_forces(const LegVectors& foot_forces)
+{
+    get_joint_torques(foot_forces, joint_torques_);
+    set_joint_torques(joint_torques_);
+}
+
+template <int COUNT>
+void LegKinematics<COUNT>::set_joint_torques(const LegVectors& joint_torques)
+{
+    for (size_t i = 0; i < size(); i++)
+    {
+        for (int joint = 0; joint < LegInterface::motor_count; joint++)
+        {
+            legs_[i]->set_current_target(
+                joint_torques(joint, i) * currents_per_torque_(joint, i),
+                joint);
+        }
+    }
+}
+
+template <int COUNT>
+void LegKinematics<COUNT>::send_if_input_changed()
+{
+    for (size_t i = 0; i < size(); i++)
+    {
+        legs_[i]->send_if_input_changed();
+    }
+}
+
+}  // namespace blmc_drivers
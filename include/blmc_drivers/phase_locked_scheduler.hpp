@@ -0,0 +1,316 @@
+/**
+ * @file phase_locked_scheduler.hpp
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, Max Planck Gesellschaft.
+ * @brief Triggers the control loop at a fixed offset after the boards sent
+ * their measurements.
+ */
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <time_series/time_series.hpp>
+
+#include "blmc_drivers/devices/motor_board.hpp"
+#include "blmc_drivers/utils/hybrid_spinner.hpp"
+#include "blmc_drivers/utils/latency_histogram.hpp"
+
+namespace blmc_drivers
+{
+/**
+ * @brief Replaces the spinner of a control loop by a schedule locked to the
+ * measurements of the boards.
+ *
+ * The boards sample their sensors at their own rate.  With a free-running
+ * spinner the time from the sampling to the sending of the resulting control
+ * varies between 0 and 2 periods.  The scheduler instead tracks the arrival
+ * of the measurements (by default the POS frames) of each board and wakes
+ * the loop a configurable offset after fresh data arrived, so the feedback
+ * delay is minimal and constant.
+ *
+ * From the arrival times of the previous frames, the scheduler predicts the
+ * next one, sleeps until shortly before it and busy-waits for the frame, so
+ * the wake-up latency of the scheduler is avoided.  If the frame is later
+ * than predicted, it falls back to a blocking wait.  With several boards,
+ * the loop waits for fresh data of all of them and the offset is counted from
+ * the last arrival.
+ *
+ * The achieved loop delay, from the arrival of the oldest data used to
+ * notify_sent(), is recorded in a LatencyHistogram.
+ *
+ * Example:
+ * \code
+ * PhaseLockedScheduler scheduler({board}, 100e-6);
+ * while (scheduler.tick([&]() {
+ *     joints.set_torques(controller.compute(joints.get_measured_angles()));
+ *     joints.send_torques();
+ * }))
+ * {
+ * }
+ * scheduler.print_statistics();
+ * \endcode
+ *
+ * The time series must be appended to in real time, i.e. their timestamps
+ * are the arrival times of the frames.  Not thread-safe, use it in the
+ * control loop.  Waiting does not allocate memory.
+ */
+class PhaseLockedScheduler
+{
+public:
+    typedef time_series::TimeSeries<double> ScalarTimeseries;
+    typedef time_series::Index Index;
+
+    /**
+     * @brief Default time spent busy-waiting for the predicted frame and
+     * before the deadline.
+     */
+    static constexpr double DEFAULT_BUSY_WAIT_S =
+        HybridSpinner::DEFAULT_BUSY_WAIT_S;
+
+    /**
+     * @brief Time after which wait_for_fresh_data() gives up if a board does
+     * not send data.
+     */
+    static constexpr double DATA_TIMEOUT_S = 0.1;
+
+    /**
+     * @brief Time between two polls of a time series while busy-waiting for
+     * the predicted frame.  Each poll takes the mutex of the series, which
+     * the thread of the board needs to append the frame.
+     */
+    static constexpr double POLL_INTERVAL_S = 2e-6;
+
+    /**
+     * @brief Number of frames over which the period of a board is averaged.
+     */
+    static constexpr Index PERIOD_WINDOW = 16;
+
+    /**
+     * @brief Construct a new PhaseLockedScheduler object.
+     *
+     * @param references are the measurements whose arrival is tracked, one
+     * per board.
+     * @param offset_s is the time between the arrival of fresh data and the
+     * return of wait_for_fresh_data().
+     * @param busy_wait_s is the time to busy-wait around the predicted
+     * arrival and before the deadline.
+     */
+    PhaseLockedScheduler(
+        const std::vector<std::shared_ptr<const ScalarTimeseries>>& references,
+        const double& offset_s,
+        const double& busy_wait_s = DEFAULT_BUSY_WAIT_S);
+
+    /**
+     * @brief Construct a new PhaseLockedScheduler object tracking the given
+     * measurement of each board.
+     *
+     * @param boards to lock to.
+     * @param offset_s see above.
+     * @param busy_wait_s see above.
+     * @param measurement_index is the MotorBoardInterface::MeasurementIndex
+     * to track.
+     */
+    PhaseLockedScheduler(
+        const std::vector<std::shared_ptr<MotorBoardInterface>>& boards,
+        const double& offset_s,
+        const double& busy_wait_s = DEFAULT_BUSY_WAIT_S,
+        const int& measurement_index = MotorBoardInterface::position_0);
+
+    PhaseLockedScheduler(const PhaseLockedScheduler&) = delete;
+    PhaseLockedScheduler& operator=(const PhaseLockedScheduler&) = delete;
+
+    /**
+     * @brief Set the time between the arrival of fresh data and the trigger.
+     */
+    void set_offset(const double& offset_s)
+    {
+        offset_s_ = offset_s;
+    }
+
+    /**
+     * @brief Get the time between the arrival of fresh data and the trigger.
+     */
+    double get_offset() const
+    {
+        return offset_s_;
+    }
+
+    /**
+     * @brief Wait until the offset has passed after all boards sent data
+     * that was not used by a previous tick yet.
+     *
+     * @return false if a board did not send data within DATA_TIMEOUT_S.
+     */
+    bool wait_for_fresh_data();
+
+    /**
+     * @brief Tell that the controls were sent, records the loop delay.
+     */
+    void notify_sent();
+
+    /**
+     * @brief Wait for fresh data, run the control (which sends the controls)
+     * and record the loop delay.
+     *
+     * @param control is called without arguments.
+     * @return false if a board did not send data, the control is not run
+     * then.
+     */
+    template <typename Control>
+    bool tick(Control control)
+    {
+        if (!wait_for_fresh_data())
+        {
+            return false;
+        }
+        control();
+        notify_sent();
+        return true;
+    }
+
+    /**
+     * @brief Get the arrival time (s) of the oldest data used by the current
+     * tick.
+     */
+    double get_data_time() const
+    {
+        return data_time_s_;
+    }
+
+    /**
+     * @brief Get the number of calls to wait_for_fresh_data().
+     */
+    uint64_t get_tick_count() const
+    {
+        return tick_count_;
+    }
+
+    /**
+     * @brief Get the number of ticks for which fresh data was already
+     * waiting, i.e. the previous tick took longer than the period of the
+     * boards.
+     */
+    uint64_t get_overrun_count() const
+    {
+        return overrun_count_;
+    }
+
+    /**
+     * @brief Get the number of frames which were not used by a tick.
+     */
+    uint64_t get_skipped_frame_count() const
+    {
+        return skipped_frame_count_;
+    }
+
+    /**
+     * @brief Get the number of frames which arrived too late for the
+     * busy-wait and needed a blocking wait.
+     */
+    uint64_t get_unpredicted_frame_count() const
+    {
+        return unpredicted_frame_count_;
+    }
+
+    /**
+     * @brief Get the times from the arrival of the oldest data used to
+     * notify_sent().
+     */
+    const LatencyHistogram& get_loop_delays() const
+    {
+        return loop_delays_;
+    }
+
+    /**
+     * @brief Get the differences between predicted and actual arrival of the
+     * frames.
+     */
+    const LatencyHistogram& get_phase_errors() const
+    {
+        return phase_errors_;
+    }
+
+    /**
+     * @brief Forget the counters and statistics.
+     */
+    void reset_statistics();
+
+    /**
+     * @brief Print the counters and delay statistics.
+     */
+    void print_statistics() const;
+
+private:
+    /**
+     * @brief A tracked measurement.
+     */
+    struct Reference
+    {
+        std::shared_ptr<const ScalarTimeseries> series;
+        //! @brief Index used by the last tick, -1 if none.
+        Index last_index;
+    };
+
+    /**
+     * @brief Wait for a frame of the reference newer than its last index.
+     *
+     * @param reference
+     * @param arrival_s is set to the arrival time of the newest frame.
+     * @param was_waiting is set to true if the frame had arrived before the
+     * call.
+     * @return false on timeout.
+     */
+    bool wait_for_reference(Reference& reference,
+                            double& arrival_s,
+                            bool& was_waiting);
+
+    /**
+     * @brief Get the mean period (s) of the newest frames of a time series,
+     * NaN if there are less than two.
+     */
+    static double estimate_period(const ScalarTimeseries& series);
+
+    /**
+     * @brief Wait until the given time of the clock of the time series.
+     */
+    static void wait_until(const double& time_s, const int64_t& busy_wait_ns);
+
+    /**
+     * @brief The tracked measurements.
+     */
+    std::vector<Reference> references_;
+
+    /**
+     * @brief Time between the arrival of fresh data and the trigger (s).
+     */
+    double offset_s_;
+
+    /**
+     * @brief Time to busy-wait (s).
+     */
+    double busy_wait_s_;
+
+    /**
+     * @brief Arrival time of the oldest data used by the current tick (s).
+     */
+    double data_time_s_;
+
+    uint64_t tick_count_;
+    uint64_t overrun_count_;
+    uint64_t skipped_frame_count_;
+    uint64_t unpredicted_frame_count_;
+
+    /**
+     * @brief Times from the arrival of the oldest data to notify_sent().
+     */
+    LatencyHistogram loop_delays_;
+
+    /**
+     * @brief Differences between predicted and actual arrival.
+     */
+    LatencyHistogram phase_errors_;
+};
+
+}  // namespace blmc_drivers
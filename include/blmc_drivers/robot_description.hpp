@@ -0,0 +1,158 @@
+/**
+ * @file robot_description.hpp
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, Max Planck Gesellschaft.
+ * @brief Description of the buses, boards, joints and sensors of a robot,
+ * loaded from a file (see doc/robot_description.md).
+ */
+#pragma once
+
+#include <istream>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace blmc_drivers
+{
+/**
+ * @brief A CAN bus of the robot.
+ */
+struct CanBusDescription
+{
+    //! @brief Name used to refer to the bus, e.g. "front".
+    std::string name;
+    //! @brief Network interface, e.g. "can0", or "loopback" for a
+    //! LoopbackCanBus simulating the board.
+    std::string interface;
+    //! @brief CPU of the receiving thread (-1 for any).
+    int cpu_id = -1;
+    //! @brief Priority of the receiving thread (-1 for the default).
+    int priority = -1;
+    //! @brief Configured bitrate (bit/s).
+    double bitrate = 1e6;
+    //! @brief Number of frames kept in the history.
+    size_t history_length = 1000;
+};
+
+/**
+ * @brief A motor board of the robot.
+ */
+struct MotorBoardDescription
+{
+    //! @brief Name used to refer to the board.
+    std::string name;
+    //! @brief Name of the bus of the board (only one board per bus).
+    std::string bus;
+    //! @brief CPU of the thread of the board (-1 for any).
+    int cpu_id = -1;
+    //! @brief Priority of the thread of the board (-1 for the default).
+    int priority = -1;
+    //! @brief See CanBusMotorBoard.
+    int control_timeout_ms = 100;
+    //! @brief Number of measurements kept in the history.
+    size_t history_length = 1000;
+    //! @brief Export the state of the board with a MotorBoardStatePublisher
+    //! under this name (empty for none).
+    std::string publish;
+    //! @brief Serve the board to other processes with a MotorBoardServer
+    //! under this name (empty for none).
+    std::string serve;
+};
+
+/**
+ * @brief A joint of the robot, i.e. a motor slot of a board.
+ */
+struct JointDescription
+{
+    //! @brief Name of the joint.
+    std::string name;
+    //! @brief Name of the board of the motor.
+    std::string board;
+    //! @brief Slot of the motor on the board (0 or 1).
+    int motor_index = 0;
+    //! @brief Torque constant of the motor (Nm/A).
+    double motor_constant = 0.025;
+    //! @brief Reduction between motor and joint.
+    double gear_ratio = 1.0;
+    //! @brief Angle between the closest positive index and the zero
+    //! configuration (rad).
+    double zero_angle = 0.0;
+    //! @brief Reverse the rotation axis.
+    bool reverse_polarity = false;
+    //! @brief Max. current (A).
+    double max_current = 2.0;
+    //! @brief Max. motor velocity, NaN for none (see SafeMotor).
+    double max_velocity = std::numeric_limits<double>::quiet_NaN();
+    //! @brief Continuous current (A) of the thermal limit, which allows
+    //! max_current as peak, 0 for no thermal limit (see ThermalLimiter).
+    double continuous_current = 0.0;
+    //! @brief Time constant of the winding (s) for the thermal limit.
+    double winding_time_constant_s = 20.0;
+    //! @brief Time constant of the housing (s) for the thermal limit, 0 to
+    //! model the winding only.
+    double housing_time_constant_s = 0.0;
+    //! @brief Part of the temperature rise across the winding for the
+    //! thermal limit.
+    double winding_fraction = 1.0;
+    //! @brief Number of current targets kept in the history.
+    size_t history_length = 1000;
+};
+
+/**
+ * @brief An analog sensor (e.g. a slider) connected to a board.
+ */
+struct AnalogSensorDescription
+{
+    //! @brief Name of the sensor.
+    std::string name;
+    //! @brief Name of the board of the sensor.
+    std::string board;
+    //! @brief Port of the sensor on the board (0 or 1).
+    int sensor_index = 0;
+};
+
+/**
+ * @brief Everything needed to instantiate the drivers of a robot, see
+ * BlmcRobot.
+ */
+struct RobotDescription
+{
+    //! @brief The buses.
+    std::vector<CanBusDescription> buses;
+    //! @brief The boards.
+    std::vector<MotorBoardDescription> boards;
+    //! @brief The joints, in the order of the joint vectors.
+    std::vector<JointDescription> joints;
+    //! @brief The analog sensors.
+    std::vector<AnalogSensorDescription> analog_sensors;
+};
+
+/**
+ * @brief Parse a robot description.
+ *
+ * The format is made of sections `[robot]`, `[bus <name>]`,
+ * `[board <name>]`, `[joint <name>]` and `[sensor <name>]` with one
+ * `key = value` per line, `#` starts a comment.  The keys are the members of
+ * the corresponding description (e.g. `motor_constant`), see
+ * doc/robot_description.md.
+ *
+ * @param stream to read from.
+ * @param source is the name of the stream used in error messages.
+ * @return RobotDescription
+ * @throw std::runtime_error on syntax errors, unknown keys, duplicate names
+ * or references to unknown buses or boards.
+ */
+RobotDescription parse_robot_description(std::istream& stream,
+                                         const std::string& source = "");
+
+/**
+ * @brief Load a robot description from a file, see
+ * parse_robot_description().
+ *
+ * @param path of the file.
+ * @return RobotDescription
+ * @throw std::runtime_error if the file can not be read or is invalid.
+ */
+RobotDescription load_robot_description(const std::string& path);
+
+}  // namespace blmc_drivers
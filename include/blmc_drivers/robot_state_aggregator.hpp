@@ -0,0 +1,189 @@
+/**
+ * @file robot_state_aggregator.hpp
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, Max Planck Gesellschaft.
+ * @brief Joint state of a whole robot, collected over all buses with the
+ * skew between the joints and optionally aligned to a common instant.
+ */
+#pragma once
+
+#include <array>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include <Eigen/Eigen>
+
+#include "blmc_drivers/blmc_joint_module.hpp"
+#include "blmc_drivers/utils/latency_histogram.hpp"
+
+namespace blmc_drivers
+{
+/**
+ * @brief State of all joints of a robot.
+ */
+struct RobotState
+{
+    //! @brief Joint angles (rad).
+    Eigen::VectorXd positions;
+    //! @brief Joint velocities (rad/s).
+    Eigen::VectorXd velocities;
+    //! @brief Joint torques (Nm).
+    Eigen::VectorXd torques;
+    //! @brief Time (s) at which the position of each joint was received, or
+    //! time_s if aligned.
+    Eigen::VectorXd timestamps_s;
+    //! @brief Time (s) the state refers to: the newest reception time over
+    //! all joints, or the time the state was aligned to.
+    double time_s = std::numeric_limits<double>::quiet_NaN();
+    //! @brief Difference (s) between the newest and the oldest reception time
+    //! of the positions used, i.e. how far apart the joints were sampled.
+    double skew_s = std::numeric_limits<double>::quiet_NaN();
+    //! @brief True if all joints were interpolated to time_s.
+    bool is_aligned = false;
+};
+
+/**
+ * @brief Collects the newest measurements of all joints of a robot, which
+ * may be spread over several buses, into one RobotState.
+ *
+ * The boards of the different buses are not synchronized, so the newest
+ * values of two joints can be up to a board cycle apart.  update() reports
+ * this skew along with the state, update_aligned() interpolates (or
+ * extrapolates, by at most one cycle) each measurement linearly between its
+ * two newest samples to a common instant.  The reception times of the
+ * measurements are used as their sampling times, so the alignment removes
+ * the skew between the boards but not the (common) transmission delay.
+ *
+ * All storage is allocated at construction, updating does not allocate
+ * memory.  Not thread-safe, use it in the control loop.
+ */
+class RobotStateAggregator
+{
+public:
+    /**
+     * @brief Construct a new RobotStateAggregator object.
+     *
+     * @param joints in the order of the state vectors.
+     */
+    explicit RobotStateAggregator(
+        const std::vector<std::shared_ptr<BlmcJointModule>>& joints);
+
+    /**
+     * @brief Construct a new RobotStateAggregator object for the joints of
+     * the given modules.
+     */
+    template <int COUNT>
+    explicit RobotStateAggregator(const BlmcJointModules<COUNT>& joints)
+        : RobotStateAggregator(get_modules(joints))
+    {
+    }
+
+    /**
+     * @brief Collect the newest measurement of every joint.
+     */
+    void update();
+
+    /**
+     * @brief Collect the newest measurements of every joint and interpolate
+     * them to a common instant.
+     *
+     * @param time_s (s) to align to, by default the newest reception time
+     * over all joints.  Measurements are extrapolated by at most the time
+     * between their two newest samples, beyond that the newest value is
+     * used.
+     */
+    void update_aligned(
+        double time_s = std::numeric_limits<double>::quiet_NaN());
+
+    /**
+     * @brief Get the state of the last update.  Joints without measurement
+     * are NaN.
+     */
+    const RobotState& get_state() const
+    {
+        return state_;
+    }
+
+    /**
+     * @brief Get the distribution of the skew over all updates.
+     */
+    const LatencyHistogram& get_skews() const
+    {
+        return skews_;
+    }
+
+    /**
+     * @brief Get the number of joints.
+     */
+    size_t size() const
+    {
+        return joints_.size();
+    }
+
+private:
+    /**
+     * @brief The two newest samples of a measurement.
+     */
+    struct Samples
+    {
+        double value;
+        double timestamp_s;
+        double previous_value;
+        double previous_timestamp_s;
+    };
+
+    /**
+     * @brief The measurements making up the state.
+     */
+    static constexpr std::array<mi, 3> MEASUREMENTS = {
+        {mi::position, mi::velocity, mi::current}};
+
+    /**
+     * @brief Get the modules of all joints.
+     */
+    template <int COUNT>
+    static std::vector<std::shared_ptr<BlmcJointModule>> get_modules(
+        const BlmcJointModules<COUNT>& joints)
+    {
+        std::vector<std::shared_ptr<BlmcJointModule>> modules;
+        for (size_t i = 0; i < joints.size(); i++)
+        {
+            modules.push_back(joints.get_module(i));
+        }
+        return modules;
+    }
+
+    /**
+     * @brief Read the two newest samples of all measurements of all joints.
+     */
+    void collect_samples();
+
+    /**
+     * @brief Fill the state with the newest samples and compute the skew.
+     */
+    void set_newest_state();
+
+    /**
+     * @brief The joints.
+     */
+    std::vector<std::shared_ptr<BlmcJointModule>> joints_;
+
+    /**
+     * @brief Samples of each measurement (index in MEASUREMENTS) of each
+     * joint.
+     */
+    std::vector<std::array<Samples, MEASUREMENTS.size()>> samples_;
+
+    /**
+     * @brief The state of the last update.
+     */
+    RobotState state_;
+
+    /**
+     * @brief Skew of all updates.
+     */
+    LatencyHistogram skews_;
+};
+
+}  // namespace blmc_drivers
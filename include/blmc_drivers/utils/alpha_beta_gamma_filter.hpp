@@ -0,0 +1,147 @@
+/**
+ * @file alpha_beta_gamma_filter.hpp
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, Max Planck Gesellschaft.
+ * @brief Position, velocity and acceleration estimation from timestamped
+ * position samples.
+ */
+#pragma once
+
+#include <Eigen/Eigen>
+
+namespace blmc_drivers
+{
+/**
+ * @brief Alpha-beta-gamma filter estimating position, velocity and
+ * acceleration of SIZE independent channels (e.g. the joints of a robot) at
+ * once.
+ *
+ * Each call of update() incorporates at most one position sample per
+ * channel.  Samples do not need to be equally spaced, the time since the last
+ * sample of the channel is used for the prediction.  The state can be
+ * extrapolated to any instant with predict(), e.g. to compensate the delay
+ * between the sampling on the board and the control tick.
+ *
+ * @tparam SIZE is the number of channels (may be Eigen::Dynamic).
+ */
+template <int SIZE>
+class AlphaBetaGammaFilter
+{
+public:
+    /**
+     * @brief Vector type used for the interface.
+     */
+    typedef Eigen::Matrix<double, SIZE, 1> Vector;
+
+    /**
+     * @brief Construct a new AlphaBetaGammaFilter object
+     *
+     * Uses the gains of set_smoothing(0.8).
+     *
+     * @param size is the number of channels.  Only needed if SIZE is
+     * Eigen::Dynamic.
+     */
+    AlphaBetaGammaFilter(const Eigen::Index& size = SIZE > 0 ? SIZE : 0);
+
+    /**
+     * @brief Set the gains of the filter.
+     *
+     * With r being the difference between the measured and the predicted
+     * position and dt the time since the last sample of the channel, the
+     * correction is
+     * \f{eqnarray*}{
+     * x &+=& \alpha r \\
+     * \dot{x} &+=& \beta r / dt \\
+     * \ddot{x} &+=& 2 \gamma r / dt^2
+     * \f}
+     */
+    void set_gains(const Vector& alpha, const Vector& beta, const Vector& gamma);
+
+    /**
+     * @brief Set the gains of a critically damped ("fading memory") filter.
+     *
+     * @param theta in [0, 1) is the smoothing factor, the same for all
+     * channels.  0 trusts every new sample completely, values close to 1
+     * give smooth but lagging estimates.
+     */
+    void set_smoothing(const double& theta);
+
+    /**
+     * @brief Incorporate one position sample per channel.
+     *
+     * @param sample_times is the time (s) at which the positions were
+     * sampled.  Channels with a NaN time or with a time not greater than the
+     * one of their last sample are not updated.
+     * @param positions is the measured positions.
+     */
+    void update(const Vector& sample_times, const Vector& positions);
+
+    /**
+     * @brief Extrapolate the state of all channels to the given time.
+     *
+     * Channels which never got a sample are NaN.
+     *
+     * @param time (s) to which the state is extrapolated.
+     * @param[out] positions
+     * @param[out] velocities
+     * @param[out] accelerations
+     */
+    void predict(const double& time,
+                 Vector& positions,
+                 Vector& velocities,
+                 Vector& accelerations) const;
+
+    /**
+     * @brief Forget all samples.
+     */
+    void reset();
+
+    /**
+     * @brief Get the number of channels.
+     */
+    Eigen::Index size() const
+    {
+        return position_.size();
+    }
+
+private:
+    /**
+     * @brief Internal vectorized type.
+     */
+    typedef Eigen::Array<double, SIZE, 1> Array;
+    /**
+     * @brief Internal mask type.
+     */
+    typedef Eigen::Array<bool, SIZE, 1> Mask;
+
+    //! @brief Gains of the position correction.
+    Array alpha_;
+    //! @brief Gains of the velocity correction.
+    Array beta_;
+    //! @brief Gains of the acceleration correction.
+    Array gamma_;
+
+    //! @brief Time of the last sample of each channel (NaN if none).
+    Array time_;
+    //! @brief Estimated position at time_.
+    Array position_;
+    //! @brief Estimated velocity at time_.
+    Array velocity_;
+    //! @brief Estimated acceleration at time_.
+    Array acceleration_;
+
+    /*
+     * Work buffers of update(), allocated once so that updating does not
+     * allocate memory even if SIZE is Eigen::Dynamic.
+     */
+    Array dt_;                  /**< time since the last sample */
+    Array predicted_position_;  /**< position predicted to the sample time */
+    Array predicted_velocity_;  /**< velocity predicted to the sample time */
+    Array residual_;            /**< measured minus predicted position */
+    Mask is_first_;             /**< channels getting their first sample */
+    Mask is_new_;               /**< channels getting a new sample */
+};
+
+}  // namespace blmc_drivers
+
+#include "blmc_drivers/utils/alpha_beta_gamma_filter.hxx"
@@ -0,0 +1,107 @@
+/**
+ * @file alpha_beta_gamma_filter.hxx
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, Max Planck Gesellschaft.
+ * @brief Implementation of the AlphaBetaGammaFilter.
+ */
+
+#pragma once
+
+#include <cmath>
+#include <limits>
+
+namespace blmc_drivers
+{
+template <int SIZE>
+AlphaBetaGammaFilter<SIZE>::AlphaBetaGammaFilter(const Eigen::Index& size)
+{
+    alpha_.resize(size);
+    beta_.resize(size);
+    gamma_.resize(size);
+    time_.resize(size);
+    position_.resize(size);
+    velocity_.resize(size);
+    acceleration_.resize(size);
+    dt_.resize(size);
+    predicted_position_.resize(size);
+    predicted_velocity_.resize(size);
+    residual_.resize(size);
+    is_first_.resize(size);
+    is_new_.resize(size);
+
+    set_smoothing(0.8);
+    reset();
+}
+
+template <int SIZE>
+void AlphaBetaGammaFilter<SIZE>::set_gains(const Vector& alpha,
+                                           const Vector& beta,
+                                           const Vector& gamma)
+{
+    alpha_ = alpha.array();
+    beta_ = beta.array();
+    gamma_ = gamma.array();
+}
+
+template <int SIZE>
+void AlphaBetaGammaFilter<SIZE>::set_smoothing(const double& theta)
+{
+    double one_minus_theta = 1.0 - theta;
+    alpha_.setConstant(1.0 - theta * theta * theta);
+    beta_.setConstant(1.5 * (1.0 - theta * theta) * one_minus_theta);
+    gamma_.setConstant(0.5 * one_minus_theta * one_minus_theta *
+                       one_minus_theta);
+}
+
+template <int SIZE>
+void AlphaBetaGammaFilter<SIZE>::update(const Vector& sample_times,
+                                        const Vector& positions)
+{
+    // channels which get their very first sample
+    is_first_ = time_.isNaN() && !sample_times.array().isNaN();
+    // channels which get a new sample (comparisons with NaN are false)
+    is_new_ = sample_times.array() > time_;
+
+    dt_ = is_new_.select(sample_times.array() - time_, 1.0);
+
+    // predict to the sample time
+    predicted_position_ =
+        position_ + velocity_ * dt_ + 0.5 * acceleration_ * dt_.square();
+    predicted_velocity_ = velocity_ + acceleration_ * dt_;
+    residual_ = positions.array() - predicted_position_;
+
+    // correct
+    position_ = is_new_.select(predicted_position_ + alpha_ * residual_,
+                               is_first_.select(positions.array(), position_));
+    velocity_ = is_new_.select(predicted_velocity_ + beta_ * residual_ / dt_,
+                               is_first_.select(0.0, velocity_));
+    acceleration_ = is_new_.select(
+        acceleration_ + 2.0 * gamma_ * residual_ / dt_.square(),
+        is_first_.select(0.0, acceleration_));
+    time_ = (is_new_ || is_first_).select(sample_times.array(), time_);
+}
+
+template <int SIZE>
+void AlphaBetaGammaFilter<SIZE>::predict(const double& time,
+                                         Vector& positions,
+                                         Vector& velocities,
+                                         Vector& accelerations) const
+{
+    // NaN for channels without sample, as time_ is NaN there.
+    positions = (position_ + velocity_ * (time - time_) +
+                 0.5 * acceleration_ * (time - time_).square())
+                    .matrix();
+    velocities = (velocity_ + acceleration_ * (time - time_)).matrix();
+    accelerations = (acceleration_ + 0.0 * (time - time_)).matrix();
+}
+
+template <int SIZE>
+void AlphaBetaGammaFilter<SIZE>::reset()
+{
+    time_.setConstant(std::numeric_limits<double>::quiet_NaN());
+    position_.setZero();
+    velocity_.setZero();
+    acceleration_.setZero();
+}
+
+}  // namespace blmc_drivers
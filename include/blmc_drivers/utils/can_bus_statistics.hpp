@@ -0,0 +1,300 @@
+/**
+ * @file can_bus_statistics.hpp
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, Max Planck Gesellschaft.
+ * @brief Lock-free traffic statistics of a CAN bus.
+ */
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "blmc_drivers/utils/latency_histogram.hpp"
+
+namespace blmc_drivers
+{
+/**
+ * @brief Traffic statistics of one CAN id, see CanBusStatistics.
+ */
+class CanIdStatistics
+{
+public:
+    /**
+     * @brief Get the CAN id.
+     */
+    uint32_t get_id() const
+    {
+        return id_.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Get the number of received frames with this id.
+     */
+    uint64_t get_received_frames() const
+    {
+        return received_frames_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Get the number of sent frames with this id.
+     */
+    uint64_t get_sent_frames() const
+    {
+        return sent_frames_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Get the distribution of the time between two received frames
+     * with this id.
+     */
+    const LatencyHistogram& get_inter_arrival_times() const
+    {
+        return inter_arrival_times_;
+    }
+
+private:
+    friend class CanBusStatistics;
+
+    //! @brief The id, CanBusStatistics::NO_ID as long as the slot is free.
+    std::atomic<uint32_t> id_;
+    //! @brief Number of received frames.
+    std::atomic<uint64_t> received_frames_;
+    //! @brief Number of sent frames.
+    std::atomic<uint64_t> sent_frames_;
+    //! @brief Time (s) of the last received frame (NaN if none).
+    std::atomic<double> last_receive_time_s_;
+    //! @brief Time between two received frames.
+    LatencyHistogram inter_arrival_times_;
+};
+
+/**
+ * @brief Counts the traffic of a CAN bus, to see how loaded it is.
+ *
+ * All counters are atomic, recording is wait-free and the getters can be
+ * called from any thread at any time.  Frames are counted per id for the
+ * first MAX_TRACKED_IDS ids seen, the frames of further ids are only counted
+ * in the totals (see get_untracked_frames()).
+ *
+ * The bus load is estimated from the length of the frames on the wire
+ * including the worst-case bit stuffing, so it is a slightly pessimistic
+ * estimate.  Only the frames seen by this process are counted, i.e. the own
+ * sent frames and all received ones.
+ */
+class CanBusStatistics
+{
+public:
+    /**
+     * @brief Number of ids for which separate statistics are kept.
+     */
+    static constexpr size_t MAX_TRACKED_IDS = 32;
+
+    /**
+     * @brief Value of a free id slot.
+     */
+    static constexpr uint32_t NO_ID = 0xFFFFFFFF;
+
+    /**
+     * @brief Construct a new CanBusStatistics object
+     *
+     * @param bitrate is the configured bitrate of the bus (bit/s).
+     */
+    explicit CanBusStatistics(const double& bitrate = 1e6);
+
+    CanBusStatistics(const CanBusStatistics&) = delete;
+    CanBusStatistics& operator=(const CanBusStatistics&) = delete;
+
+    /**
+     * @brief Count a received frame.
+     *
+     * @param id is the CAN id (with the CAN_EFF_FLAG for extended ids).
+     * @param dlc is the number of data bytes.
+     * @param time_s is the time (s) of the reception.
+     */
+    void record_received(const uint32_t& id,
+                         const uint8_t& dlc,
+                         const double& time_s);
+
+    /**
+     * @brief Count a sent frame.
+     *
+     * @param id is the CAN id (with the CAN_EFF_FLAG for extended ids).
+     * @param dlc is the number of data bytes.
+     * @param retries is the number of failed attempts to send it.
+     */
+    void record_sent(const uint32_t& id,
+                     const uint8_t& dlc,
+                     const size_t& retries);
+
+    /**
+     * @brief Count a frame which could not be sent.
+     */
+    void record_send_failure();
+
+    /**
+     * @brief Set the number of frames dropped by the receive queue of the
+     * socket so far (as reported by SO_RXQ_OVFL).
+     *
+     * @param dropped_frames
+     */
+    void set_receive_overflows(const uint32_t& dropped_frames);
+
+    /**
+     * Getters
+     */
+
+    uint64_t get_received_frames() const
+    {
+        return received_frames_.load(std::memory_order_relaxed);
+    }
+
+    uint64_t get_sent_frames() const
+    {
+        return sent_frames_.load(std::memory_order_relaxed);
+    }
+
+    uint64_t get_received_bytes() const
+    {
+        return received_bytes_.load(std::memory_order_relaxed);
+    }
+
+    uint64_t get_sent_bytes() const
+    {
+        return sent_bytes_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Get the number of bits of all frames on the wire.
+     */
+    uint64_t get_bus_bits() const
+    {
+        return bus_bits_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Get the number of failed attempts to send a frame.
+     */
+    uint64_t get_transmit_retries() const
+    {
+        return transmit_retries_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Get the number of frames which could not be sent.
+     */
+    uint64_t get_send_failures() const
+    {
+        return send_failures_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Get the number of frames dropped by the receive queue.
+     */
+    uint64_t get_receive_overflows() const
+    {
+        return receive_overflows_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Get the number of frames whose ids are not tracked.
+     */
+    uint64_t get_untracked_frames() const
+    {
+        return untracked_frames_.load(std::memory_order_relaxed);
+    }
+
+    double get_bitrate() const
+    {
+        return bitrate_;
+    }
+
+    /**
+     * @brief Get the average bus load since construction (or reset()).
+     *
+     * For the load over a shorter interval, take the difference of
+     * get_bus_bits() at its start and end.
+     *
+     * @param time_s is the current time (s).
+     * @return double the fraction of the bitrate used.
+     */
+    double get_bus_load(const double& time_s) const;
+
+    /**
+     * @brief Get the number of ids with separate statistics.
+     */
+    size_t get_tracked_id_count() const;
+
+    /**
+     * @brief Get the statistics of an id.
+     *
+     * @param index in [0, get_tracked_id_count()).
+     * @return const CanIdStatistics&
+     */
+    const CanIdStatistics& get_id_statistics(const size_t& index) const
+    {
+        return ids_[index];
+    }
+
+    /**
+     * @brief Find the statistics of an id.
+     *
+     * @param id is the CAN id.
+     * @return const CanIdStatistics* nullptr if the id is not tracked.
+     */
+    const CanIdStatistics* find_id_statistics(const uint32_t& id) const;
+
+    /**
+     * @brief Get the number of bits of a frame on the wire, with worst-case
+     * bit stuffing and the interframe space.
+     *
+     * @param id is the CAN id (with the CAN_EFF_FLAG for extended ids).
+     * @param dlc is the number of data bytes.
+     * @return uint64_t the number of bits.
+     */
+    static uint64_t get_frame_bits(const uint32_t& id, const uint8_t& dlc);
+
+    /**
+     * @brief Set all counters to zero.  Must not be called concurrently with
+     * the recording.
+     *
+     * @param time_s is the current time (s), the start of the bus load
+     * average.
+     */
+    void reset(const double& time_s);
+
+    /**
+     * @brief Display the statistics.
+     *
+     * @param time_s is the current time (s).
+     */
+    void print(const double& time_s) const;
+
+private:
+    /**
+     * @brief Get (or claim) the slot of an id.
+     *
+     * @return CanIdStatistics* nullptr if all slots are taken by other ids.
+     */
+    CanIdStatistics* get_slot(const uint32_t& id);
+
+    //! @brief The configured bitrate (bit/s).
+    double bitrate_;
+    //! @brief Start of the bus load average (s).
+    std::atomic<double> start_time_s_;
+
+    std::atomic<uint64_t> received_frames_;
+    std::atomic<uint64_t> sent_frames_;
+    std::atomic<uint64_t> received_bytes_;
+    std::atomic<uint64_t> sent_bytes_;
+    std::atomic<uint64_t> bus_bits_;
+    std::atomic<uint64_t> transmit_retries_;
+    std::atomic<uint64_t> send_failures_;
+    std::atomic<uint64_t> receive_overflows_;
+    std::atomic<uint64_t> untracked_frames_;
+
+    //! @brief The statistics per id, claimed in the order the ids appear.
+    std::array<CanIdStatistics, MAX_TRACKED_IDS> ids_;
+};
+
+}  // namespace blmc_drivers
@@ -0,0 +1,133 @@
+/**
+ * @file channel_handle.hpp
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, Max Planck Gesellschaft.
+ * @brief Non-owning handle to the time series of a channel.
+ */
+#pragma once
+
+#include <type_traits>
+
+#include <time_series/time_series.hpp>
+
+namespace blmc_drivers
+{
+/**
+ * @brief Non-owning, read-only handle to the time series of one channel of a
+ * device (e.g. the position of a motor).
+ *
+ * Resolve the handles once (e.g. in the constructor of a controller) and use
+ * them in the control loop: copying or reading through a handle neither
+ * touches a reference count (unlike the std::shared_ptr returned by
+ * get_measurement() etc.) nor branches on ids.
+ *
+ * A handle stays valid as long as the device it was obtained from exists, so
+ * keep a std::shared_ptr to the device next to it.
+ *
+ * @tparam Type of the elements of the time series.
+ */
+template <typename Type>
+class ChannelHandle
+{
+public:
+    typedef time_series::TimeSeries<Type> Timeseries;
+    typedef time_series::Index Index;
+
+    /**
+     * @brief Construct an invalid handle.
+     */
+    ChannelHandle() = default;
+
+    /**
+     * @brief Construct a handle to the given time series.
+     */
+    explicit ChannelHandle(const Timeseries* timeseries)
+        : timeseries_(timeseries)
+    {
+    }
+
+    /**
+     * @brief Check if the handle refers to a time series.
+     */
+    bool is_valid() const
+    {
+        return timeseries_ != nullptr;
+    }
+
+    /**
+     * @brief Get the time series.
+     */
+    const Timeseries& get() const
+    {
+        return *timeseries_;
+    }
+
+    /**
+     * @brief Get the time series.
+     */
+    const Timeseries* operator->() const
+    {
+        return timeseries_;
+    }
+
+    /**
+     * @brief Get the element with the given time index.
+     */
+    Type operator[](const Index& timeindex) const
+    {
+        return (*timeseries_)[timeindex];
+    }
+
+    /**
+     * @brief Get the newest element (waits if there is none yet).
+     */
+    Type newest_element() const
+    {
+        return timeseries_->newest_element();
+    }
+
+    /**
+     * @brief Get the newest element, or the given value if there is none
+     * yet.
+     */
+    Type newest_element_or(const Type& default_value) const
+    {
+        if (timeseries_->length() == 0)
+        {
+            return default_value;
+        }
+        return timeseries_->newest_element();
+    }
+
+    /**
+     * @brief Get the time index of the newest element.
+     */
+    Index newest_timeindex(const bool& wait = true) const
+    {
+        return timeseries_->newest_timeindex(wait);
+    }
+
+    /**
+     * @brief Get the number of elements in the time series.
+     */
+    size_t length() const
+    {
+        return timeseries_->length();
+    }
+
+private:
+    /**
+     * @brief The time series, owned by the device.
+     */
+    const Timeseries* timeseries_ = nullptr;
+};
+
+/**
+ * @brief Handle to a time series of doubles.
+ */
+typedef ChannelHandle<double> ScalarChannel;
+
+static_assert(std::is_trivially_copyable<ScalarChannel>::value,
+              "channel handles must be trivially copyable");
+
+}  // namespace blmc_drivers
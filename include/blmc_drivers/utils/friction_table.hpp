@@ -0,0 +1,174 @@
+/**
+ * @file friction_table.hpp
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, Max Planck Gesellschaft.
+ * @brief Torque over a grid of positions and velocities, e.g. to compensate
+ * friction and cogging.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace blmc_drivers
+{
+/**
+ * @brief Torque given at the nodes of a regular grid over position and
+ * velocity, interpolated bilinearly in between.
+ *
+ * The position nodes span [position_min, position_max], either clamped at
+ * the ends or, if periodic, repeating with period position_max -
+ * position_min (e.g. for the cogging of a motor).  The velocity nodes span
+ * [-max_velocity, max_velocity] and are clamped at the ends.
+ *
+ * The values are stored in one contiguous array, position-major, so a
+ * lookup reads two pairs of adjacent doubles and needs no division.
+ */
+class FrictionTable
+{
+public:
+    /**
+     * @brief Construct a new FrictionTable object with all values zero.
+     *
+     * @param position_min (rad) of the first position node.
+     * @param position_max (rad) of the last position node, or the end of
+     * the period.
+     * @param position_node_count (at least 2).
+     * @param is_periodic if the positions repeat.
+     * @param max_velocity (rad/s) of the last velocity node.
+     * @param velocity_node_count (at least 2).
+     * @throw std::invalid_argument if the grid is empty.
+     */
+    FrictionTable(const double& position_min,
+                  const double& position_max,
+                  const size_t& position_node_count,
+                  const bool& is_periodic,
+                  const double& max_velocity,
+                  const size_t& velocity_node_count);
+
+    /**
+     * @brief Get the interpolated torque.
+     *
+     * @param position (rad)
+     * @param velocity (rad/s)
+     * @return double the torque (Nm), 0 if the position or velocity is NaN.
+     */
+    double lookup(const double& position, const double& velocity) const
+    {
+        if (std::isnan(position) || std::isnan(velocity))
+        {
+            return 0.0;
+        }
+
+        // position node and fraction towards the next one.
+        double p = (position - position_min_) * position_scale_;
+        size_t i, next_i;
+        if (is_periodic_)
+        {
+            p -= std::floor(p / position_node_count_) * position_node_count_;
+            i = std::min(size_t(p), position_node_count_ - 1);
+            next_i = i + 1 < position_node_count_ ? i + 1 : 0;
+        }
+        else
+        {
+            p = std::max(0.0, std::min(p, double(position_node_count_ - 1)));
+            i = std::min(size_t(p), position_node_count_ - 2);
+            next_i = i + 1;
+        }
+        double position_fraction = p - i;
+
+        // velocity node and fraction towards the next one.
+        double v = (velocity + max_velocity_) * velocity_scale_;
+        v = std::max(0.0, std::min(v, double(velocity_node_count_ - 1)));
+        size_t j = std::min(size_t(v), velocity_node_count_ - 2);
+        double velocity_fraction = v - j;
+
+        const double* row = &values_[i * velocity_node_count_ + j];
+        const double* next_row = &values_[next_i * velocity_node_count_ + j];
+        double value = row[0] + (row[1] - row[0]) * velocity_fraction;
+        double next_value =
+            next_row[0] + (next_row[1] - next_row[0]) * velocity_fraction;
+        return value + (next_value - value) * position_fraction;
+    }
+
+    /**
+     * @brief Get the value at a node.
+     */
+    double get_value(const size_t& position_node,
+                     const size_t& velocity_node) const
+    {
+        return values_[position_node * velocity_node_count_ + velocity_node];
+    }
+
+    /**
+     * @brief Set the value at a node.
+     */
+    void set_value(const size_t& position_node,
+                   const size_t& velocity_node,
+                   const double& value)
+    {
+        values_[position_node * velocity_node_count_ + velocity_node] = value;
+    }
+
+    /**
+     * @brief Get the position (rad) of a node.
+     */
+    double get_position(const size_t& position_node) const
+    {
+        return position_min_ + position_node / position_scale_;
+    }
+
+    /**
+     * @brief Get the velocity (rad/s) of a node.
+     */
+    double get_velocity(const size_t& velocity_node) const
+    {
+        return -max_velocity_ + velocity_node / velocity_scale_;
+    }
+
+    /**
+     * @brief Get the node closest to a position.
+     */
+    size_t get_position_node(const double& position) const;
+
+    size_t get_position_node_count() const
+    {
+        return position_node_count_;
+    }
+
+    size_t get_velocity_node_count() const
+    {
+        return velocity_node_count_;
+    }
+
+    bool is_periodic() const
+    {
+        return is_periodic_;
+    }
+
+private:
+    double position_min_;
+    size_t position_node_count_;
+    bool is_periodic_;
+    double max_velocity_;
+    size_t velocity_node_count_;
+
+    /**
+     * @brief Position nodes per rad.
+     */
+    double position_scale_;
+
+    /**
+     * @brief Velocity nodes per rad/s.
+     */
+    double velocity_scale_;
+
+    /**
+     * @brief Values of all nodes, position-major.
+     */
+    std::vector<double> values_;
+};
+
+}  // namespace blmc_drivers
@@ -0,0 +1,194 @@
+/**
+ * @file hybrid_spinner.hpp
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, Max Planck Gesellschaft.
+ * @brief Periodic loop timing with absolute deadlines and a final busy-wait.
+ */
+#pragma once
+
+#include <cstdint>
+
+#include "blmc_drivers/utils/latency_histogram.hpp"
+
+namespace blmc_drivers
+{
+/**
+ * @brief Drop-in replacement of real_time_tools::Spinner for control loops
+ * which need a low period jitter (e.g. at 2-4 kHz).
+ *
+ * The deadlines are absolute on CLOCK_MONOTONIC, so the time spent in the
+ * loop body does not accumulate as drift.  spin() sleeps with
+ * clock_nanosleep(TIMER_ABSTIME) until shortly before the deadline and
+ * busy-waits the rest, which removes the wake-up latency of the scheduler at
+ * the cost of burning the CPU for the busy-wait time.
+ *
+ * If the deadline has already passed when spin() is called, this is counted
+ * as an overrun and the following deadlines are shifted, i.e. missed periods
+ * are skipped instead of being caught up in a burst.
+ *
+ * All the memory is part of the object, spin() does not allocate.
+ */
+class HybridSpinner
+{
+public:
+    /**
+     * @brief Default time spent busy-waiting before each deadline.  Larger
+     * than the typical wake-up latency of a PREEMPT_RT kernel.
+     */
+    static constexpr double DEFAULT_BUSY_WAIT_S = 100e-6;
+
+    /**
+     * @brief Construct a new HybridSpinner object, the first period starts
+     * now.
+     *
+     * @param period_s is the period of the loop.
+     * @param busy_wait_s is the time to busy-wait before each deadline (0
+     * to only sleep).
+     */
+    HybridSpinner(const double& period_s = 0.001,
+                  const double& busy_wait_s = DEFAULT_BUSY_WAIT_S);
+
+    HybridSpinner(const HybridSpinner&) = delete;
+    HybridSpinner& operator=(const HybridSpinner&) = delete;
+
+    /**
+     * @brief Set the period of the loop, the current period included: its
+     * deadline is moved to period_s after its start.
+     */
+    void set_period(const double& period_s);
+
+    /**
+     * @brief Set the time to busy-wait before each deadline.
+     */
+    void set_busy_wait(const double& busy_wait_s);
+
+    /**
+     * @brief Start a new period now (e.g. after the loop was paused).
+     */
+    void initialize();
+
+    /**
+     * @brief Wait until the end of the current period.
+     */
+    void spin();
+
+    /**
+     * @brief Get the period of the loop (s).
+     */
+    double get_period() const
+    {
+        return period_ns_ * 1e-9;
+    }
+
+    /**
+     * @brief Get the end of the current period (CLOCK_MONOTONIC, ns).
+     */
+    int64_t get_deadline_ns() const
+    {
+        return deadline_ns_;
+    }
+
+    /**
+     * @brief Get the number of calls to spin().
+     */
+    uint64_t get_spin_count() const
+    {
+        return spin_count_;
+    }
+
+    /**
+     * @brief Get the number of calls to spin() after the deadline.
+     */
+    uint64_t get_overrun_count() const
+    {
+        return overrun_count_;
+    }
+
+    /**
+     * @brief Get the times between the returns of two consecutive spin().
+     */
+    const LatencyHistogram& get_periods() const
+    {
+        return periods_;
+    }
+
+    /**
+     * @brief Get the times by which spin() returned after the deadline
+     * (overruns included).
+     */
+    const LatencyHistogram& get_wakeup_latencies() const
+    {
+        return wakeup_latencies_;
+    }
+
+    /**
+     * @brief Forget overruns and statistics.
+     */
+    void reset_statistics();
+
+    /**
+     * @brief Print overruns and period statistics.
+     */
+    void print_statistics() const;
+
+    /**
+     * @brief Get the current time of CLOCK_MONOTONIC (ns).
+     */
+    static int64_t get_monotonic_time_ns();
+
+    /**
+     * @brief Sleep until shortly before the given time, then busy-wait until
+     * it.
+     *
+     * @param deadline_ns (CLOCK_MONOTONIC) to return at.
+     * @param busy_wait_ns is the time to busy-wait before the deadline.
+     * @return int64_t the time of return (CLOCK_MONOTONIC, ns), which is the
+     * time of call if the deadline has already passed.
+     */
+    static int64_t wait_until(const int64_t& deadline_ns,
+                              const int64_t& busy_wait_ns);
+
+private:
+    /**
+     * @brief Period of the loop (ns).
+     */
+    int64_t period_ns_;
+
+    /**
+     * @brief Time to busy-wait before the deadline (ns).
+     */
+    int64_t busy_wait_ns_;
+
+    /**
+     * @brief End of the current period (CLOCK_MONOTONIC, ns).
+     */
+    int64_t deadline_ns_;
+
+    /**
+     * @brief Return time of the last spin() (CLOCK_MONOTONIC, ns), -1 if
+     * none.
+     */
+    int64_t last_return_ns_;
+
+    /**
+     * @brief Number of calls to spin().
+     */
+    uint64_t spin_count_;
+
+    /**
+     * @brief Number of calls to spin() after the deadline.
+     */
+    uint64_t overrun_count_;
+
+    /**
+     * @brief Times between the returns of two consecutive spin().
+     */
+    LatencyHistogram periods_;
+
+    /**
+     * @brief Times by which spin() returned after the deadline.
+     */
+    LatencyHistogram wakeup_latencies_;
+};
+
+}  // namespace blmc_drivers
@@ -0,0 +1,153 @@
+/**
+ * @file latency_histogram.hpp
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, Max Planck Gesellschaft.
+ * @brief Fixed-size histogram of latencies with bounded relative error.
+ */
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace blmc_drivers
+{
+/**
+ * @brief Histogram of latencies in the style of an HdrHistogram.
+ *
+ * The latencies are recorded with nanosecond resolution into log-linear
+ * buckets: below SUB_BUCKET_COUNT ns each nanosecond has its own bucket,
+ * above each power of two is split into SUB_BUCKET_COUNT / 2 buckets.  So the
+ * relative error of the reported percentiles is at most 2 / SUB_BUCKET_COUNT
+ * (1/32, about 3.1%) over the whole range (below 2^MAX_EXPONENT ns, larger
+ * values are counted in an overflow bucket).
+ *
+ * All the memory is part of the object.  record() is wait-free and can be
+ * called from real-time threads, concurrently with the getters (which then
+ * see a slightly inconsistent snapshot).
+ */
+class LatencyHistogram
+{
+public:
+    /**
+     * @brief Number of buckets of the first power of two, all other powers of
+     * two get half as many.
+     */
+    static constexpr size_t SUB_BUCKET_COUNT = 64;
+
+    /**
+     * @brief Largest recorded latency is 2^MAX_EXPONENT ns (about 18 min).
+     */
+    static constexpr size_t MAX_EXPONENT = 40;
+
+    /**
+     * @brief Total number of buckets, the last one counts the latencies of
+     * 2^MAX_EXPONENT ns and more.
+     */
+    static constexpr size_t BUCKET_COUNT =
+        SUB_BUCKET_COUNT + (MAX_EXPONENT - 6) * (SUB_BUCKET_COUNT / 2) + 1;
+
+    /**
+     * @brief Construct an empty histogram.
+     */
+    LatencyHistogram();
+
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+    /**
+     * @brief Record one latency.
+     *
+     * @param latency_s is the latency in seconds (negative values are
+     * recorded as 0).
+     */
+    void record(const double& latency_s);
+
+    /**
+     * @brief Record one latency.
+     *
+     * @param latency_ns is the latency in nanoseconds.
+     */
+    void record_ns(const int64_t& latency_ns);
+
+    /**
+     * @brief Get the number of recorded latencies.
+     */
+    uint64_t get_count() const;
+
+    /**
+     * @brief Get the smallest recorded latency (s), NaN if none.
+     */
+    double get_min() const;
+
+    /**
+     * @brief Get the largest recorded latency (s), NaN if none.
+     */
+    double get_max() const;
+
+    /**
+     * @brief Get the mean of the recorded latencies (s), NaN if none.
+     */
+    double get_mean() const;
+
+    /**
+     * @brief Get the latency below which the given percentage of the recorded
+     * latencies lie.
+     *
+     * @param percentile in [0, 100].
+     * @return double the latency (s), i.e. the upper bound of the bucket
+     * containing the percentile (but at most get_max()), NaN if empty.
+     */
+    double get_percentile(const double& percentile) const;
+
+    /**
+     * @brief Forget all recorded latencies.  Must not be called concurrently
+     * with record().
+     */
+    void reset();
+
+    /**
+     * @brief Get the bucket a latency is counted in.
+     *
+     * @param latency_ns is the latency in nanoseconds.
+     * @return size_t the index of the bucket.
+     */
+    static size_t get_bucket_index(const int64_t& latency_ns);
+
+    /**
+     * @brief Get the largest latency (ns) counted in a bucket.
+     *
+     * @param bucket_index
+     * @return int64_t the upper bound (inclusive).
+     */
+    static int64_t get_bucket_upper_bound(const size_t& bucket_index);
+
+private:
+    /**
+     * @brief Number of latencies of each bucket.
+     */
+    std::array<std::atomic<uint64_t>, BUCKET_COUNT> buckets_;
+
+    /**
+     * @brief Number of recorded latencies.
+     */
+    std::atomic<uint64_t> count_;
+
+    /**
+     * @brief Sum of the recorded latencies (ns).
+     */
+    std::atomic<uint64_t> sum_ns_;
+
+    /**
+     * @brief Smallest recorded latency (ns).
+     */
+    std::atomic<int64_t> min_ns_;
+
+    /**
+     * @brief Largest recorded latency (ns).
+     */
+    std::atomic<int64_t> max_ns_;
+};
+
+}  // namespace blmc_drivers
@@ -0,0 +1,97 @@
+/**
+ * @file memory_locking.hpp
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, Max Planck Gesellschaft.
+ * @brief Lock the memory of the process in RAM, so that the real-time threads
+ * do not page fault.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace blmc_drivers
+{
+/**
+ * @brief Outcome of check_memory_residency() (and lock_memory()).
+ */
+struct MemoryLockReport
+{
+    //! @brief Memory locked by the process (VmLck).
+    size_t locked_bytes;
+    //! @brief Size of all writable mappings of the process.
+    size_t writable_bytes;
+    //! @brief Part of the writable mappings which is not in RAM.
+    size_t non_resident_bytes;
+};
+
+/**
+ * @brief Default heap reserve of lock_memory().
+ */
+constexpr size_t DEFAULT_HEAP_RESERVE_BYTES = 16 * 1024 * 1024;
+
+/**
+ * @brief Default stack reserve of lock_memory().
+ */
+constexpr size_t DEFAULT_STACK_RESERVE_BYTES = 512 * 1024;
+
+/**
+ * @brief Lock all current and future memory of the process in RAM and
+ * pre-fault it.
+ *
+ * Call this once after constructing the drivers (CanBus, CanBusMotorBoard,
+ * SafeMotor, ...) and before starting the control loop.  mlockall() populates
+ * every existing mapping, i.e. all the time series and shared memory rings of
+ * the drivers and the stacks of their threads, and MCL_FUTURE does the same
+ * for everything mapped later.  In addition:
+ *
+ * - malloc is told to never return memory to the system and to never use
+ *   mmap(), so freed memory is reused without page faults.
+ * - heap_reserve_bytes of heap are pre-faulted (see prefault_heap()).
+ * - stack_reserve_bytes of the stack of the calling thread are pre-faulted
+ *   (see prefault_stack()), the main stack grows on demand otherwise.
+ *
+ * Finally the residency of all writable memory is verified with
+ * check_memory_residency().
+ *
+ * @param heap_reserve_bytes is the heap to pre-fault.
+ * @param stack_reserve_bytes is the stack of the calling thread to pre-fault.
+ * @return MemoryLockReport of the verification.
+ * @throw std::runtime_error if the memory can not be locked (which needs
+ * CAP_IPC_LOCK or a sufficient RLIMIT_MEMLOCK) or is not resident afterwards.
+ */
+MemoryLockReport lock_memory(
+    const size_t& heap_reserve_bytes = DEFAULT_HEAP_RESERVE_BYTES,
+    const size_t& stack_reserve_bytes = DEFAULT_STACK_RESERVE_BYTES);
+
+/**
+ * @brief Touch the given amount of stack of the calling thread.
+ *
+ * Has to be called from each thread whose stack grows on demand (i.e. the
+ * main thread), the stacks of other threads are mapped at once.
+ */
+void prefault_stack(const size_t& size_bytes);
+
+/**
+ * @brief Allocate, touch and free the given amount of heap.
+ *
+ * Only useful once malloc does not return memory to the system anymore (as
+ * set up by lock_memory()).  Note that glibc uses separate heaps (arenas) for
+ * some threads, the reserve is made in the one of the calling thread.
+ */
+void prefault_heap(const size_t& size_bytes);
+
+/**
+ * @brief Check which part of the writable memory of the process is not in
+ * RAM (using mincore() on each mapping).
+ */
+MemoryLockReport check_memory_residency();
+
+/**
+ * @brief Get the number of page faults (minor and major) of the calling
+ * thread so far.  Compare it before and after a loop to verify that the loop
+ * does not page fault.
+ */
+uint64_t get_thread_page_fault_count();
+
+}  // namespace blmc_drivers
@@ -41,6 +41,7 @@
 #include <sys/types.h>
 
 #include <linux/can.h>
+#include <linux/can/error.h>
 #include <linux/can/raw.h>
 
 #include <limits.h>
@@ -238,13 +239,20 @@ typedef std::condition_variable ConditionVariable;
  * @param flags
  * @param to
  * @param tolen
- */
-inline void send_to_can_device(int fd,
+ * @param should_give_up is called after every failed attempt (e.g. because
+ * the transmit queue is full), the frame is retried every 0.1 ms until it
+ * returns true.
+ * @return long the number of failed attempts before the frame was sent, -1 if
+ * it could not be sent.
+ */
+template <typename ShouldGiveUp>
+inline long send_to_can_device(int fd,
                                const void *buf,
                                size_t len,
                                int flags,
                                const struct sockaddr *to,
-                               socklen_t tolen)
+                               socklen_t tolen,
+                               const ShouldGiveUp &should_give_up)
 {
     // int ret = rt_dev_sendto(fd, buf, len, flags, to, tolen);
 
@@ -264,19 +272,26 @@ inline void send_to_can_device(int fd,
         {
             if (i > 0)
             {
-                std::cout << " Managed to send after " << i << " attempts."
-                          << std::endl;
+                rt_printf(" Managed to send after %lu attempts.\n",
+                          (unsigned long)i);
             }
-            return;
+            return i;
         }
 
         if (i == 0)
         {
-            std::cout << "WARNING: Something went wrong with sending "
-                      << "CAN frame, error code: " << ret
-                      << ", errno: " << errno << ". Possibly you have "
-                      << "been attempting to send at a rate which is too "
-                      << "high. We keep trying" << std::flush;
+            rt_printf(
+                "WARNING: Something went wrong with sending CAN frame, error "
+                "code: %d, errno: %d. Possibly you have been attempting to "
+                "send at a rate which is too high. We keep trying",
+                ret,
+                errno);
+        }
+        if (should_give_up())
+        {
+            rt_printf(" Giving up after %lu attempts.\n",
+                      (unsigned long)(i + 1));
+            return -1;
         }
 
         real_time_tools::Timer::sleep_ms(0.1);
@@ -306,20 +321,22 @@ inline void close_can_device(int socket)
  * @param fd
  * @param msg
  * @param flags
+ * @return int the error code (errno) if receiving failed, 0 otherwise.
  */
-inline void receive_message_from_can_device(int fd,
-                                            struct msghdr *msg,
-                                            int flags)
+inline int receive_message_from_can_device(int fd,
+                                           struct msghdr *msg,
+                                           int flags)
 {
     int ret = rt_dev_recvmsg(fd, msg, flags);
     if (ret < 0)
     {
-        std::ostringstream oss;
-        oss << "something went wrong with receiving "
-            << "CAN frame, error code: " << ret << ", errno=" << errno
-            << std::endl;
-        throw std::runtime_error(oss.str());
+#ifdef __XENO__
+        return -ret;
+#else
+        return errno;
+#endif
     }
+    return 0;
 }
 
 /**
@@ -0,0 +1,87 @@
+/**
+ * @file position_unwrapper.hpp
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, Max Planck Gesellschaft.
+ * @brief Multi-turn unwrapping of positions that roll over.
+ */
+#pragma once
+
+#include <cstdint>
+
+namespace blmc_drivers
+{
+/**
+ * @brief Turns a position which rolls over at a fixed range into a continuous
+ * one.
+ *
+ * The raw position is expected in `[-range/2, range/2)`.  Whenever two
+ * consecutive samples differ by more than half the range a rollover is
+ * assumed and a 64-bit turn counter is incremented or decremented.  The
+ * unwrapped position is `raw + turn_count * range`.
+ */
+class PositionUnwrapper
+{
+public:
+    /**
+     * @brief Construct a new PositionUnwrapper object
+     *
+     * @param rollover_range is the length of the interval in which the raw
+     * position lives (in the same unit as the position).
+     */
+    explicit PositionUnwrapper(const double& rollover_range);
+
+    /**
+     * @brief Unwrap the next raw position sample and update the turn count.
+     *
+     * @param raw_position is the position as received from the board.
+     * @return double the continuous position.
+     */
+    double unwrap(const double& raw_position);
+
+    /**
+     * @brief Unwrap a position sampled close to the last one (e.g. an encoder
+     * index) without changing the internal state.
+     *
+     * @param raw_position is the position as received from the board.
+     * @return double the continuous position which is closest to the last
+     * unwrapped position.
+     */
+    double unwrap_nearby(const double& raw_position) const;
+
+    /**
+     * @brief Get the number of rollovers seen so far (negative if they
+     * happened in negative direction).
+     */
+    int64_t get_turn_count() const
+    {
+        return turn_count_;
+    }
+
+    /**
+     * @brief Forget the previous samples and set the turn count to zero.
+     */
+    void reset();
+
+private:
+    /**
+     * @brief Length of the interval of the raw position.
+     */
+    double rollover_range_;
+
+    /**
+     * @brief Number of rollovers seen so far.
+     */
+    int64_t turn_count_;
+
+    /**
+     * @brief The last raw position given to unwrap().
+     */
+    double last_raw_position_;
+
+    /**
+     * @brief False until the first sample was given to unwrap().
+     */
+    bool has_sample_;
+};
+
+}  // namespace blmc_drivers
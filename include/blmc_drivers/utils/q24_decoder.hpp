@@ -0,0 +1,57 @@
+/**
+ * @file q24_decoder.hpp
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, Max Planck Gesellschaft.
+ * @brief Batch decoding of the big-endian Q24 values sent by the BLMC boards.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace blmc_drivers
+{
+/**
+ * @brief Number of fractional bits of the fixed-point format used by the
+ * boards.
+ */
+constexpr int Q24_FRACTIONAL_BITS = 24;
+
+/**
+ * @brief Convert a 24-bit normalized fixed-point value to double.
+ *
+ * Contrary to a conversion through float this is exact for the whole int32
+ * range.
+ *
+ * @param qval is the fixed-point value.
+ * @return double is the converted value.
+ */
+inline double q24_to_double(int32_t qval)
+{
+    return static_cast<double>(qval) / (1 << Q24_FRACTIONAL_BITS);
+}
+
+/**
+ * @brief Decode the two big-endian Q24 values of a batch of CAN payloads.
+ *
+ * Each payload starts with two big-endian int32 in Q24 format.  The values
+ * of payload `i` are converted to double, multiplied by `scales[i]` and
+ * written to `out[2 * i]` and `out[2 * i + 1]`.
+ *
+ * Depending on the target this uses SSSE3 byte shuffles or a scalar
+ * byte-swap.  Both are exact up to the final multiplication with the scale.
+ *
+ * @param payloads points to the first byte of the first payload.
+ * @param stride is the distance in bytes between two consecutive payloads
+ * (e.g. `sizeof(CanBusFrame)`).
+ * @param count is the number of payloads to decode.
+ * @param scales is the unit scale of each payload (`count` elements).
+ * @param out receives the decoded values (`2 * count` elements).
+ */
+void decode_q24_pairs(const uint8_t* payloads,
+                      size_t stride,
+                      size_t count,
+                      const double* scales,
+                      double* out);
+
+}  // namespace blmc_drivers
@@ -0,0 +1,148 @@
+/**
+ * @file rt_safety.hpp
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, Max Planck Gesellschaft.
+ * @brief Marking of real-time sections, checked by the rt_safety_checker
+ * library.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace blmc_drivers
+{
+namespace internal
+{
+/**
+ * @brief Enter a real-time section on the calling thread.
+ *
+ * @return const char* the name of the enclosing section (nullptr if none).
+ */
+const char* enter_rt_section(const char* name);
+
+/**
+ * @brief Leave the current real-time section of the calling thread.
+ *
+ * @param previous_name is the return value of the matching
+ * enter_rt_section().
+ */
+void leave_rt_section(const char* previous_name);
+
+/**
+ * @brief Record a call that is not allowed in the current real-time section.
+ * Used by the rt_safety_checker library, does not allocate.
+ *
+ * @param call is the name of the function (a string literal).
+ */
+void record_rt_safety_violation(const char* call);
+
+/**
+ * @brief Tell that the rt_safety_checker library is loaded.
+ */
+void set_rt_safety_checker_loaded();
+
+}  // namespace internal
+
+/**
+ * @brief Marks the code running during its lifetime as real-time section of
+ * the calling thread.  Sections can be nested.
+ *
+ * Real-time sections must not allocate memory, print, sleep or throw.  This
+ * is not enforced in normal operation (the marking is only a thread-local
+ * assignment).  When the rt_safety_checker library is loaded, e.g. with
+ *
+ *     LD_PRELOAD=libblmc_drivers_rt_safety_checker.so <program>
+ *
+ * or by linking against it, malloc(), free(), the printing functions of
+ * stdio, write(), sleep(), usleep(), nanosleep() and throwing exceptions are
+ * intercepted and every call from inside a section is recorded (see
+ * get_rt_safety_violation_count()).  With the environment variable
+ * BLMC_RT_SAFETY_ABORT=1 the checker aborts at the first violation instead,
+ * so that the offending call can be found in the core dump.
+ */
+class RtSection
+{
+public:
+    /**
+     * @brief Enter the section.
+     *
+     * @param name of the section, has to outlive it (i.e. use a string
+     * literal).
+     */
+    explicit RtSection(const char* name)
+        : previous_name_(internal::enter_rt_section(name))
+    {
+    }
+
+    /**
+     * @brief Leave the section.
+     */
+    ~RtSection()
+    {
+        internal::leave_rt_section(previous_name_);
+    }
+
+    RtSection(const RtSection&) = delete;
+    RtSection& operator=(const RtSection&) = delete;
+
+private:
+    /**
+     * @brief Name of the enclosing section (nullptr if none).
+     */
+    const char* previous_name_;
+};
+
+/**
+ * @brief A call made inside a real-time section.
+ */
+struct RtSafetyViolation
+{
+    //! @brief Name of the innermost section.
+    const char* section;
+    //! @brief Name of the function which was called.
+    const char* call;
+};
+
+/**
+ * @brief Number of violations which are kept, later ones are only counted.
+ */
+constexpr size_t MAX_RECORDED_RT_SAFETY_VIOLATIONS = 64;
+
+/**
+ * @brief Get the name of the innermost real-time section of the calling
+ * thread, nullptr if it is not in a section.
+ */
+const char* get_current_rt_section();
+
+/**
+ * @brief Check if the rt_safety_checker library is loaded, i.e. if
+ * violations are detected at all.
+ */
+bool is_rt_safety_checker_loaded();
+
+/**
+ * @brief Get the number of violations since the start (or the last reset).
+ */
+uint64_t get_rt_safety_violation_count();
+
+/**
+ * @brief Get one of the first MAX_RECORDED_RT_SAFETY_VIOLATIONS violations.
+ *
+ * @param index in [0, min(get_rt_safety_violation_count(),
+ * MAX_RECORDED_RT_SAFETY_VIOLATIONS)).
+ */
+RtSafetyViolation get_rt_safety_violation(const size_t& index);
+
+/**
+ * @brief Print the recorded violations.
+ */
+void print_rt_safety_violations();
+
+/**
+ * @brief Forget all violations.  Must not be called concurrently with
+ * real-time sections.
+ */
+void reset_rt_safety_violations();
+
+}  // namespace blmc_drivers
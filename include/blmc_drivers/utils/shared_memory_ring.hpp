@@ -0,0 +1,316 @@
+/**
+ * @file shared_memory_ring.hpp
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, Max Planck Gesellschaft.
+ * @brief Lock-free single-writer/multi-reader ring buffer in POSIX shared
+ * memory.
+ */
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <type_traits>
+
+namespace blmc_drivers
+{
+namespace internal
+{
+/**
+ * @brief Header at the beginning of the shared memory segment.
+ */
+struct SharedMemoryRingHeader
+{
+    //! @brief Identifies a segment containing a ring.
+    uint64_t magic;
+    //! @brief sizeof() of the stored type, to detect mismatching readers.
+    uint64_t record_size;
+    //! @brief Number of slots of the ring.
+    uint64_t capacity;
+    //! @brief Index the next record will get (= number of written records).
+    std::atomic<uint64_t> next_index;
+    //! @brief Process which currently writes to the ring (0 if none).
+    std::atomic<int32_t> writer_pid;
+    //! @brief Incremented on every append, futex word of waiting readers.
+    std::atomic<uint32_t> wakeup_count;
+    //! @brief Number of readers currently waiting for a new record.
+    std::atomic<uint32_t> waiter_count;
+};
+
+/**
+ * @brief One slot of the ring.
+ *
+ * The sequence is `2 * index + 1` while the record with the given index is
+ * written and `2 * index + 2` once it is complete, so readers can detect
+ * torn or overwritten records without any lock (seqlock).
+ */
+template <typename Type>
+struct SharedMemoryRingSlot
+{
+    std::atomic<uint64_t> sequence;
+    Type record;
+};
+
+/**
+ * @brief Value of SharedMemoryRingHeader::magic.
+ */
+constexpr uint64_t SHARED_MEMORY_RING_MAGIC = 0x626c6d63'72696e67;  // "blmcring"
+
+/**
+ * @brief Size of the segment needed for the given capacity.
+ */
+template <typename Type>
+size_t shared_memory_ring_size(const uint64_t& capacity)
+{
+    return sizeof(SharedMemoryRingHeader) +
+           capacity * sizeof(SharedMemoryRingSlot<Type>);
+}
+
+/**
+ * @brief Create (or replace) a shared memory segment, map it and touch all of
+ * its pages.
+ *
+ * @param name of the segment (with leading '/').
+ * @param size of the segment.
+ * @return void* the start of the mapping.
+ * @throw std::runtime_error if the segment can not be created.
+ */
+void* create_shared_memory(const std::string& name, const size_t& size);
+
+/**
+ * @brief Map an existing shared memory segment.
+ *
+ * @param name of the segment (with leading '/').
+ * @param[out] size of the segment.
+ * @return void* the start of the mapping.
+ * @throw std::runtime_error if the segment can not be mapped.
+ */
+void* attach_shared_memory(const std::string& name, size_t& size);
+
+/**
+ * @brief Register the calling process as the writer of a ring.
+ *
+ * @throw std::runtime_error if another process which is still alive is
+ * registered.
+ */
+void claim_ring_writer(SharedMemoryRingHeader* header, const std::string& name);
+
+/**
+ * @brief Unregister the calling process as writer of a ring.
+ */
+void release_ring_writer(SharedMemoryRingHeader* header);
+
+/**
+ * @brief Wake up the readers waiting in wait_for_ring_index().  Does not do
+ * any system call if nobody waits.
+ */
+void notify_ring_readers(SharedMemoryRingHeader* header);
+
+/**
+ * @brief Wait until the record with the given index is appended.
+ *
+ * @param header of the ring.
+ * @param index of the record.
+ * @param timeout_s is the max. time to wait (NaN for no limit).
+ * @return true if the record was appended.
+ * @return false on timeout.
+ */
+bool wait_for_ring_index(SharedMemoryRingHeader* header,
+                         const uint64_t& index,
+                         const double& timeout_s);
+
+}  // namespace internal
+
+/**
+ * @brief Appends records to a ring buffer in POSIX shared memory (i.e. in
+ * /dev/shm).
+ *
+ * There must be only one writer per ring at a time.  Appending never blocks
+ * and never allocates: the oldest record is simply overwritten, so a slow or
+ * crashed reader has no influence on the writer.
+ *
+ * @tparam Type of the records.  Has to be trivially copyable.
+ */
+template <typename Type>
+class SharedMemoryRingWriter
+{
+    static_assert(std::is_trivially_copyable<Type>::value,
+                  "records of a shared memory ring must be trivially copyable");
+
+public:
+    /**
+     * @brief Create (or replace) the ring.  The segment is removed again by
+     * the destructor.
+     *
+     * All pages are touched here, so that appending does not page fault.
+     *
+     * @param name of the segment (without leading '/'), it appears as
+     * /dev/shm/<name>.
+     * @param capacity is the number of records kept.
+     */
+    SharedMemoryRingWriter(const std::string& name, const uint64_t& capacity);
+
+    /**
+     * @brief Become the writer of a ring created by a SharedMemoryRingReader
+     * (possibly in another process).
+     *
+     * @param name of the segment (without leading '/').
+     * @throw std::runtime_error if the ring does not exist, does not contain
+     * records of this type or already has a writer.
+     */
+    explicit SharedMemoryRingWriter(const std::string& name);
+
+    /**
+     * @brief Unmap the segment (and remove it if it was created by this
+     * object).  Attached readers keep their mapping.
+     */
+    ~SharedMemoryRingWriter();
+
+    SharedMemoryRingWriter(const SharedMemoryRingWriter&) = delete;
+    SharedMemoryRingWriter& operator=(const SharedMemoryRingWriter&) = delete;
+
+    /**
+     * @brief Append a record (wait-free, only does a system call if a reader
+     * is waiting for it).
+     *
+     * @param record
+     * @param should_notify is false to append several records and wake up
+     * the waiting readers once for all of them with notify_readers().
+     */
+    void append(const Type& record, const bool& should_notify = true);
+
+    /**
+     * @brief Wake up the readers waiting for the records appended without
+     * notification.
+     */
+    void notify_readers()
+    {
+        internal::notify_ring_readers(header_);
+    }
+
+    /**
+     * @brief Get the number of records appended so far.
+     */
+    uint64_t count_appended_records() const
+    {
+        return header_->next_index.load(std::memory_order_relaxed);
+    }
+
+private:
+    //! @brief Name of the segment (with leading '/').
+    std::string name_;
+    //! @brief True if the segment was created (and is removed) by this object.
+    bool owns_segment_;
+    //! @brief Size of the mapping.
+    size_t size_;
+    //! @brief Start of the mapping.
+    internal::SharedMemoryRingHeader* header_;
+    //! @brief The slots following the header.
+    internal::SharedMemoryRingSlot<Type>* slots_;
+};
+
+/**
+ * @brief Reads the records of a ring buffer in POSIX shared memory.
+ *
+ * Reading never blocks the writer.  Any number of readers can be attached.
+ *
+ * @tparam Type of the records, the same as for the writer.
+ */
+template <typename Type>
+class SharedMemoryRingReader
+{
+    static_assert(std::is_trivially_copyable<Type>::value,
+                  "records of a shared memory ring must be trivially copyable");
+
+public:
+    /**
+     * @brief Attach to an existing ring.
+     *
+     * @param name of the segment (without leading '/').
+     * @throw std::runtime_error if the segment does not exist or does not
+     * contain records of this type.
+     */
+    explicit SharedMemoryRingReader(const std::string& name);
+
+    /**
+     * @brief Create (or replace) a ring which is written by another process
+     * (see SharedMemoryRingWriter(const std::string&)).  The segment is
+     * removed again by the destructor.
+     *
+     * @param name of the segment (without leading '/').
+     * @param capacity is the number of records kept.
+     */
+    SharedMemoryRingReader(const std::string& name, const uint64_t& capacity);
+
+    /**
+     * @brief Unmap the segment (and remove it if it was created by this
+     * object).
+     */
+    ~SharedMemoryRingReader();
+
+    SharedMemoryRingReader(const SharedMemoryRingReader&) = delete;
+    SharedMemoryRingReader& operator=(const SharedMemoryRingReader&) = delete;
+
+    /**
+     * @brief Get the index of the newest record (-1 if there is none).
+     */
+    int64_t newest_index() const;
+
+    /**
+     * @brief Get the index of the oldest record still in the ring (-1 if
+     * there is none).
+     */
+    int64_t oldest_index() const;
+
+    /**
+     * @brief Read the record with the given index.
+     *
+     * @param index of the record.
+     * @param[out] record
+     * @return true if the record was read.
+     * @return false if it is not written yet or has already been
+     * overwritten.
+     */
+    bool read(const int64_t& index, Type& record) const;
+
+    /**
+     * @brief Read the newest record.
+     *
+     * @param[out] record
+     * @return int64_t the index of the record which was read, -1 if none.
+     */
+    int64_t read_newest(Type& record) const;
+
+    /**
+     * @brief Wait until the record with the given index is appended.
+     *
+     * The waiting is done on a futex in the shared memory, so the reader
+     * wakes up within microseconds after the append.
+     *
+     * @param index of the record.
+     * @param timeout_s is the max. time to wait (NaN for no limit).
+     * @return true if the record was appended.
+     * @return false on timeout.
+     */
+    bool wait_for_index(
+        const int64_t& index,
+        const double& timeout_s =
+            std::numeric_limits<double>::quiet_NaN()) const;
+
+private:
+    //! @brief Name of the segment (with leading '/').
+    std::string name_;
+    //! @brief True if the segment was created (and is removed) by this object.
+    bool owns_segment_;
+    //! @brief Size of the mapping.
+    size_t size_;
+    //! @brief Start of the mapping.
+    internal::SharedMemoryRingHeader* header_;
+    //! @brief The slots following the header.
+    internal::SharedMemoryRingSlot<Type>* slots_;
+};
+
+}  // namespace blmc_drivers
+
+#include "blmc_drivers/utils/shared_memory_ring.hxx"
@@ -0,0 +1,254 @@
+/**
+ * @file shared_memory_ring.hxx
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, Max Planck Gesellschaft.
+ * @brief Implementation of the shared memory ring buffer.
+ */
+
+#pragma once
+
+#include <sys/mman.h>
+
+#include <cstring>
+#include <new>
+#include <stdexcept>
+
+namespace blmc_drivers
+{
+namespace internal
+{
+/**
+ * @brief Initialize a freshly created ring.
+ */
+template <typename Type>
+SharedMemoryRingHeader* initialize_ring(void* memory, const uint64_t& capacity)
+{
+    SharedMemoryRingHeader* header = new (memory) SharedMemoryRingHeader;
+    auto slots = reinterpret_cast<SharedMemoryRingSlot<Type>*>(
+        static_cast<char*>(memory) + sizeof(SharedMemoryRingHeader));
+    for (uint64_t i = 0; i < capacity; i++)
+    {
+        new (&slots[i]) SharedMemoryRingSlot<Type>;
+        slots[i].sequence.store(0, std::memory_order_relaxed);
+    }
+
+    header->record_size = sizeof(Type);
+    header->capacity = capacity;
+    header->next_index.store(0, std::memory_order_relaxed);
+    header->writer_pid.store(0, std::memory_order_relaxed);
+    header->wakeup_count.store(0, std::memory_order_relaxed);
+    header->waiter_count.store(0, std::memory_order_relaxed);
+    // written last, the ring is only valid once the header is complete.
+    std::atomic_thread_fence(std::memory_order_release);
+    header->magic = SHARED_MEMORY_RING_MAGIC;
+
+    return header;
+}
+
+/**
+ * @brief Check that an attached segment contains a ring of the given type.
+ */
+template <typename Type>
+SharedMemoryRingHeader* validate_ring(void* memory,
+                                      const size_t& size,
+                                      const std::string& name)
+{
+    auto header = static_cast<SharedMemoryRingHeader*>(memory);
+    if (size < sizeof(SharedMemoryRingHeader) ||
+        header->magic != SHARED_MEMORY_RING_MAGIC ||
+        header->record_size != sizeof(Type) ||
+        shared_memory_ring_size<Type>(header->capacity) != size)
+    {
+        munmap(memory, size);
+        throw std::runtime_error(name +
+                                 " does not contain a ring of this type");
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return header;
+}
+
+/**
+ * @brief Get the slots following the header.
+ */
+template <typename Type>
+SharedMemoryRingSlot<Type>* get_ring_slots(SharedMemoryRingHeader* header)
+{
+    return reinterpret_cast<SharedMemoryRingSlot<Type>*>(
+        reinterpret_cast<char*>(header) + sizeof(SharedMemoryRingHeader));
+}
+
+}  // namespace internal
+
+template <typename Type>
+SharedMemoryRingWriter<Type>::SharedMemoryRingWriter(const std::string& name,
+                                                     const uint64_t& capacity)
+    : name_("/" + name),
+      owns_segment_(true),
+      size_(internal::shared_memory_ring_size<Type>(capacity))
+{
+    if (capacity == 0)
+    {
+        throw std::invalid_argument("shared memory ring needs capacity > 0");
+    }
+    void* memory = internal::create_shared_memory(name_, size_);
+    header_ = internal::initialize_ring<Type>(memory, capacity);
+    slots_ = internal::get_ring_slots<Type>(header_);
+    internal::claim_ring_writer(header_, name_);
+}
+
+template <typename Type>
+SharedMemoryRingWriter<Type>::SharedMemoryRingWriter(const std::string& name)
+    : name_("/" + name), owns_segment_(false)
+{
+    void* memory = internal::attach_shared_memory(name_, size_);
+    header_ = internal::validate_ring<Type>(memory, size_, name_);
+    slots_ = internal::get_ring_slots<Type>(header_);
+    try
+    {
+        internal::claim_ring_writer(header_, name_);
+    }
+    catch (...)
+    {
+        munmap(header_, size_);
+        throw;
+    }
+}
+
+template <typename Type>
+SharedMemoryRingWriter<Type>::~SharedMemoryRingWriter()
+{
+    internal::release_ring_writer(header_);
+    munmap(header_, size_);
+    if (owns_segment_)
+    {
+        shm_unlink(name_.c_str());
+    }
+}
+
+template <typename Type>
+void SharedMemoryRingWriter<Type>::append(const Type& record,
+                                          const bool& should_notify)
+{
+    uint64_t index = header_->next_index.load(std::memory_order_relaxed);
+    internal::SharedMemoryRingSlot<Type>& slot =
+        slots_[index % header_->capacity];
+
+    slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(&slot.record, &record, sizeof(Type));
+    slot.sequence.store(2 * index + 2, std::memory_order_release);
+
+    header_->next_index.store(index + 1, std::memory_order_release);
+    if (should_notify)
+    {
+        internal::notify_ring_readers(header_);
+    }
+}
+
+template <typename Type>
+SharedMemoryRingReader<Type>::SharedMemoryRingReader(const std::string& name)
+    : name_("/" + name), owns_segment_(false)
+{
+    void* memory = internal::attach_shared_memory(name_, size_);
+    header_ = internal::validate_ring<Type>(memory, size_, name_);
+    slots_ = internal::get_ring_slots<Type>(header_);
+}
+
+template <typename Type>
+SharedMemoryRingReader<Type>::SharedMemoryRingReader(const std::string& name,
+                                                     const uint64_t& capacity)
+    : name_("/" + name),
+      owns_segment_(true),
+      size_(internal::shared_memory_ring_size<Type>(capacity))
+{
+    if (capacity == 0)
+    {
+        throw std::invalid_argument("shared memory ring needs capacity > 0");
+    }
+    void* memory = internal::create_shared_memory(name_, size_);
+    header_ = internal::initialize_ring<Type>(memory, capacity);
+    slots_ = internal::get_ring_slots<Type>(header_);
+}
+
+template <typename Type>
+SharedMemoryRingReader<Type>::~SharedMemoryRingReader()
+{
+    munmap(header_, size_);
+    if (owns_segment_)
+    {
+        shm_unlink(name_.c_str());
+    }
+}
+
+template <typename Type>
+int64_t SharedMemoryRingReader<Type>::newest_index() const
+{
+    return int64_t(header_->next_index.load(std::memory_order_acquire)) - 1;
+}
+
+template <typename Type>
+int64_t SharedMemoryRingReader<Type>::oldest_index() const
+{
+    int64_t next_index = header_->next_index.load(std::memory_order_acquire);
+    if (next_index == 0)
+    {
+        return -1;
+    }
+    int64_t capacity = header_->capacity;
+    // the slot of the oldest record may be overwritten right now.
+    return next_index > capacity ? next_index - capacity + 1 : 0;
+}
+
+template <typename Type>
+bool SharedMemoryRingReader<Type>::read(const int64_t& index,
+                                        Type& record) const
+{
+    if (index < 0)
+    {
+        return false;
+    }
+    const internal::SharedMemoryRingSlot<Type>& slot =
+        slots_[uint64_t(index) % header_->capacity];
+    const uint64_t expected_sequence = 2 * uint64_t(index) + 2;
+
+    if (slot.sequence.load(std::memory_order_acquire) != expected_sequence)
+    {
+        return false;
+    }
+    std::memcpy(&record, &slot.record, sizeof(Type));
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    return slot.sequence.load(std::memory_order_relaxed) == expected_sequence;
+}
+
+template <typename Type>
+int64_t SharedMemoryRingReader<Type>::read_newest(Type& record) const
+{
+    // retry if the writer laps us while reading.
+    for (int attempt = 0; attempt < 10; attempt++)
+    {
+        int64_t index = newest_index();
+        if (index < 0)
+        {
+            return -1;
+        }
+        if (read(index, record))
+        {
+            return index;
+        }
+    }
+    return -1;
+}
+
+template <typename Type>
+bool SharedMemoryRingReader<Type>::wait_for_index(const int64_t& index,
+                                                  const double& timeout_s) const
+{
+    if (index < 0)
+    {
+        return true;
+    }
+    return internal::wait_for_ring_index(header_, index, timeout_s);
+}
+
+}  // namespace blmc_drivers
@@ -0,0 +1,125 @@
+/**
+ * @file thermal_limiter.hpp
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, Max Planck Gesellschaft.
+ * @brief I²t model of the winding temperature of a motor, limiting its
+ * current.
+ */
+#pragma once
+
+namespace blmc_drivers
+{
+/**
+ * @brief Parameters of a ThermalLimiter.
+ */
+struct ThermalLimiterParameters
+{
+    //! @brief Current the motor can carry indefinitely (A).
+    double continuous_current = 1.0;
+    //! @brief Current allowed while the motor is cold (A).
+    double peak_current = 2.0;
+    //! @brief Time constant of the winding (s).
+    double winding_time_constant_s = 20.0;
+    //! @brief Time constant of the housing (s), 0 to model the winding only.
+    double housing_time_constant_s = 0.0;
+    //! @brief Part of the steady-state temperature rise across the winding,
+    //! the rest is across the housing.  Ignored without housing.
+    double winding_fraction = 1.0;
+    //! @brief Load from which the limit is lowered from the peak current
+    //! towards the continuous current.
+    double derating_start = 0.8;
+};
+
+/**
+ * @brief Limits the current of a motor based on a model of its temperature,
+ * so that it can deliver short peaks above its continuous current.
+ *
+ * The temperature rise of the winding is modelled by (up to) two first order
+ * stages, the winding and the housing, driven by the power dissipated in the
+ * winding, i.e. by I².  It is expressed as load: the temperature rise
+ * relative to the one reached at the continuous current, so 1 is the
+ * hottest the motor is allowed to get.
+ *
+ * The limit is the peak current up to a load of derating_start and falls
+ * linearly to the continuous current at a load of 1, at which the motor stays
+ * in thermal equilibrium.  Each update costs two exponentials, and the state
+ * is a few doubles.
+ */
+class ThermalLimiter
+{
+public:
+    /**
+     * @brief Construct a new ThermalLimiter object for a cold motor.
+     *
+     * @throw std::invalid_argument if the parameters are inconsistent.
+     */
+    explicit ThermalLimiter(const ThermalLimiterParameters& parameters);
+
+    /**
+     * @brief Integrate the load over the time a current was applied.
+     *
+     * @param current (A) applied during the time step.
+     * @param dt_s is the length of the time step (s).
+     * @return double the current limit after the step (A).
+     */
+    double update(const double& current, const double& dt_s);
+
+    /**
+     * @brief Get the current limit (A) at the present load.
+     */
+    double get_current_limit() const
+    {
+        return current_limit_;
+    }
+
+    /**
+     * @brief Get the modelled temperature rise relative to the one at the
+     * continuous current.
+     */
+    double get_load() const
+    {
+        return winding_fraction_ * winding_load_ +
+               (1.0 - winding_fraction_) * housing_load_;
+    }
+
+    /**
+     * @brief Get the parameters.
+     */
+    const ThermalLimiterParameters& get_parameters() const
+    {
+        return parameters_;
+    }
+
+    /**
+     * @brief Set the motor to cold.
+     */
+    void reset();
+
+private:
+    /**
+     * @brief The parameters.
+     */
+    ThermalLimiterParameters parameters_;
+
+    /**
+     * @brief Part of the load across the winding (1 without housing).
+     */
+    double winding_fraction_;
+
+    /**
+     * @brief Load of the winding stage.
+     */
+    double winding_load_;
+
+    /**
+     * @brief Load of the housing stage.
+     */
+    double housing_load_;
+
+    /**
+     * @brief Current limit at the present load.
+     */
+    double current_limit_;
+};
+
+}  // namespace blmc_drivers
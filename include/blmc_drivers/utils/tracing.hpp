@@ -0,0 +1,190 @@
+/**
+ * @file tracing.hpp
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, Max Planck Gesellschaft.
+ * @brief Recording of the activity of the driver threads, exported as Chrome
+ * trace.
+ */
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace blmc_drivers
+{
+namespace internal
+{
+/**
+ * @brief If events are recorded, see set_tracing_enabled().
+ */
+extern std::atomic<bool> is_tracing_enabled;
+
+/**
+ * @brief Record an event of the calling thread.
+ *
+ * @param name of the event (a string literal).
+ * @param phase of the event in the Chrome trace format: 'B' (begin), 'E'
+ * (end) or 'i' (instant).
+ */
+void record_trace_event(const char* name, const char& phase);
+
+}  // namespace internal
+
+/**
+ * @brief Number of events kept per thread, newer ones overwrite the oldest.
+ */
+constexpr size_t TRACE_BUFFER_SIZE = 1 << 16;
+
+/**
+ * @brief Check if events are recorded.
+ */
+inline bool is_tracing_enabled()
+{
+    return internal::is_tracing_enabled.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Start or stop the recording of events.  Can be called at any time
+ * from any thread, but not from a real-time part: enabling allocates (and
+ * pre-faults) the buffers of the registered threads which have none yet.
+ * The buffers are kept until the end of the program.
+ */
+void set_tracing_enabled(const bool& is_enabled);
+
+/**
+ * @brief Record an instant event (e.g. the reception of a frame) on the
+ * calling thread.
+ *
+ * @param name of the event, has to outlive the trace (i.e. use a string
+ * literal).
+ */
+inline void trace_instant(const char* name)
+{
+    if (is_tracing_enabled())
+    {
+        internal::record_trace_event(name, 'i');
+    }
+}
+
+/**
+ * @brief Records the lifetime of the object as a slice of the calling thread,
+ * e.g. the decoding of a frame.  Slices can be nested.
+ *
+ * Each thread records into its own ring buffer of the newest
+ * TRACE_BUFFER_SIZE events, which set_tracing_enabled() allocates, so
+ * recording takes no lock and does not allocate.  Events of threads without
+ * name are dropped (see get_dropped_trace_event_count()).  When tracing is
+ * disabled, a scope costs one relaxed atomic load.
+ *
+ * Example:
+ * \code
+ * set_trace_thread_name("control");
+ * set_tracing_enabled(true);
+ * while (...)
+ * {
+ *     {
+ *         TraceScope trace_scope("control tick");
+ *         ...
+ *     }
+ *     spinner.spin();
+ * }
+ * write_chrome_trace("trace.json");
+ * \endcode
+ */
+class TraceScope
+{
+public:
+    /**
+     * @brief Begin the slice.
+     *
+     * @param name of the slice, has to outlive the trace (i.e. use a string
+     * literal).
+     */
+    explicit TraceScope(const char* name)
+        : name_(is_tracing_enabled() ? name : nullptr)
+    {
+        if (name_)
+        {
+            internal::record_trace_event(name_, 'B');
+        }
+    }
+
+    /**
+     * @brief End the slice, if it was begun while tracing was enabled.
+     */
+    ~TraceScope()
+    {
+        if (name_)
+        {
+            internal::record_trace_event(name_, 'E');
+        }
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    /**
+     * @brief Name of the slice, nullptr if tracing was disabled at its
+     * begin.
+     */
+    const char* name_;
+};
+
+/**
+ * @brief Register the calling thread for tracing, under the given name.
+ *
+ * The first call of a thread allocates a small entry and takes a lock, so
+ * call it at the start of the thread, before its real-time part.  The buffer
+ * of the events is only allocated while tracing is enabled, here or by
+ * set_tracing_enabled().  Later calls only rename the thread.
+ *
+ * @param name of the thread, has to outlive the trace (i.e. use a string
+ * literal).
+ */
+void set_trace_thread_name(const char* name);
+
+/**
+ * @brief Get the number of events which were dropped because their thread
+ * has no name (see set_trace_thread_name()).
+ */
+uint64_t get_dropped_trace_event_count();
+
+/**
+ * @brief Get the number of events which were overwritten by newer ones of
+ * their thread, since the last reset_trace().
+ */
+uint64_t get_overwritten_trace_event_count();
+
+/**
+ * @brief Write the recorded events in the Chrome trace event format (JSON),
+ * which can be opened in chrome://tracing or https://ui.perfetto.dev.
+ *
+ * Writes the newest TRACE_BUFFER_SIZE events of each thread, so a slice may
+ * miss its begin.  Can be called while events are recorded, the events
+ * recorded meanwhile may be missing.  Timestamps are in microseconds of
+ * CLOCK_MONOTONIC.
+ *
+ * @param stream to write to.
+ * @return size_t the number of written events.
+ */
+size_t write_chrome_trace(std::ostream& stream);
+
+/**
+ * @brief Write the recorded events to a file, see above.
+ *
+ * @param path of the file.
+ * @return false if the file could not be written.
+ */
+bool write_chrome_trace(const std::string& path);
+
+/**
+ * @brief Forget all recorded events.  Must not be called while tracing is
+ * enabled.
+ */
+void reset_trace();
+
+}  // namespace blmc_drivers
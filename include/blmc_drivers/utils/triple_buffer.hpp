@@ -0,0 +1,97 @@
+/**
+ * @file triple_buffer.hpp
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, Max Planck Gesellschaft.
+ * @brief Lock-free passing of the newest value from one thread to another.
+ */
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace blmc_drivers
+{
+/**
+ * @brief Passes the newest value from a writer thread to a reader thread
+ * without locks, e.g. setpoints from a user thread to a real-time loop.
+ *
+ * Writer and reader each own one of three buffers, the third one holds the
+ * newest written value which the reader did not take yet.  Both sides only
+ * exchange their buffer with the third one, so neither of them ever waits.
+ * Values written between two reads are dropped, only the newest one is read.
+ *
+ * There must be a single writer and a single reader at a time (the reader
+ * may change between reads if the reads are ordered, e.g. by a release /
+ * acquire pair).
+ *
+ * @tparam Type of the values, copied on write().
+ */
+template <typename Type>
+class TripleBuffer
+{
+public:
+    /**
+     * @brief Construct a new TripleBuffer object, get() returns a default
+     * constructed value until the first update().
+     */
+    TripleBuffer() : buffers_(), write_index_(0), middle_(1), read_index_(2)
+    {
+    }
+
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    /**
+     * @brief Publish a value (writer thread).
+     */
+    void write(const Type& value)
+    {
+        buffers_[write_index_] = value;
+        write_index_ =
+            middle_.exchange(write_index_ | IS_NEW, std::memory_order_acq_rel) &
+            INDEX_MASK;
+    }
+
+    /**
+     * @brief Take the newest written value, if there is one (reader thread).
+     *
+     * @return true if a value was written since the last update().
+     */
+    bool update()
+    {
+        if (!(middle_.load(std::memory_order_relaxed) & IS_NEW))
+        {
+            return false;
+        }
+        read_index_ =
+            middle_.exchange(read_index_, std::memory_order_acq_rel) &
+            INDEX_MASK;
+        return true;
+    }
+
+    /**
+     * @brief Get the value taken by the last update() (reader thread).
+     */
+    const Type& get() const
+    {
+        return buffers_[read_index_];
+    }
+
+private:
+    //! @brief Bits of middle_ holding the index of the buffer.
+    static constexpr uint8_t INDEX_MASK = 0x3;
+    //! @brief Bit of middle_ set if the writer wrote the buffer after the
+    //! last update().
+    static constexpr uint8_t IS_NEW = 0x4;
+
+    std::array<Type, 3> buffers_;
+    //! @brief Buffer of the writer.
+    uint8_t write_index_;
+    //! @brief Buffer not held by writer or reader, and the IS_NEW flag.
+    std::atomic<uint8_t> middle_;
+    //! @brief Buffer of the reader.
+    uint8_t read_index_;
+};
+
+}  // namespace blmc_drivers
@@ -9,9 +9,9 @@
  */
 
 #include "blmc_drivers/blmc_joint_module.hpp"
+#include <algorithm>
 #include <cmath>
 #include "real_time_tools/iostream.hpp"
-#include "real_time_tools/spinner.hpp"
 #include <execinfo.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -27,6 +27,12 @@ BlmcJointModule::BlmcJointModule(
     const double& max_current)
 {
     motor_ = motor;
+    for (size_t i = 0; i < measurements_.size(); i++)
+    {
+        measurements_[i] = motor_->get_measurement_channel(i);
+    }
+    sent_current_target_ = motor_->get_sent_current_target_channel();
+    encoder_index_events_ = motor_->get_encoder_index_events();
     motor_constant_ = motor_constant;
     gear_ratio_ = gear_ratio;
     set_zero_angle(zero_angle);
@@ -41,6 +47,16 @@ void BlmcJointModule::set_torque(const double& desired_torque)
 {
     double desired_current = joint_torque_to_motor_current(desired_torque);
 
+    if (friction_compensation_ && std::fabs(desired_current) <= max_current_)
+    {
+        desired_current += joint_torque_to_motor_current(
+            friction_compensation_->lookup(get_measured_angle(),
+                                           get_measured_velocity()));
+        // the compensation alone must not exceed the max. current.
+        desired_current =
+            std::max(-max_current_, std::min(desired_current, max_current_));
+    }
+
     if (std::fabs(desired_current) > max_current_)
     {
         std::cout << "something went wrong, it should never happen"
@@ -73,13 +89,12 @@ double BlmcJointModule::get_max_torque() const
 
 double BlmcJointModule::get_sent_torque() const
 {
-    auto measurement_history = motor_->get_sent_current_target();
-
-    if (measurement_history->length() == 0)
+    if (sent_current_target_.length() == 0)
     {
         return std::numeric_limits<double>::quiet_NaN();
     }
-    return motor_current_to_joint_torque(measurement_history->newest_element());
+    return motor_current_to_joint_torque(
+        sent_current_target_.newest_element());
 }
 
 double BlmcJointModule::get_measured_torque() const
@@ -112,6 +127,144 @@ double BlmcJointModule::get_measured_index_angle() const
     return get_motor_measurement(mi::encoder_index) / gear_ratio_;
 }
 
+bool BlmcJointModule::has_pending_encoder_index() const
+{
+    long int last_index;
+    return is_searching_encoder_index(last_index) &&
+           get_newest_encoder_index() > last_index;
+}
+
+bool BlmcJointModule::wait_for_pending_encoder_index(
+    const double& timeout_s) const
+{
+    long int last_index;
+    if (!encoder_index_events_ || !is_searching_encoder_index(last_index))
+    {
+        return has_pending_encoder_index();
+    }
+    return encoder_index_events_->wait_for_timeindex(last_index + 1,
+                                                     timeout_s);
+}
+
+bool BlmcJointModule::is_searching_encoder_index(long int& last_index) const
+{
+    if (homing_state_.status == HomingReturnCode::RUNNING)
+    {
+        last_index = homing_state_.last_encoder_index_time_index;
+        return true;
+    }
+    if (calibration_state_.status == CalibrationReturnCode::RUNNING &&
+        calibration_state_.is_searching_index)
+    {
+        last_index = calibration_state_.last_encoder_index_time_index;
+        return true;
+    }
+    return false;
+}
+
+long int BlmcJointModule::get_newest_encoder_index() const
+{
+    if (!encoder_index_events_)
+    {
+        return get_motor_measurement_index(mi::encoder_index);
+    }
+    if (encoder_index_events_->length() == 0)
+    {
+        return -1;
+    }
+    return encoder_index_events_->newest_timeindex(false);
+}
+
+bool BlmcJointModule::get_new_encoder_index(long int& last_index,
+                                            double& index_angle) const
+{
+    long int newest_index = get_newest_encoder_index();
+    if (newest_index <= last_index)
+    {
+        return false;
+    }
+    last_index = newest_index;
+
+    if (encoder_index_events_)
+    {
+        index_angle = polarity_ *
+                      (*encoder_index_events_)[newest_index].index_position /
+                      gear_ratio_;
+    }
+    else
+    {
+        index_angle = get_measured_index_angle();
+    }
+    return true;
+}
+
+long int BlmcJointModule::get_newest_position_index() const
+{
+    return get_motor_measurement_index(mi::position);
+}
+
+bool BlmcJointModule::get_motor_position_sample(const long int& time_index,
+                                                double& motor_position,
+                                                double& timestamp_s) const
+{
+    const ScalarChannel& measurement_history = measurements_[mi::position];
+
+    if (measurement_history.length() == 0 ||
+        time_index < measurement_history->oldest_timeindex(false) ||
+        time_index > measurement_history.newest_timeindex(false))
+    {
+        return false;
+    }
+    motor_position = polarity_ * measurement_history[time_index];
+    timestamp_s = measurement_history->timestamp_s(time_index);
+    return true;
+}
+
+bool BlmcJointModule::get_joint_sample(const mi& measurement_id,
+                                       const long int& time_index,
+                                       double& value,
+                                       double& timestamp_s) const
+{
+    const ScalarChannel& measurement_history = measurements_[measurement_id];
+
+    if (measurement_history.length() == 0 ||
+        time_index < measurement_history->oldest_timeindex(false) ||
+        time_index > measurement_history.newest_timeindex(false))
+    {
+        return false;
+    }
+    double motor_value = polarity_ * measurement_history[time_index];
+    switch (measurement_id)
+    {
+        case mi::current:
+            value = motor_current_to_joint_torque(motor_value);
+            break;
+        case mi::position:
+        case mi::encoder_index:
+            value = motor_position_to_joint_angle(motor_value);
+            break;
+        case mi::velocity:
+            value = motor_velocity_to_joint_velocity(motor_value);
+            break;
+        default:
+            return false;
+    }
+    timestamp_s = measurement_history->timestamp_s(time_index);
+    return true;
+}
+
+double BlmcJointModule::motor_position_to_joint_angle(
+    const double& motor_position) const
+{
+    return motor_position / gear_ratio_ - zero_angle_;
+}
+
+double BlmcJointModule::motor_velocity_to_joint_velocity(
+    const double& motor_velocity) const
+{
+    return motor_velocity / gear_ratio_;
+}
+
 double BlmcJointModule::get_zero_angle() const
 {
     return zero_angle_;
@@ -119,27 +272,27 @@ double BlmcJointModule::get_zero_angle() const
 
 double BlmcJointModule::get_motor_measurement(const mi& measurement_id) const
 {
-    auto measurement_history = motor_->get_measurement(measurement_id);
+    const ScalarChannel& measurement_history = measurements_[measurement_id];
 
-    if (measurement_history->length() == 0)
+    if (measurement_history.length() == 0)
     {
         // rt_printf("get_motor_measurement returns NaN\n");
         return std::numeric_limits<double>::quiet_NaN();
     }
-    return polarity_ * measurement_history->newest_element();
+    return polarity_ * measurement_history.newest_element();
 }
 
 long int BlmcJointModule::get_motor_measurement_index(
     const mi& measurement_id) const
 {
-    auto measurement_history = motor_->get_measurement(measurement_id);
+    const ScalarChannel& measurement_history = measurements_[measurement_id];
 
-    if (measurement_history->length() == 0)
+    if (measurement_history.length() == 0)
     {
         // rt_printf("get_motor_measurement_index returns NaN\n");
         return -1;
     }
-    return measurement_history->newest_timeindex();
+    return measurement_history.newest_timeindex();
 }
 
 void BlmcJointModule::set_position_control_gains(double kp, double kd)
@@ -178,132 +331,182 @@ double BlmcJointModule::execute_position_controller(
 
 bool BlmcJointModule::calibrate(double& angle_zero_to_index,
                                 double& index_angle,
-                                bool mechanical_calibration)
+                                bool mechanical_calibration,
+                                const CalibrationParameters& parameters)
 {
-    // save the current position
-    double starting_position = get_measured_angle();
-    rt_printf("Starting pose is=%f\n", starting_position);
-
-    // reset the ouput
-    index_angle = 0.0;
-
-    // we reset the internal zero angle.
-    zero_angle_ = 0.0;
+    init_calibration(
+        0, angle_zero_to_index, mechanical_calibration, parameters);
+    rt_printf("Starting pose is=%f\n", calibration_state_.start_position);
 
-    long int last_index_time = get_motor_measurement_index(mi::encoder_index);
-    if (std::isnan(last_index_time))
+    HybridSpinner spinner(parameters.control_period_s);
+    CalibrationReturnCode status;
+    do
     {
-        last_index_time = -1;
-    }
-    bool reached_next_index = false;
-    real_time_tools::Spinner spinner;
-    spinner.set_period(0.001);
-    rt_printf("Search for the index\n");
-    while (!reached_next_index)
-    {
-        // Small D gain
-        double k_d = 0.2;
-        // Small desired velocity
-        double joint_vel_des = 0.8;
-        // Velocity controller
-        double actual_velocity = get_measured_velocity();
-        double torque = +k_d * (joint_vel_des - actual_velocity);
-        // rt_printf("error=%f, vel_des=%f, vel=%f, tau=%f\n", joint_vel_des -
-        // actual_velocity, joint_vel_des, actual_velocity, torque); Send the
-        // torque command
-        set_torque(torque);
+        status = update_calibration();
         send_torque();
-        // check stop
-        long int actual_index_time =
-            get_motor_measurement_index(mi::encoder_index);
-        double actual_index_angle = get_measured_index_angle();
-
-        reached_next_index = (actual_index_time > last_index_time);
-        // rt_printf("last_index_time=%ld, actual_index_time=%ld,
-        // actual_index_angle=%f\n", last_index_time, actual_index_time,
-        // actual_index_angle);
-        if (reached_next_index)
-        {
-            index_angle = actual_index_angle;
-        }
         spinner.spin();
-    }
+    } while (status == CalibrationReturnCode::RUNNING);
+
     // reset the control to zero torque
     set_torque(0.0);
     send_torque();
     spinner.spin();
 
-    // get the indexes and stuff
-    if (mechanical_calibration)
-    {
-        angle_zero_to_index = index_angle - starting_position;
-    }
-    zero_angle_ = index_angle - angle_zero_to_index;
+    angle_zero_to_index = calibration_state_.angle_zero_to_index;
+    index_angle = calibration_state_.index_angle;
 
     rt_printf("Zero angle is=%f\n", zero_angle_);
     rt_printf("Zero angle to index angle is=%f\n", angle_zero_to_index);
     rt_printf("Index angle is=%f\n", index_angle);
+    rt_printf("Final angle is=%f\n", get_measured_angle());
 
-    rt_printf("Position Control\n");
-    // Go to 0
-    double init_pose = get_measured_angle();
-    double final_pose = 0.0;
-    double final_angle = 0.0;
-    int traj_time = 2.0 / 0.001;
-    int counter = 0;
-    double torque_int = 0.0;
-    double torque_sat = 0.1;  // Nm
-    bool reached_zero_pose = 0;
-    while (!reached_zero_pose)
+    return status == CalibrationReturnCode::SUCCEEDED;
+}
+
+void BlmcJointModule::init_calibration(int joint_id,
+                                       double angle_zero_to_index,
+                                       bool mechanical_calibration,
+                                       const CalibrationParameters& parameters)
+{
+    // reset the internal zero angle.
+    set_zero_angle(0.0);
+
+    CalibrationState& state = calibration_state_;
+    state.joint_id = joint_id;
+    state.parameters = parameters;
+    state.mechanical_calibration = mechanical_calibration;
+    state.angle_zero_to_index = angle_zero_to_index;
+    state.index_angle = 0.0;
+    state.start_position = get_measured_angle();
+    state.return_start_position = 0.0;
+    state.last_encoder_index_time_index = get_newest_encoder_index();
+    state.is_searching_index = true;
+    state.step_count = 0;
+    state.torque_integral = 0.0;
+    state.status = CalibrationReturnCode::RUNNING;
+}
+
+CalibrationReturnCode BlmcJointModule::update_calibration()
+{
+    CalibrationState& state = calibration_state_;
+    const CalibrationParameters& parameters = state.parameters;
+
+    switch (state.status)
     {
-        // Small P gain
-        double k_p = 2.5;
-        // Integrale gain
-        double k_i = 0.5;
-        // desired pose
-        double alpha = 1.0 - (double)((double)counter / (double)traj_time);
-        double des_angle = alpha * init_pose + (1.0 - alpha) * final_pose;
-        // compute the error
-        double current_angle = get_measured_angle();
-        double err = des_angle - current_angle;
-        // small saturation in intensity
-        torque_int += k_i * err * 0.001;  // 1 ms sampling period
-        if (torque_int > torque_sat)
-        {
-            torque_int = torque_sat;
-        }
-        if (torque_int < -torque_sat)
-        {
-            torque_int = -torque_sat;
-        }
-        // Position controller
-        double torque = k_p * err + torque_int;
-        // rt_printf("error=%f, torque_int=%f, tau=%f\n", err, torque_int,
-        // torque); Send the torque command
-        set_torque(torque);
-        send_torque();
-        // check out
-        reached_zero_pose =
-            (std::fabs(current_angle) <= 1e-2);  // nearly 0.1 degree
-        if (reached_zero_pose)
-        {
-            final_angle = -err;
-        }
-        spinner.spin();
-        ++counter;
-        if (counter > traj_time)
+        case CalibrationReturnCode::NOT_INITIALIZED:
+            set_torque(0.0);
+            send_torque();
+            rt_printf("[%d] Calibration is not initialized.  Abort.\n",
+                      state.joint_id);
+            break;
+
+        case CalibrationReturnCode::FAILED:
+            // when failed, send zero-torque commands
+            set_torque(0.0);
+            break;
+
+        case CalibrationReturnCode::SUCCEEDED:
+            // when succeeded, keep the joint at the zero position
+            set_torque(execute_calibration_controller(0.0));
+            break;
+
+        case CalibrationReturnCode::RUNNING:
         {
-            counter = traj_time;
+            const double elapsed_s =
+                state.step_count * parameters.control_period_s;
+
+            if (state.is_searching_index)
+            {
+                if (elapsed_s >= parameters.timeout_s)
+                {
+                    set_torque(0.0);
+                    state.status = CalibrationReturnCode::FAILED;
+                    rt_printf(
+                        "BlmcJointModule::update_calibration(): "
+                        "ERROR: Failed to find index with joint [%d].\n",
+                        state.joint_id);
+                    break;
+                }
+                state.step_count++;
+
+                // velocity controller
+                const double max_torque = 0.9 * get_max_torque();
+                double torque =
+                    parameters.search_gain_d *
+                    (parameters.search_velocity - get_measured_velocity());
+                set_torque(std::max(-max_torque, std::min(torque, max_torque)));
+
+                // check if a new encoder index was observed
+                if (get_new_encoder_index(state.last_encoder_index_time_index,
+                                          state.index_angle))
+                {
+                    if (state.mechanical_calibration)
+                    {
+                        state.angle_zero_to_index =
+                            state.index_angle - state.start_position;
+                    }
+                    set_zero_angle(state.index_angle -
+                                   state.angle_zero_to_index);
+
+                    state.is_searching_index = false;
+                    state.step_count = 0;
+                    state.torque_integral = 0.0;
+                    state.return_start_position = get_measured_angle();
+                }
+                break;
+            }
+
+            if (elapsed_s >=
+                parameters.return_duration_s + parameters.timeout_s)
+            {
+                set_torque(0.0);
+                state.status = CalibrationReturnCode::FAILED;
+                rt_printf(
+                    "BlmcJointModule::update_calibration(): "
+                    "ERROR: Joint [%d] did not reach the zero position.\n",
+                    state.joint_id);
+                break;
+            }
+            state.step_count++;
+
+            // linear trajectory to the zero position
+            double alpha = 1.0;
+            if (parameters.return_duration_s > 0)
+            {
+                alpha = std::min(elapsed_s / parameters.return_duration_s, 1.0);
+            }
+            set_torque(execute_calibration_controller(
+                (1.0 - alpha) * state.return_start_position));
+
+            if (std::fabs(get_measured_angle()) <=
+                parameters.position_tolerance)
+            {
+                state.status = CalibrationReturnCode::SUCCEEDED;
+            }
+            break;
         }
     }
-    rt_printf("Final angle is=%f\n", final_angle);
-    // reset the control to zero torque
-    set_torque(0.0);
-    send_torque();
-    spinner.spin();
 
-    // FIXME: always returns true as there is no error checking
-    return true;
+    return state.status;
+}
+
+double BlmcJointModule::execute_calibration_controller(
+    double target_position_rad)
+{
+    CalibrationState& state = calibration_state_;
+    const CalibrationParameters& parameters = state.parameters;
+
+    double error = target_position_rad - get_measured_angle();
+    state.torque_integral +=
+        parameters.gain_i * error * parameters.control_period_s;
+    state.torque_integral =
+        std::max(-parameters.max_torque_integral,
+                 std::min(state.torque_integral,
+                          parameters.max_torque_integral));
+
+    const double max_torque = 0.9 * get_max_torque();
+    double torque = parameters.gain_p * error + state.torque_integral;
+    return std::max(-max_torque, std::min(torque, max_torque));
 }
 
 void BlmcJointModule::homing_at_current_position(double home_offset_rad)
@@ -332,8 +535,7 @@ void BlmcJointModule::init_homing(int joint_id,
     homing_state_.search_distance_limit_rad = search_distance_limit_rad;
     homing_state_.home_offset_rad = home_offset_rad;
     homing_state_.profile_step_size_rad = profile_step_size_rad;
-    homing_state_.last_encoder_index_time_index =
-        get_motor_measurement_index(mi::encoder_index);
+    homing_state_.last_encoder_index_time_index = get_newest_encoder_index();
     homing_state_.target_position_rad = get_measured_angle();
     homing_state_.step_count = 0;
     homing_state_.start_position = get_measured_angle();
@@ -418,12 +620,11 @@ HomingReturnCode BlmcJointModule::update_homing()
             set_torque(desired_torque);
 
             // Check if new encoder index was observed
-            const long int actual_index_time =
-                get_motor_measurement_index(mi::encoder_index);
-            if (actual_index_time > homing_state_.last_encoder_index_time_index)
+            double index_angle;
+            if (get_new_encoder_index(
+                    homing_state_.last_encoder_index_time_index, index_angle))
             {
                 // -- FINISHED
-                const double index_angle = get_measured_index_angle();
 
                 // Store the end position of the homing so it can be used to
                 // determine the travelled distance.
@@ -454,6 +655,191 @@ HomingReturnCode BlmcJointModule::update_homing()
     return homing_state_.status;
 }
 
+void BlmcJointModule::init_friction_calibration(
+    const FrictionCalibrationParameters& parameters)
+{
+    FrictionCalibrationState& state = friction_calibration_state_;
+    state.parameters = parameters;
+    state.table = std::make_shared<FrictionTable>(
+        parameters.position_min,
+        parameters.position_max,
+        parameters.position_node_count,
+        parameters.is_periodic,
+        parameters.max_velocity,
+        2 * parameters.velocity_level_count + 1);
+    state.torque_sums.assign(parameters.position_node_count *
+                                 state.table->get_velocity_node_count(),
+                             0.0);
+    state.sample_counts.assign(state.torque_sums.size(), 0);
+    state.velocity_level = 1;
+    state.direction = -1.0;
+    state.is_approaching = true;
+    state.torque_integral = 0.0;
+    state.step_count = 0;
+    state.status = CalibrationReturnCode::RUNNING;
+
+    friction_compensation_ = nullptr;
+}
+
+CalibrationReturnCode BlmcJointModule::update_friction_calibration()
+{
+    FrictionCalibrationState& state = friction_calibration_state_;
+    const FrictionCalibrationParameters& parameters = state.parameters;
+
+    if (state.status != CalibrationReturnCode::RUNNING)
+    {
+        set_torque(0.0);
+        return state.status;
+    }
+
+    double angle = get_measured_angle();
+    double velocity = get_measured_velocity();
+    if (std::isnan(angle) || std::isnan(velocity))
+    {
+        // no measurement yet.
+        set_torque(0.0);
+        return state.status;
+    }
+
+    // reverse at the ends of the range, after the way back go faster.
+    if ((state.direction > 0 && angle >= parameters.position_max) ||
+        (state.direction < 0 && angle <= parameters.position_min))
+    {
+        if (state.direction < 0 && state.is_approaching)
+        {
+            state.is_approaching = false;
+        }
+        else if (state.direction < 0)
+        {
+            state.velocity_level++;
+        }
+        if (state.velocity_level > parameters.velocity_level_count)
+        {
+            set_torque(0.0);
+            build_friction_table();
+            state.status = CalibrationReturnCode::SUCCEEDED;
+            return state.status;
+        }
+        state.direction = -state.direction;
+        // the friction changes sign with the direction.
+        state.torque_integral = -state.torque_integral;
+        state.step_count = 0;
+    }
+
+    double target_velocity = state.direction * parameters.max_velocity *
+                             state.velocity_level /
+                             parameters.velocity_level_count;
+    double elapsed_s = state.step_count * parameters.control_period_s;
+    double max_sweep_s = 2 *
+                             (parameters.position_max -
+                              parameters.position_min) /
+                             std::fabs(target_velocity) +
+                         1.0;
+    if (elapsed_s > max_sweep_s)
+    {
+        set_torque(0.0);
+        state.status = CalibrationReturnCode::FAILED;
+        rt_printf(
+            "BlmcJointModule::update_friction_calibration(): "
+            "ERROR: sweep at %f rad/s did not reach the end of the range.\n",
+            target_velocity);
+        return state.status;
+    }
+    state.step_count++;
+
+    // PI velocity controller.
+    const double max_torque =
+        std::min(parameters.max_torque, get_max_torque() * 0.9);
+    double velocity_error = target_velocity - velocity;
+    state.torque_integral +=
+        parameters.gain_i * velocity_error * parameters.control_period_s;
+    state.torque_integral =
+        std::max(-max_torque, std::min(state.torque_integral, max_torque));
+    double torque = parameters.gain_p * velocity_error + state.torque_integral;
+    set_torque(std::max(-max_torque, std::min(torque, max_torque)));
+
+    // sample the torque needed at constant velocity.
+    if (!state.is_approaching && elapsed_s >= parameters.settling_time_s &&
+        std::fabs(velocity_error) <=
+            parameters.velocity_tolerance * std::fabs(target_velocity) &&
+        angle >= parameters.position_min && angle <= parameters.position_max)
+    {
+        size_t velocity_node =
+            state.direction > 0
+                ? parameters.velocity_level_count + state.velocity_level
+                : parameters.velocity_level_count - state.velocity_level;
+        size_t node = state.table->get_position_node(angle) *
+                          state.table->get_velocity_node_count() +
+                      velocity_node;
+        state.torque_sums[node] += get_measured_torque();
+        state.sample_counts[node]++;
+    }
+
+    return state.status;
+}
+
+void BlmcJointModule::build_friction_table()
+{
+    FrictionCalibrationState& state = friction_calibration_state_;
+    FrictionTable& table = *state.table;
+    const size_t position_node_count = table.get_position_node_count();
+    const size_t velocity_node_count = table.get_velocity_node_count();
+    const size_t zero_velocity_node = velocity_node_count / 2;
+
+    // index of the node if the given position node was visited.
+    auto find_visited_node = [&](long int position_node,
+                                 const size_t& velocity_node,
+                                 size_t& node) {
+        long int count = position_node_count;
+        if (table.is_periodic())
+        {
+            position_node = (position_node % count + count) % count;
+        }
+        else if (position_node < 0 || position_node >= count)
+        {
+            return false;
+        }
+        node = position_node * velocity_node_count + velocity_node;
+        return state.sample_counts[node] > 0;
+    };
+
+    for (size_t j = 0; j < velocity_node_count; j++)
+    {
+        if (j == zero_velocity_node)
+        {
+            continue;
+        }
+        // every node gets the mean of the closest visited position node.
+        for (size_t i = 0; i < position_node_count; i++)
+        {
+            for (size_t distance = 0; distance < position_node_count;
+                 distance++)
+            {
+                size_t node;
+                if (find_visited_node(long(i) - long(distance), j, node) ||
+                    find_visited_node(long(i) + long(distance), j, node))
+                {
+                    table.set_value(i,
+                                    j,
+                                    state.torque_sums[node] /
+                                        state.sample_counts[node]);
+                    break;
+                }
+            }
+        }
+    }
+
+    // at standstill only the cogging, which is the same in both directions.
+    for (size_t i = 0; i < position_node_count; i++)
+    {
+        table.set_value(i,
+                        zero_velocity_node,
+                        (table.get_value(i, zero_velocity_node - 1) +
+                         table.get_value(i, zero_velocity_node + 1)) /
+                            2);
+    }
+}
+
 double BlmcJointModule::get_distance_travelled_during_homing() const
 {
     if (homing_state_.status != HomingReturnCode::SUCCEEDED)
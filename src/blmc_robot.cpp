@@ -0,0 +1,221 @@
+/**
+ * @file blmc_robot.cpp
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, Max Planck Gesellschaft.
+ * @brief Drivers of a whole robot, instantiated from a RobotDescription.
+ */
+
+#include "blmc_drivers/blmc_robot.hpp"
+
+#include <future>
+#include <stdexcept>
+
+#include <real_time_tools/iostream.hpp>
+#include <real_time_tools/timer.hpp>
+
+#include "blmc_drivers/devices/loopback_can_bus.hpp"
+
+namespace blmc_drivers
+{
+namespace
+{
+/**
+ * @brief Get the index of the description with the given name.
+ *
+ * @throw std::invalid_argument if there is none.
+ */
+template <typename Description>
+size_t find_index(const std::vector<Description>& descriptions,
+                  const std::string& name,
+                  const std::string& kind)
+{
+    for (size_t i = 0; i < descriptions.size(); i++)
+    {
+        if (descriptions[i].name == name)
+        {
+            return i;
+        }
+    }
+    throw std::invalid_argument("robot has no " + kind + " \"" + name + "\"");
+}
+
+}  // namespace
+
+BlmcRobot::BlmcRobot(const RobotDescription& description)
+    : description_(description)
+{
+    double start_time_s = real_time_tools::Timer::get_current_time_sec();
+
+    // buses and boards, in parallel ---------------------------------------
+    can_buses_.resize(description_.buses.size());
+    motor_boards_.resize(description_.boards.size());
+    std::vector<std::future<void>> bring_ups;
+    for (size_t i = 0; i < description_.buses.size(); i++)
+    {
+        bring_ups.push_back(std::async(
+            std::launch::async, &BlmcRobot::bring_up_bus, this, i));
+    }
+    // wait for all of them before rethrowing the first error, so that no
+    // thread is left running.
+    for (std::future<void>& bring_up : bring_ups)
+    {
+        bring_up.wait();
+    }
+    for (std::future<void>& bring_up : bring_ups)
+    {
+        bring_up.get();
+    }
+
+    // motors, sensors and joints ------------------------------------------
+    const size_t joint_count = description_.joints.size();
+    JointModules::MotorArray motors(joint_count);
+    JointModules::Vector motor_constants(joint_count);
+    JointModules::Vector gear_ratios(joint_count);
+    JointModules::Vector zero_angles(joint_count);
+    JointModules::Vector max_currents(joint_count);
+    JointModules::Array<bool> reverse_polarities(joint_count);
+    for (size_t i = 0; i < joint_count; i++)
+    {
+        const JointDescription& joint = description_.joints[i];
+        size_t board_index =
+            find_index(description_.boards, joint.board, "board");
+        motors_.push_back(
+            std::make_shared<SafeMotor>(motor_boards_[board_index],
+                                        joint.motor_index,
+                                        joint.max_current,
+                                        joint.history_length,
+                                        joint.max_velocity));
+        if (joint.continuous_current > 0)
+        {
+            ThermalLimiterParameters thermal_parameters;
+            thermal_parameters.continuous_current = joint.continuous_current;
+            thermal_parameters.peak_current = joint.max_current;
+            thermal_parameters.winding_time_constant_s =
+                joint.winding_time_constant_s;
+            thermal_parameters.housing_time_constant_s =
+                joint.housing_time_constant_s;
+            thermal_parameters.winding_fraction = joint.winding_fraction;
+            motors_.back()->enable_thermal_limit(thermal_parameters);
+        }
+        motors[i] = motors_.back();
+        motor_constants[i] = joint.motor_constant;
+        gear_ratios[i] = joint.gear_ratio;
+        zero_angles[i] = joint.zero_angle;
+        max_currents[i] = joint.max_current;
+        reverse_polarities[i] = joint.reverse_polarity;
+    }
+    joint_modules_ = std::make_shared<JointModules>(
+        motors, motor_constants, gear_ratios, zero_angles, max_currents);
+    joint_modules_->set_joint_polarities(reverse_polarities);
+
+    for (const AnalogSensorDescription& sensor : description_.analog_sensors)
+    {
+        size_t board_index =
+            find_index(description_.boards, sensor.board, "board");
+        analog_sensors_.push_back(std::make_shared<AnalogSensor>(
+            motor_boards_[board_index], sensor.sensor_index));
+    }
+
+    // streams -------------------------------------------------------------
+    for (size_t i = 0; i < description_.boards.size(); i++)
+    {
+        const MotorBoardDescription& board = description_.boards[i];
+        if (!board.publish.empty())
+        {
+            size_t bus_index = find_index(description_.buses, board.bus, "bus");
+            publishers_.push_back(std::make_unique<MotorBoardStatePublisher>(
+                motor_boards_[i], can_buses_[bus_index], board.publish));
+        }
+        if (!board.serve.empty())
+        {
+            servers_.push_back(
+                std::make_unique<MotorBoardServer>(motor_boards_[i],
+                                                   board.serve));
+        }
+    }
+
+    bring_up_duration_s_ =
+        real_time_tools::Timer::get_current_time_sec() - start_time_s;
+    rt_printf("robot with %lu joints on %lu buses is up after %.3f s\n",
+              (unsigned long)joint_count,
+              (unsigned long)can_buses_.size(),
+              bring_up_duration_s_);
+}
+
+BlmcRobot::~BlmcRobot()
+{
+    // stop serving before the boards are disabled.
+    servers_.clear();
+    publishers_.clear();
+}
+
+void BlmcRobot::bring_up_bus(const size_t& bus_index)
+{
+    const CanBusDescription& bus = description_.buses[bus_index];
+    if (bus.interface == "loopback")
+    {
+        can_buses_[bus_index] =
+            std::make_shared<LoopbackCanBus>(bus.history_length);
+    }
+    else
+    {
+        can_buses_[bus_index] = std::make_shared<CanBus>(bus.interface,
+                                                         bus.history_length,
+                                                         bus.cpu_id,
+                                                         bus.bitrate,
+                                                         bus.priority);
+    }
+
+    for (size_t i = 0; i < description_.boards.size(); i++)
+    {
+        const MotorBoardDescription& board = description_.boards[i];
+        if (board.bus != bus.name)
+        {
+            continue;
+        }
+        motor_boards_[i] =
+            std::make_shared<CanBusMotorBoard>(can_buses_[bus_index],
+                                               board.history_length,
+                                               board.control_timeout_ms,
+                                               board.cpu_id,
+                                               board.priority);
+        motor_boards_[i]->wait_until_ready();
+    }
+}
+
+std::vector<std::string> BlmcRobot::get_joint_names() const
+{
+    std::vector<std::string> names;
+    for (const JointDescription& joint : description_.joints)
+    {
+        names.push_back(joint.name);
+    }
+    return names;
+}
+
+std::shared_ptr<CanBusInterface> BlmcRobot::get_can_bus(
+    const std::string& name) const
+{
+    return can_buses_[find_index(description_.buses, name, "bus")];
+}
+
+std::shared_ptr<CanBusMotorBoard> BlmcRobot::get_motor_board(
+    const std::string& name) const
+{
+    return motor_boards_[find_index(description_.boards, name, "board")];
+}
+
+std::shared_ptr<SafeMotor> BlmcRobot::get_motor(
+    const std::string& joint_name) const
+{
+    return motors_[find_index(description_.joints, joint_name, "joint")];
+}
+
+std::shared_ptr<AnalogSensor> BlmcRobot::get_analog_sensor(
+    const std::string& name) const
+{
+    return analog_sensors_[find_index(
+        description_.analog_sensors, name, "sensor")];
+}
+
+}  // namespace blmc_drivers
@@ -13,13 +13,226 @@
 
 #include <sstream>
 
+#ifndef __XENO__
+#include <linux/can/netlink.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#endif
+
 #include <blmc_drivers/devices/can_bus.hpp>
+#include <blmc_drivers/utils/rt_safety.hpp>
+#include <blmc_drivers/utils/tracing.hpp>
 
 namespace blmc_drivers
 {
+#ifndef __XENO__
+namespace
+{
+/**
+ * @brief Append a netlink attribute to a message.
+ *
+ * @return rtattr* the attribute, to add nested attributes.
+ */
+struct rtattr *add_netlink_attribute(struct nlmsghdr *header,
+                                     const size_t &max_length,
+                                     const unsigned short &type,
+                                     const void *data,
+                                     const size_t &data_length)
+{
+    size_t length = RTA_LENGTH(data_length);
+    if (NLMSG_ALIGN(header->nlmsg_len) + RTA_ALIGN(length) > max_length)
+    {
+        return nullptr;
+    }
+    struct rtattr *attribute =
+        (struct rtattr *)(((char *)header) + NLMSG_ALIGN(header->nlmsg_len));
+    attribute->rta_type = type;
+    attribute->rta_len = length;
+    if (data_length > 0)
+    {
+        memcpy(RTA_DATA(attribute), data, data_length);
+    }
+    header->nlmsg_len = NLMSG_ALIGN(header->nlmsg_len) + RTA_ALIGN(length);
+    return attribute;
+}
+
+/**
+ * @brief Restart a CAN controller which is bus-off, like
+ * "ip link set <name> type can restart".  Needs CAP_NET_ADMIN.
+ *
+ * @param interface_index is the index of the network interface.
+ * @return int 0 on success, the error code otherwise.
+ */
+int request_can_restart(const int &interface_index)
+{
+    struct
+    {
+        struct nlmsghdr header;
+        struct ifinfomsg info;
+        char attributes[128];
+    } request;
+    memset(&request, 0, sizeof(request));
+    request.header.nlmsg_len = NLMSG_LENGTH(sizeof(struct ifinfomsg));
+    request.header.nlmsg_type = RTM_NEWLINK;
+    request.header.nlmsg_flags = NLM_F_REQUEST | NLM_F_ACK;
+    request.info.ifi_family = AF_UNSPEC;
+    request.info.ifi_index = interface_index;
+
+    // IFLA_LINKINFO { IFLA_INFO_KIND "can", IFLA_INFO_DATA { IFLA_CAN_RESTART } }
+    const char kind[] = "can";
+    const uint32_t restart = 1;
+    struct rtattr *link_info = add_netlink_attribute(
+        &request.header, sizeof(request), IFLA_LINKINFO, nullptr, 0);
+    add_netlink_attribute(
+        &request.header, sizeof(request), IFLA_INFO_KIND, kind, strlen(kind));
+    struct rtattr *info_data = add_netlink_attribute(
+        &request.header, sizeof(request), IFLA_INFO_DATA, nullptr, 0);
+    add_netlink_attribute(&request.header,
+                          sizeof(request),
+                          IFLA_CAN_RESTART,
+                          &restart,
+                          sizeof(restart));
+    char *end = ((char *)&request.header) + request.header.nlmsg_len;
+    info_data->rta_len = end - (char *)info_data;
+    link_info->rta_len = end - (char *)link_info;
+
+    int netlink_socket = socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC,
+                                NETLINK_ROUTE);
+    if (netlink_socket < 0)
+    {
+        return errno;
+    }
+    if (send(netlink_socket, &request, request.header.nlmsg_len, 0) < 0)
+    {
+        int error = errno;
+        close(netlink_socket);
+        return error;
+    }
+
+    // the acknowledgement carries the result.
+    char answer[256];
+    ssize_t answer_length = recv(netlink_socket, answer, sizeof(answer), 0);
+    int error = answer_length < 0 ? errno : EPROTO;
+    close(netlink_socket);
+    if (answer_length >= ssize_t(NLMSG_LENGTH(sizeof(struct nlmsgerr))))
+    {
+        struct nlmsghdr *answer_header = (struct nlmsghdr *)answer;
+        if (answer_header->nlmsg_type == NLMSG_ERROR)
+        {
+            error = -((struct nlmsgerr *)NLMSG_DATA(answer_header))->error;
+        }
+    }
+    return error;
+}
+
+}  // namespace
+#endif
+
+CanControllerMonitor::CanControllerMonitor(const std::string &name,
+                                           const double &restart_delay_s)
+    : name_(name),
+      restart_delay_s_(restart_delay_s),
+      state_(CanBusInterface::ERROR_ACTIVE),
+      bus_off_count_(0),
+      bus_off_time_s_(0)
+{
+}
+
+bool CanControllerMonitor::process_error_frame(const CanBusFrame &error_frame,
+                                               const double &time_s)
+{
+    if (error_frame.id & CAN_ERR_BUSOFF)
+    {
+        if (get_state() == CanBusInterface::BUS_OFF)
+        {
+            return false;
+        }
+        bus_off_count_++;
+        bus_off_time_s_ = time_s;
+        set_state(CanBusInterface::BUS_OFF);
+        return true;
+    }
+    if (error_frame.id & CAN_ERR_RESTARTED)
+    {
+        set_state(CanBusInterface::ERROR_ACTIVE);
+        return false;
+    }
+    if (error_frame.id & CAN_ERR_CRTL)
+    {
+        uint8_t controller_error = error_frame.data[1];
+        if (controller_error &
+            (CAN_ERR_CRTL_RX_PASSIVE | CAN_ERR_CRTL_TX_PASSIVE))
+        {
+            set_state(CanBusInterface::ERROR_PASSIVE);
+        }
+        else if (controller_error &
+                 (CAN_ERR_CRTL_RX_WARNING | CAN_ERR_CRTL_TX_WARNING))
+        {
+            set_state(CanBusInterface::ERROR_WARNING);
+        }
+        else if (controller_error & CAN_ERR_CRTL_ACTIVE)
+        {
+            set_state(CanBusInterface::ERROR_ACTIVE);
+        }
+        if (controller_error &
+            (CAN_ERR_CRTL_RX_OVERFLOW | CAN_ERR_CRTL_TX_OVERFLOW))
+        {
+            rt_printf("CAN controller of %s reports a buffer overflow\n",
+                      name_.c_str());
+        }
+    }
+    if (error_frame.id & CAN_ERR_TX_TIMEOUT)
+    {
+        rt_printf("CAN transmit timeout on %s\n", name_.c_str());
+    }
+    return false;
+}
+
+void CanControllerMonitor::process_frame()
+{
+    if (get_state() == CanBusInterface::BUS_OFF)
+    {
+        // frames are received again, so the controller was restarted.
+        set_state(CanBusInterface::ERROR_ACTIVE);
+    }
+}
+
+bool CanControllerMonitor::should_restart(const double &time_s)
+{
+    if (get_state() != CanBusInterface::BUS_OFF ||
+        time_s - bus_off_time_s_ < restart_delay_s_)
+    {
+        return false;
+    }
+    bus_off_time_s_ = time_s;
+    return true;
+}
+
+void CanControllerMonitor::set_state(
+    const CanBusInterface::ControllerState &state)
+{
+    static const char *state_names[] = {
+        "error active", "error warning", "error passive", "bus-off"};
+
+    int previous_state = state_.exchange(state);
+    if (previous_state != state)
+    {
+        rt_printf("CAN controller of %s: %s -> %s\n",
+                  name_.c_str(),
+                  state_names[previous_state],
+                  state_names[state]);
+    }
+}
+
 CanBus::CanBus(const std::string &can_interface_name,
                const size_t &history_length,
-	       const int& cpu_id)
+	       const int& cpu_id,
+               const double& bitrate,
+               const int& priority)
+    : statistics_(bitrate),
+      controller_monitor_(can_interface_name, BUS_OFF_RESTART_DELAY_S)
 {
     input_ = std::make_shared<CanframeTimeseries>(history_length, 0, false);
     sent_input_ =
@@ -27,20 +240,55 @@ CanBus::CanBus(const std::string &can_interface_name,
     output_ = std::make_shared<CanframeTimeseries>(history_length, 0, false);
     name_ = can_interface_name;
 
-    can_connection_.set(setup_can(can_interface_name, 0));
+    // get notified about the state of the controller.
+    can_connection_.set(setup_can(can_interface_name,
+                                  CAN_ERR_TX_TIMEOUT | CAN_ERR_CRTL |
+                                      CAN_ERR_BUSOFF | CAN_ERR_RESTARTED));
+    statistics_.reset(real_time_tools::Timer::get_current_time_sec());
+
+#ifdef __XENO__
+    wakeup_fd_ = -1;
+#else
+    wakeup_fd_ = eventfd(0, EFD_CLOEXEC);
+    if (wakeup_fd_ < 0)
+    {
+        rt_printf("Couldn't create eventfd, destroying the CanBus waits for "
+                  "the next frame.\n");
+    }
+#endif
 
     is_loop_active_ = true;
-    if (cpu_id > 0){
+    if (cpu_id >= 0){
     	rt_thread_.parameters_.cpu_id_.push_back(cpu_id);
     	rt_thread_.parameters_.priority_ = 90;
     }
+    if (priority >= 0)
+    {
+        rt_thread_.parameters_.priority_ = priority;
+    }
     rt_thread_.create_realtime_thread(&CanBus::loop, this);
 }
 
 CanBus::~CanBus()
 {
     is_loop_active_ = false;
+#ifndef __XENO__
+    if (wakeup_fd_ >= 0)
+    {
+        uint64_t one = 1;
+        if (write(wakeup_fd_, &one, sizeof(one)) != sizeof(one))
+        {
+            rt_printf("Couldn't wake up the CanBus loop.\n");
+        }
+    }
+#endif
     rt_thread_.join();
+#ifndef __XENO__
+    if (wakeup_fd_ >= 0)
+    {
+        close(wakeup_fd_);
+    }
+#endif
     osi::close_can_device(can_connection_.get().socket);
 }
 
@@ -48,24 +296,106 @@ void CanBus::send_if_input_changed()
 {
     if (input_->has_changed_since_tag())
     {
+        TraceScope trace_scope("CanBus::send");
         time_series::Index timeindex_to_send = input_->newest_timeindex();
         CanBusFrame frame_to_send = (*input_)[timeindex_to_send];
         input_->tag(timeindex_to_send);
         sent_input_->append(frame_to_send);
 
         send_frame(frame_to_send);
+        send_latency_.record(real_time_tools::Timer::get_current_time_sec() -
+                             input_->timestamp_s(timeindex_to_send));
     }
 }
 
 void CanBus::loop()
 {
+    set_trace_thread_name("CanBus::loop");
     while (is_loop_active_)
     {
-	CanBusFrame recv_frame = receive_frame();
-        output_->append(recv_frame);
+        if (!wait_for_frame())
+        {
+            continue;
+        }
+        RtSection rt_section("CanBus::loop");
+        CanBusFrame recv_frame;
+        bool is_received;
+        {
+            TraceScope trace_scope("CanBus::recvmsg");
+            is_received = receive_frame(recv_frame);
+        }
+        if (!is_received)
+        {
+            continue;
+        }
+        if (recv_frame.id & CAN_ERR_FLAG)
+        {
+            if (controller_monitor_.process_error_frame(
+                    recv_frame, real_time_tools::Timer::get_current_time_sec()))
+            {
+#ifdef __XENO__
+                // there is no timed wake-up, restart right away.
+                restart_controller();
+#endif
+            }
+            continue;
+        }
+        controller_monitor_.process_frame();
+        {
+            TraceScope trace_scope("CanBus::append");
+            output_->append(recv_frame);
+        }
+        statistics_.record_received(
+            recv_frame.id,
+            recv_frame.dlc,
+            real_time_tools::Timer::get_current_time_sec());
     }
 }
 
+bool CanBus::wait_for_frame()
+{
+#ifdef __XENO__
+    // receive_frame() blocks.
+    return true;
+#else
+    if (wakeup_fd_ < 0)
+    {
+        return true;
+    }
+
+    struct pollfd poll_fds[2];
+    poll_fds[0].fd = can_connection_.get().socket;
+    poll_fds[0].events = POLLIN;
+    poll_fds[1].fd = wakeup_fd_;
+    poll_fds[1].events = POLLIN;
+
+    // while bus-off, wake up regularly to restart the controller.
+    bool is_bus_off = controller_monitor_.get_state() == BUS_OFF;
+    int ret = poll(poll_fds, 2, is_bus_off ? 10 : -1);
+    if (is_bus_off && controller_monitor_.should_restart(
+                          real_time_tools::Timer::get_current_time_sec()))
+    {
+        restart_controller();
+    }
+    if (ret <= 0)
+    {
+        if (ret == 0 || errno == EINTR)
+        {
+            return false;
+        }
+        rt_printf("poll on the CAN socket failed: %s\n", strerror(errno));
+        exit(-1);
+    }
+    if (poll_fds[1].revents & POLLIN)
+    {
+        // woken up for destruction.
+        return false;
+    }
+    // errors are reported by receive_frame().
+    return poll_fds[0].revents != 0;
+#endif
+}
+
 void CanBus::send_frame(const CanBusFrame &unstamped_can_frame)
 {
     // get address ---------------------------------------------------------
@@ -84,22 +414,48 @@ void CanBus::send_frame(const CanBusFrame &unstamped_can_frame)
            unstamped_can_frame.dlc);
 
     // send ----------------------------------------------------------------
-    osi::send_to_can_device(socket,
-                            (void *)&can_frame,
-                            sizeof(can_frame_t),
-                            0,
-                            (struct sockaddr *)&address,
-                            sizeof(address));
+    // a controller which is bus-off does not send anything, drop the frame
+    // rather than blocking the caller until the controller is restarted.
+    // Otherwise keep retrying, the frame may be a command which is sent only
+    // once (e.g. ENABLE_SYS).
+    auto is_bus_off = [this]() {
+        return controller_monitor_.get_state() == BUS_OFF;
+    };
+    if (is_bus_off())
+    {
+        statistics_.record_send_failure();
+        return;
+    }
+    long retries = osi::send_to_can_device(socket,
+                                           (void *)&can_frame,
+                                           sizeof(can_frame_t),
+                                           0,
+                                           (struct sockaddr *)&address,
+                                           sizeof(address),
+                                           is_bus_off);
+    if (retries < 0)
+    {
+        statistics_.record_send_failure();
+    }
+    else
+    {
+        statistics_.record_sent(can_frame.can_id, can_frame.can_dlc, retries);
+    }
 }
 
-CanBusFrame CanBus::receive_frame()
+bool CanBus::receive_frame(CanBusFrame &out_frame)
 {
     int socket = can_connection_.get().socket;
 
     // data we want to obtain ----------------------------------------------
     can_frame_t can_frame = {};
-    nanosecs_abs_t timestamp;
     struct sockaddr_can message_address;
+#ifdef __XENO__
+    nanosecs_abs_t timestamp;
+#else
+    // ancillary data, carries the drop counter of the receive queue.
+    char control[CMSG_SPACE(sizeof(uint32_t))];
+#endif
 
     // setup message such that data can be received to variables above -----
     struct iovec input_output_vector;
@@ -111,21 +467,57 @@ CanBusFrame CanBus::receive_frame()
     message_header.msg_iovlen = 1;
     message_header.msg_name = (void *)&message_address;
     message_header.msg_namelen = sizeof(struct sockaddr_can);
+#ifdef __XENO__
     message_header.msg_control = (void *)&timestamp;
     message_header.msg_controllen = sizeof(nanosecs_abs_t);
+#else
+    message_header.msg_control = (void *)control;
+    message_header.msg_controllen = sizeof(control);
+    message_header.msg_flags = 0;
+#endif
 
     // receive message from can bus ----------------------------------------
-    osi::receive_message_from_can_device(socket, &message_header, 0);
+    int error = osi::receive_message_from_can_device(socket, &message_header, 0);
+    if (error != 0)
+    {
+        if (error != EAGAIN && error != EINTR)
+        {
+            // e.g. the interface is down, keep the thread alive until it is
+            // up again.
+            rt_printf("something went wrong with receiving CAN frame on %s: "
+                      "%s\n",
+                      name_.c_str(),
+                      strerror(error));
+            osi::sleep_ms(10);
+        }
+        return false;
+    }
 
     // process received data and put into felix widmaier's format ----------
+#ifdef __XENO__
     if (message_header.msg_controllen == 0)
     {
         // No timestamp for this frame available. Make sure we dont get
         // garbage.
         timestamp = 0;
     }
+#else
+    for (struct cmsghdr *control_message = CMSG_FIRSTHDR(&message_header);
+         control_message != NULL;
+         control_message = CMSG_NXTHDR(&message_header, control_message))
+    {
+        if (control_message->cmsg_level == SOL_SOCKET &&
+            control_message->cmsg_type == SO_RXQ_OVFL)
+        {
+            uint32_t dropped_frames;
+            memcpy(&dropped_frames,
+                   CMSG_DATA(control_message),
+                   sizeof(dropped_frames));
+            statistics_.set_receive_overflows(dropped_frames);
+        }
+    }
+#endif
 
-    CanBusFrame out_frame;
     out_frame.id = can_frame.can_id;
     out_frame.dlc = can_frame.can_dlc;
     for (size_t i = 0; i < can_frame.can_dlc; i++)
@@ -133,7 +525,28 @@ CanBusFrame CanBus::receive_frame()
         out_frame.data[i] = can_frame.data[i];
     }
 
-    return out_frame;
+    return true;
+}
+
+void CanBus::restart_controller()
+{
+#ifdef __XENO__
+    struct ifreq ifr;
+    strncpy(ifr.ifr_name, name_.c_str(), IFNAMSIZ);
+    can_mode_t *mode = (can_mode_t *)&ifr.ifr_ifru;
+    *mode = CAN_MODE_START;
+    int error = -rt_dev_ioctl(can_connection_.get().socket, SIOCSCANMODE, &ifr);
+#else
+    int error = request_can_restart(can_connection_.get().send_addr.can_ifindex);
+#endif
+    if (error != 0)
+    {
+        // e.g. the restart is done automatically by the interface (EBUSY) or
+        // we lack the permission, then wait for the interface.
+        rt_printf("Couldn't restart the CAN controller of %s: %s\n",
+                  name_.c_str(),
+                  strerror(error));
+    }
 }
 
 CanBusConnection CanBus::setup_can(std::string name, uint32_t err_mask)
@@ -181,6 +594,18 @@ CanBusConnection CanBus::setup_can(std::string name, uint32_t err_mask)
         }
     }
 
+#ifndef __XENO__
+    // Report the frames dropped by the receive queue with every frame.
+    int enable = 1;
+    ret = setsockopt(
+        socket_number, SOL_SOCKET, SO_RXQ_OVFL, &enable, sizeof(enable));
+    if (ret < 0)
+    {
+        rt_printf("Couldn't enable SO_RXQ_OVFL, receive overflows are not "
+                  "counted.\n");
+    }
+#endif
+
     // Bind to socket
     recv_addr.can_family = AF_CAN;
     recv_addr.can_ifindex = ifr.ifr_ifindex;
@@ -0,0 +1,173 @@
+/**
+ * @file leg_impedance_controller.cpp
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, Max Planck Gesellschaft.
+ * @brief Implementation of the LegImpedanceController.
+ */
+
+#include "blmc_drivers/leg_impedance_controller.hpp"
+
+#include <stdexcept>
+
+#include "blmc_drivers/devices/motor.hpp"
+#include "blmc_drivers/utils/tracing.hpp"
+
+namespace blmc_drivers
+{
+LegImpedanceController::LegImpedanceController(
+    std::shared_ptr<CanBusMotorBoard> hip_board,
+    const bool& hip_motor_id,
+    std::shared_ptr<CanBusMotorBoard> knee_board,
+    const bool& knee_motor_id,
+    const LegKinematicsParameters& parameters,
+    const double& max_current)
+{
+    if (hip_board == knee_board && hip_motor_id == knee_motor_id)
+    {
+        throw std::invalid_argument(
+            "LegImpedanceController: hip and knee need different motors");
+    }
+
+    auto leg = std::make_shared<Leg>(
+        std::make_shared<SafeMotor>(hip_board, hip_motor_id, max_current),
+        std::make_shared<SafeMotor>(knee_board, knee_motor_id, max_current));
+    control_state_ = std::make_shared<ControlState>(leg, parameters);
+
+    auto hip_listener = std::make_shared<BoardListener>(control_state_);
+    hip_listener->add_measurement(
+        hip_motor_id ? MotorBoardInterface::position_1
+                     : MotorBoardInterface::position_0,
+        HIP_POSITION);
+    hip_listener->add_measurement(
+        hip_motor_id ? MotorBoardInterface::velocity_1
+                     : MotorBoardInterface::velocity_0,
+        HIP_VELOCITY);
+
+    auto knee_listener = hip_listener;
+    if (knee_board != hip_board)
+    {
+        knee_listener = std::make_shared<BoardListener>(control_state_);
+    }
+    knee_listener->add_measurement(
+        knee_motor_id ? MotorBoardInterface::position_1
+                      : MotorBoardInterface::position_0,
+        KNEE_POSITION);
+    knee_listener->add_measurement(
+        knee_motor_id ? MotorBoardInterface::velocity_1
+                      : MotorBoardInterface::velocity_0,
+        KNEE_VELOCITY);
+
+    hip_board->add_listener(hip_listener);
+    boards_.push_back(hip_board);
+    listeners_.push_back(hip_listener);
+    if (knee_board != hip_board)
+    {
+        try
+        {
+            knee_board->add_listener(knee_listener);
+        }
+        catch (...)
+        {
+            hip_board->remove_listener(hip_listener);
+            throw;
+        }
+        boards_.push_back(knee_board);
+        listeners_.push_back(knee_listener);
+    }
+}
+
+LegImpedanceController::~LegImpedanceController()
+{
+    for (size_t i = 0; i < boards_.size(); i++)
+    {
+        boards_[i]->remove_listener(listeners_[i]);
+    }
+}
+
+void LegImpedanceController::set_target(const LegImpedanceTarget& target)
+{
+    control_state_->targets.write(target);
+}
+
+void LegImpedanceController::control(ControlState& control_state)
+{
+    TraceScope trace_scope("LegImpedanceController::control");
+
+    if (control_state.targets.update())
+    {
+        control_state.has_target = true;
+    }
+    if (!control_state.has_target)
+    {
+        return;
+    }
+    const LegImpedanceTarget& target = control_state.targets.get();
+
+    LegKinematics<1>& kinematics = control_state.kinematics;
+    kinematics.update();
+    Eigen::Vector2d foot_force =
+        target.stiffness *
+            (target.foot_position - kinematics.get_foot_positions()) +
+        target.damping *
+            (target.foot_velocity - kinematics.get_foot_velocities()) +
+        target.foot_force;
+    if (!foot_force.allFinite())
+    {
+        foot_force.setZero();
+    }
+    kinematics.set_foot_forces(foot_force);
+    kinematics.send_if_input_changed();
+
+    control_state.step_count.fetch_add(1, std::memory_order_relaxed);
+}
+
+LegImpedanceController::BoardListener::BoardListener(
+    std::shared_ptr<ControlState> control_state)
+    : control_state_(control_state)
+{
+    bits_.fill(0);
+}
+
+void LegImpedanceController::BoardListener::add_measurement(
+    const int& index, const uint32_t& bit)
+{
+    bits_[index] |= bit;
+}
+
+void LegImpedanceController::BoardListener::on_measurement(
+    const int& index, const double& /*value*/)
+{
+    uint32_t bit = bits_[index];
+    if (bit == 0)
+    {
+        return;
+    }
+
+    // the thread completing the data clears it and runs the step, which
+    // reads the measurements appended meanwhile.  The step never runs in two
+    // threads at once: the next one needs data from the board whose thread
+    // runs the current one.
+    std::atomic<uint32_t>& fresh_data = control_state_->fresh_data;
+    uint32_t previous_data = fresh_data.load(std::memory_order_relaxed);
+    bool is_complete;
+    do
+    {
+        is_complete = (previous_data | bit) == ALL_DATA;
+    } while (!fresh_data.compare_exchange_weak(
+        previous_data,
+        is_complete ? 0 : previous_data | bit,
+        std::memory_order_acq_rel,
+        std::memory_order_relaxed));
+
+    if (is_complete)
+    {
+        control(*control_state_);
+    }
+}
+
+void LegImpedanceController::BoardListener::on_status(
+    const MotorBoardStatus& /*status*/)
+{
+}
+
+}  // namespace blmc_drivers
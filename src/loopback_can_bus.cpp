@@ -0,0 +1,80 @@
+/**
+ * @file loopback_can_bus.cpp
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, Max Planck Gesellschaft.
+ * @brief CAN bus simulating an ideal motor board.
+ */
+
+#include <blmc_drivers/devices/loopback_can_bus.hpp>
+
+namespace blmc_drivers
+{
+namespace
+{
+/**
+ * @brief The frame IDs of the motor board protocol used by the loopback,
+ * see CanBusMotorBoard.
+ */
+enum LoopbackFrameIDs
+{
+    COMMAND_ID = 0x00,
+    IqRef = 0x05,
+    STATUSMSG = 0x10,
+    Iq = 0x20
+};
+
+}  // namespace
+
+LoopbackCanBus::LoopbackCanBus(const size_t& history_length)
+{
+    input_ = std::make_shared<CanframeTimeseries>(history_length, 0, false);
+    sent_input_ =
+        std::make_shared<CanframeTimeseries>(history_length, 0, false);
+    output_ = std::make_shared<CanframeTimeseries>(history_length, 0, false);
+    statistics_.reset(real_time_tools::Timer::get_current_time_sec());
+}
+
+void LoopbackCanBus::send_if_input_changed()
+{
+    if (input_->has_changed_since_tag())
+    {
+        time_series::Index timeindex_to_send = input_->newest_timeindex();
+        CanBusFrame frame_to_send = (*input_)[timeindex_to_send];
+        input_->tag(timeindex_to_send);
+        sent_input_->append(frame_to_send);
+        statistics_.record_sent(frame_to_send.id, frame_to_send.dlc, 0);
+
+        answer(frame_to_send);
+        send_latency_.record(real_time_tools::Timer::get_current_time_sec() -
+                             input_->timestamp_s(timeindex_to_send));
+    }
+}
+
+void LoopbackCanBus::answer(const CanBusFrame& frame)
+{
+    CanBusFrame answer;
+    answer.data.fill(0);
+    answer.dlc = 8;
+
+    switch (frame.id)
+    {
+        case LoopbackFrameIDs::IqRef:
+            // the currents are encoded exactly like the references.
+            answer.id = LoopbackFrameIDs::Iq;
+            answer.data = frame.data;
+            break;
+        case LoopbackFrameIDs::COMMAND_ID:
+            // system and both motors enabled and ready, no error.
+            answer.id = LoopbackFrameIDs::STATUSMSG;
+            answer.data[0] = 0x1F;
+            answer.dlc = 1;
+            break;
+        default:
+            return;
+    }
+    output_->append(answer);
+    statistics_.record_received(
+        answer.id, answer.dlc, real_time_tools::Timer::get_current_time_sec());
+}
+
+}  // namespace blmc_drivers
@@ -17,67 +17,66 @@ namespace blmc_drivers
 Motor::Motor(Ptr<MotorBoardInterface> board, bool motor_id)
     : board_(board), motor_id_(motor_id)
 {
+    if (motor_id_ == 0)
+    {
+        measurements_[current] =
+            board_->get_measurement(MotorBoardInterface::current_0);
+        measurements_[position] =
+            board_->get_measurement(MotorBoardInterface::position_0);
+        measurements_[velocity] =
+            board_->get_measurement(MotorBoardInterface::velocity_0);
+        measurements_[encoder_index] =
+            board_->get_measurement(MotorBoardInterface::encoder_index_0);
+        control_ = board_->get_control(MotorBoardInterface::current_target_0);
+        sent_control_ =
+            board_->get_sent_control(MotorBoardInterface::current_target_0);
+    }
+    else
+    {
+        measurements_[current] =
+            board_->get_measurement(MotorBoardInterface::current_1);
+        measurements_[position] =
+            board_->get_measurement(MotorBoardInterface::position_1);
+        measurements_[velocity] =
+            board_->get_measurement(MotorBoardInterface::velocity_1);
+        measurements_[encoder_index] =
+            board_->get_measurement(MotorBoardInterface::encoder_index_1);
+        control_ = board_->get_control(MotorBoardInterface::current_target_1);
+        sent_control_ =
+            board_->get_sent_control(MotorBoardInterface::current_target_1);
+    }
 }
 
 Motor::Ptr<const Motor::ScalarTimeseries> Motor::get_measurement(
     const int& index) const
 {
-    if (motor_id_ == 0)
+    if (index < 0 || index >= measurement_count)
     {
-        switch (index)
-        {
-            case current:
-                return board_->get_measurement(MotorBoardInterface::current_0);
-            case position:
-                return board_->get_measurement(MotorBoardInterface::position_0);
-            case velocity:
-                return board_->get_measurement(MotorBoardInterface::velocity_0);
-            case encoder_index:
-                return board_->get_measurement(
-                    MotorBoardInterface::encoder_index_0);
-        }
+        throw std::invalid_argument(
+            "index needs to match one of the measurements");
     }
-    else
-    {
-        switch (index)
-        {
-            case current:
-                return board_->get_measurement(MotorBoardInterface::current_1);
-            case position:
-                return board_->get_measurement(MotorBoardInterface::position_1);
-            case velocity:
-                return board_->get_measurement(MotorBoardInterface::velocity_1);
-            case encoder_index:
-                return board_->get_measurement(
-                    MotorBoardInterface::encoder_index_1);
-        }
-    }
-
-    throw std::invalid_argument("index needs to match one of the measurements");
+    return measurements_[index];
 }
 
 Motor::Ptr<const Motor::ScalarTimeseries> Motor::get_current_target() const
 {
-    if (motor_id_ == 0)
-    {
-        return board_->get_control(MotorBoardInterface::current_target_0);
-    }
-    else
-    {
-        return board_->get_control(MotorBoardInterface::current_target_1);
-    }
+    return control_;
 }
 
 Motor::Ptr<const Motor::ScalarTimeseries> Motor::get_sent_current_target() const
 {
-    if (motor_id_ == 0)
-    {
-        return board_->get_sent_control(MotorBoardInterface::current_target_0);
-    }
-    else
+    return sent_control_;
+}
+
+ScalarChannel Motor::get_measurement_channel(const int& index) const
+{
+    if (index < 0 || index >= measurement_count)
     {
-        return board_->get_sent_control(MotorBoardInterface::current_target_1);
+        throw std::invalid_argument(
+            "index needs to match one of the measurements");
     }
+    // no copy of the shared pointer, i.e. no reference counting.
+    return ScalarChannel(measurements_[index].get());
 }
 
 void Motor::set_current_target(const double& current_target)
@@ -163,6 +162,8 @@ SafeMotor::SafeMotor(Motor::Ptr<MotorBoardInterface> board,
                      const double& max_velocity)
     : Motor(board, motor_id),
       max_current_target_(max_current_target),
+      last_safe_current_target_(0.0),
+      last_current_target_time_s_(std::numeric_limits<double>::quiet_NaN()),
       max_velocity_(max_velocity)
 {
     current_target_ =
@@ -174,20 +175,43 @@ void SafeMotor::set_current_target(const double& current_target)
     current_target_->append(current_target);
 
     // limit current to avoid overheating ----------------------------------
-    double safe_current_target = std::min(current_target, max_current_target_);
-    safe_current_target = std::max(safe_current_target, -max_current_target_);
-
-    double vel_queue_len = get_measurement(velocity)->length();
-    double cur_vel =get_measurement(velocity)->newest_element();
+    double max_current_target = max_current_target_;
+    if (thermal_limiter_)
+    {
+        // the last target was applied since the last call.
+        double now_s = real_time_tools::Timer::get_current_time_sec();
+        double dt_s = std::isnan(last_current_target_time_s_)
+                          ? 0.0
+                          : now_s - last_current_target_time_s_;
+        last_current_target_time_s_ = now_s;
+        max_current_target = std::min(
+            max_current_target,
+            thermal_limiter_->update(last_safe_current_target_, dt_s));
+    }
+    double safe_current_target = std::min(current_target, max_current_target);
+    safe_current_target = std::max(safe_current_target, -max_current_target);
+
+    ScalarChannel velocity_channel = get_measurement_channel(velocity);
+    double vel_queue_len = velocity_channel.length();
+    double cur_vel = velocity_channel.newest_element_or(0.0);
 
     // limit velocity to avoid breaking the robot --------------------------
     if (!std::isnan(max_velocity_) && vel_queue_len > 0 &&
         std::fabs(cur_vel) > max_velocity_) {
-        rt_printf("Max velocity is violated %f\n", get_measurement(velocity)->newest_element());
+        rt_printf("Max velocity is violated %f\n", cur_vel);
         safe_current_target = 0;
 	exit(-1);
     }
+    last_safe_current_target_ = safe_current_target;
     Motor::set_current_target(safe_current_target);
 }
 
+void SafeMotor::enable_thermal_limit(
+    const ThermalLimiterParameters& parameters)
+{
+    thermal_limiter_ = std::make_unique<ThermalLimiter>(parameters);
+    last_safe_current_target_ = 0.0;
+    last_current_target_time_s_ = std::numeric_limits<double>::quiet_NaN();
+}
+
 }  // namespace blmc_drivers
@@ -12,21 +12,42 @@
  *
  */
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
 #include <blmc_drivers/devices/motor_board.hpp>
+#include <blmc_drivers/utils/rt_safety.hpp>
+#include <blmc_drivers/utils/tracing.hpp>
 
 namespace blmc_drivers
 {
 CanBusMotorBoard::CanBusMotorBoard(std::shared_ptr<CanBusInterface> can_bus,
                                    const size_t& history_length,
                                    const int& control_timeout_ms,
-		                   const int& cpu_id)
+		                   const int& cpu_id,
+                                   const int& priority)
     : can_bus_(can_bus),
+      position_received_time_s_(std::numeric_limits<double>::quiet_NaN()),
+      position_unwrappers_{
+          PositionUnwrapper(2 * MAX_MOTOR_POSITION_MREV * 2 * M_PI),
+          PositionUnwrapper(2 * MAX_MOTOR_POSITION_MREV * 2 * M_PI)},
+      batch_generation_(0),
+      active_listener_count_(0),
+      pending_control_set_time_s_(std::numeric_limits<double>::quiet_NaN()),
+      pending_control_sent_time_s_(std::numeric_limits<double>::quiet_NaN()),
       motors_are_paused_(false),
       control_timeout_ms_(control_timeout_ms)
 {
     measurement_ = create_vector_of_pointers<ScalarTimeseries>(
         measurement_count, history_length);
     status_ = std::make_shared<StatusTimeseries>(history_length, 0, false);
+    for (auto& events : encoder_index_events_)
+    {
+        events = std::make_shared<EncoderIndexEventTimeseries>(
+            history_length, 0, false);
+    }
     control_ = create_vector_of_pointers<ScalarTimeseries>(control_count,
                                                            history_length);
     command_ = std::make_shared<CommandTimeseries>(history_length, 0, false);
@@ -34,12 +55,24 @@ CanBusMotorBoard::CanBusMotorBoard(std::shared_ptr<CanBusInterface> can_bus,
                                                                 history_length);
     sent_command_ =
         std::make_shared<CommandTimeseries>(history_length, 0, false);
+    for (auto& sent_control : newest_sent_controls_)
+    {
+        sent_control = std::numeric_limits<double>::quiet_NaN();
+    }
+    for (auto& slot : listener_slots_)
+    {
+        slot = nullptr;
+    }
 
     is_loop_active_ = true;
-    if (cpu_id > 0){
+    if (cpu_id >= 0){
     	rt_thread_.parameters_.cpu_id_.push_back(cpu_id);
     	rt_thread_.parameters_.priority_ = 90;
     }
+    if (priority >= 0)
+    {
+        rt_thread_.parameters_.priority_ = priority;
+    }
     rt_thread_.create_realtime_thread(&CanBusMotorBoard::loop, this);
 }
 
@@ -120,8 +153,73 @@ void CanBusMotorBoard::disable_can_recv_timeout()
     send_newest_command();
 }
 
+void CanBusMotorBoard::disable_position_rollover_error()
+{
+    set_command(
+        MotorBoardCommand(MotorBoardCommand::IDs::ENABLE_POS_ROLLOVER_ERROR,
+                          MotorBoardCommand::Contents::DISABLE));
+    send_newest_command();
+}
+
+void CanBusMotorBoard::add_listener(
+    std::shared_ptr<MotorBoardListener> listener)
+{
+    if (!listener)
+    {
+        throw std::invalid_argument("the listener of a board can't be null");
+    }
+
+    std::lock_guard<std::mutex> lock(listeners_mutex_);
+    size_t free_slot = MAX_LISTENER_COUNT;
+    for (size_t i = 0; i < MAX_LISTENER_COUNT; i++)
+    {
+        if (listeners_[i] == listener)
+        {
+            throw std::invalid_argument("the listener was already added");
+        }
+        if (!listeners_[i] && free_slot == MAX_LISTENER_COUNT)
+        {
+            free_slot = i;
+        }
+    }
+    if (free_slot == MAX_LISTENER_COUNT)
+    {
+        throw std::runtime_error("the board has too many listeners");
+    }
+    listeners_[free_slot] = listener;
+    listener_slots_[free_slot] = listener.get();
+}
+
+bool CanBusMotorBoard::remove_listener(
+    const std::shared_ptr<MotorBoardListener>& listener)
+{
+    if (!listener)
+    {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(listeners_mutex_);
+    for (size_t i = 0; i < MAX_LISTENER_COUNT; i++)
+    {
+        if (listeners_[i] == listener)
+        {
+            listener_slots_[i] = nullptr;
+            // a batch which began before may still notify the listener.
+            uint64_t generation = batch_generation_;
+            while (generation % 2 == 1 && batch_generation_ == generation)
+            {
+                osi::sleep_ms(0.1);
+            }
+            listeners_[i].reset();
+            return true;
+        }
+    }
+    return false;
+}
+
 void CanBusMotorBoard::send_newest_controls()
 {
+    TraceScope trace_scope("CanBusMotorBoard::send_controls");
     if (motors_are_paused_)
     {
         set_command(MotorBoardCommand(
@@ -131,6 +229,7 @@ void CanBusMotorBoard::send_newest_controls()
     }
 
     std::array<double, 2> controls;
+    double control_set_time_s = std::numeric_limits<double>::infinity();
     for (size_t i = 0; i < control_.size(); i++)
     {
         if (control_[i]->length() == 0)
@@ -142,9 +241,13 @@ void CanBusMotorBoard::send_newest_controls()
 
         Index timeindex = control_[i]->newest_timeindex();
         controls[i] = (*control_[i])[timeindex];
+        control_set_time_s =
+            std::min(control_set_time_s,
+                     double(control_[i]->timestamp_s(timeindex)));
         control_[i]->tag(timeindex);
 
         sent_control_[i]->append(controls[i]);
+        newest_sent_controls_[i].store(controls[i], std::memory_order_relaxed);
     }
 
     float current_mtr1 = controls[0];
@@ -179,6 +282,11 @@ void CanBusMotorBoard::send_newest_controls()
 
     can_bus_->set_input_frame(can_frame);
     can_bus_->send_if_input_changed();
+
+    double sent_time_s = real_time_tools::Timer::get_current_time_sec();
+    latencies_.control_to_sent.record(sent_time_s - control_set_time_s);
+    pending_control_set_time_s_ = control_set_time_s;
+    pending_control_sent_time_s_ = sent_time_s;
 }
 
 void CanBusMotorBoard::send_newest_command()
@@ -225,6 +333,7 @@ void CanBusMotorBoard::send_newest_command()
 
 void CanBusMotorBoard::loop()
 {
+    set_trace_thread_name("CanBusMotorBoard::loop");
     pause_motors();
 
     // initialize board --------------------------------------------------------
@@ -245,12 +354,28 @@ void CanBusMotorBoard::loop()
     send_newest_command();
 
     // receive data from board in a loop ---------------------------------------
-    long int timeindex = can_bus_->get_output_frame()->newest_timeindex();
+    std::array<CanBusFrame, MAX_DECODE_BATCH_SIZE> frames;
+    std::array<double, MAX_DECODE_BATCH_SIZE> scales;
+    std::array<double, 2 * MAX_DECODE_BATCH_SIZE> measurements;
+
+    // start at the newest frame (or the first one if there is none yet).
+    long int timeindex =
+        std::max(can_bus_->get_output_frame()->newest_timeindex(false), 0L);
     while (is_loop_active_)
     {
-        CanBusFrame can_frame;
+        auto output_frames = can_bus_->get_output_frame();
+
+        // wait for the next frame ---------------------------------------------
+        // wake up regularly to check if we should stop, even if the bus is
+        // silent.
+        if (!output_frames->wait_for_timeindex(timeindex,
+                                               LOOP_WAKEUP_PERIOD_S))
+        {
+            continue;
+        }
+        RtSection rt_section("CanBusMotorBoard::loop");
         Index received_timeindex = timeindex;
-        can_frame = (*can_bus_->get_output_frame())[received_timeindex];
+        frames[0] = (*output_frames)[received_timeindex];
 
         if (received_timeindex != timeindex)
         {
@@ -263,84 +388,226 @@ void CanBusMotorBoard::loop()
             exit(-1);
         }
 
-        timeindex++;
+        // and take all the frames which are already there as well -------------
+        size_t batch_size = 1;
+        Index newest_timeindex = output_frames->newest_timeindex(false);
+        while (batch_size < MAX_DECODE_BATCH_SIZE &&
+               timeindex + Index(batch_size) <= newest_timeindex)
+        {
+            frames[batch_size] = (*output_frames)[timeindex + batch_size];
+            batch_size++;
+        }
+        timeindex += batch_size;
+
+        // convert to measurements ---------------------------------------------
+        {
+            TraceScope trace_scope("CanBusMotorBoard::decode");
+            for (size_t i = 0; i < batch_size; i++)
+            {
+                scales[i] = get_unit_scale(frames[i].id);
+            }
+            decode_q24_pairs(frames[0].data.begin(),
+                             sizeof(CanBusFrame),
+                             batch_size,
+                             scales.begin(),
+                             measurements.begin());
+        }
+
+        // remove_listener() waits until the batch is processed.
+        batch_generation_++;
+        active_listener_count_ = 0;
+        for (size_t i = 0; i < MAX_LISTENER_COUNT; i++)
+        {
+            MotorBoardListener* listener = listener_slots_[i];
+            if (listener)
+            {
+                active_listeners_[active_listener_count_++] = listener;
+            }
+        }
+        {
+            TraceScope trace_scope("CanBusMotorBoard::append");
+            for (size_t i = 0; i < batch_size; i++)
+            {
+                process_frame(
+                    frames[i],
+                    output_frames->timestamp_s(timeindex - batch_size + i),
+                    measurements[2 * i],
+                    measurements[2 * i + 1]);
+            }
+        }
+        for (size_t i = 0; i < active_listener_count_; i++)
+        {
+            active_listeners_[i]->on_batch_end();
+        }
+        active_listener_count_ = 0;
+        batch_generation_++;
+
+        double processed_time_s = real_time_tools::Timer::get_current_time_sec();
+        for (size_t i = 0; i < batch_size; i++)
+        {
+            latencies_.received_to_measurement.record(
+                processed_time_s -
+                output_frames->timestamp_s(timeindex - batch_size + i));
+        }
+    }
+}
 
-        // convert to measurement ------------------------------------------
-        double measurement_0 = qbytes_to_float(can_frame.data.begin());
-        double measurement_1 = qbytes_to_float((can_frame.data.begin() + 4));
+double CanBusMotorBoard::get_unit_scale(const can_id_t& can_id)
+{
+    switch (can_id)
+    {
+        case CanframeIDs::POS:
+        case CanframeIDs::ENC_INDEX:
+            // Convert the position unit from the blmc card (kilo-rotations)
+            // into rad.
+            return 2 * M_PI;
+        case CanframeIDs::SPEED:
+            // Convert the speed unit from the blmc card
+            // (kilo-rotations-per-minutes) into rad/s.
+            return 2 * M_PI * (1000. / 60.);
+        default:
+            return 1.0;
+    }
+}
 
-        switch (can_frame.id)
+void CanBusMotorBoard::process_frame(const CanBusFrame& can_frame,
+                                     const double& received_time_s,
+                                     const double& measurement_0,
+                                     const double& measurement_1)
+{
+    switch (can_frame.id)
+    {
+        case CanframeIDs::Iq:
         {
-            case CanframeIDs::Iq:
-                measurement_[current_0]->append(measurement_0);
-                measurement_[current_1]->append(measurement_1);
-                break;
-            case CanframeIDs::POS:
-                // Convert the position unit from the blmc card (kilo-rotations)
-                // into rad.
-                measurement_[position_0]->append(measurement_0 * 2 * M_PI);
-                measurement_[position_1]->append(measurement_1 * 2 * M_PI);
-                break;
-            case CanframeIDs::SPEED:
-                // Convert the speed unit from the blmc card
-                // (kilo-rotations-per-minutes) into rad/s.
-                measurement_[velocity_0]->append(measurement_0 * 2 * M_PI *
-                                                 (1000. / 60.));
-                measurement_[velocity_1]->append(measurement_1 * 2 * M_PI *
-                                                 (1000. / 60.));
-                break;
-            case CanframeIDs::ADC6:
-                measurement_[analog_0]->append(measurement_0);
-                measurement_[analog_1]->append(measurement_1);
-                break;
-            case CanframeIDs::ENC_INDEX:
+            append_measurement(current_0, measurement_0);
+            append_measurement(current_1, measurement_1);
+
+            double sent_time_s = pending_control_sent_time_s_.exchange(
+                std::numeric_limits<double>::quiet_NaN());
+            if (!std::isnan(sent_time_s))
+            {
+                double now_s = real_time_tools::Timer::get_current_time_sec();
+                latencies_.sent_to_current_measurement.record(now_s -
+                                                              sent_time_s);
+                latencies_.control_to_current_measurement.record(
+                    now_s - pending_control_set_time_s_);
+            }
+            break;
+        }
+        case CanframeIDs::POS:
+            append_measurement(position_0,
+                               position_unwrappers_[0].unwrap(measurement_0));
+            append_measurement(position_1,
+                               position_unwrappers_[1].unwrap(measurement_1));
+            position_received_time_s_ = received_time_s;
+            break;
+        case CanframeIDs::SPEED:
+            append_measurement(velocity_0, measurement_0);
+            append_measurement(velocity_1, measurement_1);
+            break;
+        case CanframeIDs::ADC6:
+            append_measurement(analog_0, measurement_0);
+            append_measurement(analog_1, measurement_1);
+            break;
+        case CanframeIDs::ENC_INDEX:
+        {
+            // here the interpretation of the message is different,
+            // we get a motor index and a measurement
+            uint8_t motor_index = can_frame.data[4];
+            if (motor_index == 0 || motor_index == 1)
+            {
+                append_encoder_index(
+                    motor_index,
+                    received_time_s,
+                    position_unwrappers_[motor_index].unwrap_nearby(
+                        measurement_0));
+            }
+            else
             {
-                // here the interpretation of the message is different,
-                // we get a motor index and a measurement
-                uint8_t motor_index = can_frame.data[4];
-                if (motor_index == 0)
-                {
-                    measurement_[encoder_index_0]->append(measurement_0 * 2 *
-                                                          M_PI);
-                }
-                else if (motor_index == 1)
-                {
-                    measurement_[encoder_index_1]->append(measurement_0 * 2 *
-                                                          M_PI);
-                }
-                else
-                {
-                    rt_printf(
-                        "ERROR: Invalid motor number"
-                        "for encoder index: %d\n",
-                        motor_index);
-                    exit(-1);
-                }
-                break;
+                rt_printf(
+                    "ERROR: Invalid motor number"
+                    "for encoder index: %d\n",
+                    motor_index);
+                exit(-1);
             }
-            case CanframeIDs::STATUSMSG:
+            break;
+        }
+        case CanframeIDs::STATUSMSG:
+        {
+            MotorBoardStatus status;
+            uint8_t data = can_frame.data[0];
+            status.system_enabled = data >> 0;
+            status.motor1_enabled = data >> 1;
+            status.motor1_ready = data >> 2;
+            status.motor2_enabled = data >> 3;
+            status.motor2_ready = data >> 4;
+            status.error_code = data >> 5;
+
+            status_->append(status);
+            for (size_t i = 0; i < active_listener_count_; i++)
             {
-                MotorBoardStatus status;
-                uint8_t data = can_frame.data[0];
-                status.system_enabled = data >> 0;
-                status.motor1_enabled = data >> 1;
-                status.motor1_ready = data >> 2;
-                status.motor2_enabled = data >> 3;
-                status.motor2_ready = data >> 4;
-                status.error_code = data >> 5;
-
-                status_->append(status);
-                break;
+                active_listeners_[i]->on_status(status);
             }
+            break;
         }
+    }
+}
+
+void CanBusMotorBoard::append_measurement(const int& index,
+                                          const double& value)
+{
+    measurement_[index]->append(value);
+    for (size_t i = 0; i < active_listener_count_; i++)
+    {
+        active_listeners_[i]->on_measurement(index, value);
+    }
+}
+
+void CanBusMotorBoard::append_encoder_index(const int& motor,
+                                            const double& received_time_s,
+                                            const double& index_position)
+{
+    append_measurement(motor == 0 ? encoder_index_0 : encoder_index_1,
+                       index_position);
+
+    EncoderIndexEvent event;
+    event.received_time_s = received_time_s;
+    event.motor = motor;
+    event.index_position = index_position;
+    event.previous_position = std::numeric_limits<double>::quiet_NaN();
+    event.previous_position_time_s = position_received_time_s_;
+    event.velocity = std::numeric_limits<double>::quiet_NaN();
+    event.crossing_time_s = received_time_s;
+
+    const ScalarTimeseries& positions =
+        *measurement_[motor == 0 ? position_0 : position_1];
+    const ScalarTimeseries& velocities =
+        *measurement_[motor == 0 ? velocity_0 : velocity_1];
+    if (positions.length() > 0)
+    {
+        event.previous_position = positions.newest_element();
+    }
+    if (velocities.length() > 0)
+    {
+        event.velocity = velocities.newest_element();
+    }
 
-        //        static int count = 0;
-        //        if(count % 4000 == 0)
-        //        {
-        //            print_status();
-        //        }
-        //        count++;
+    // the index was passed when the position, moving at the measured
+    // velocity from the previous sample, reached it.
+    double travel_time_s =
+        (event.index_position - event.previous_position) / event.velocity;
+    if (std::isfinite(travel_time_s) &&
+        std::isfinite(event.previous_position_time_s))
+    {
+        event.crossing_time_s =
+            event.previous_position_time_s +
+            std::max(0.0,
+                     std::min(travel_time_s,
+                              received_time_s -
+                                  event.previous_position_time_s));
     }
+
+    encoder_index_events_[motor]->append(event);
 }
 
 void CanBusMotorBoard::print_status()
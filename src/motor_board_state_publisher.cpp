@@ -0,0 +1,95 @@
+/**
+ * @file motor_board_state_publisher.cpp
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, Max Planck Gesellschaft.
+ * @brief Export of the state of a motor board to shared memory.
+ */
+
+#include <blmc_drivers/devices/motor_board_state_publisher.hpp>
+
+#include <limits>
+
+namespace blmc_drivers
+{
+MotorBoardStatePublisher::MotorBoardStatePublisher(
+    std::shared_ptr<CanBusMotorBoard> board,
+    std::shared_ptr<CanBusInterface> can_bus,
+    const std::string& name,
+    const size_t& capacity)
+    : board_(board), can_bus_(can_bus)
+{
+    // only a CanBus has counters which can be read without locking.
+    snapshot_writer_ = std::make_shared<SnapshotWriter>(
+        board_.get(),
+        dynamic_cast<const CanBus*>(can_bus_.get()),
+        name,
+        capacity);
+    board_->add_listener(snapshot_writer_);
+}
+
+MotorBoardStatePublisher::~MotorBoardStatePublisher()
+{
+    board_->remove_listener(snapshot_writer_);
+}
+
+MotorBoardStatePublisher::SnapshotWriter::SnapshotWriter(
+    const CanBusMotorBoard* board,
+    const CanBus* can_bus,
+    const std::string& name,
+    const size_t& capacity)
+    : board_(board),
+      can_bus_(can_bus),
+      ring_(name, capacity),
+      has_new_position_(false)
+{
+    record_.timestamp_s = std::numeric_limits<double>::quiet_NaN();
+    record_.measurements.fill(std::numeric_limits<double>::quiet_NaN());
+    record_.measurement_counts.fill(0);
+    record_.sent_controls.fill(std::numeric_limits<double>::quiet_NaN());
+    record_.status = MotorBoardStatus();
+    record_.has_status = false;
+    record_.can_bus_received_frames = -1;
+    record_.can_bus_sent_frames = -1;
+}
+
+void MotorBoardStatePublisher::SnapshotWriter::on_measurement(
+    const int& index, const double& value)
+{
+    record_.measurements[index] = value;
+    record_.measurement_counts[index]++;
+    if (index == MotorBoardInterface::position_0)
+    {
+        has_new_position_ = true;
+    }
+}
+
+void MotorBoardStatePublisher::SnapshotWriter::on_status(
+    const MotorBoardStatus& status)
+{
+    record_.status = status;
+    record_.has_status = true;
+}
+
+void MotorBoardStatePublisher::SnapshotWriter::on_batch_end()
+{
+    if (!has_new_position_)
+    {
+        return;
+    }
+    has_new_position_ = false;
+
+    record_.timestamp_s = real_time_tools::Timer::get_current_time_sec();
+    for (size_t i = 0; i < record_.sent_controls.size(); i++)
+    {
+        record_.sent_controls[i] = board_->get_newest_sent_control(i);
+    }
+    if (can_bus_)
+    {
+        const CanBusStatistics& statistics = can_bus_->get_statistics();
+        record_.can_bus_received_frames = statistics.get_received_frames();
+        record_.can_bus_sent_frames = statistics.get_sent_frames();
+    }
+    ring_.append(record_);
+}
+
+}  // namespace blmc_drivers
@@ -0,0 +1,252 @@
+/**
+ * @file phase_locked_scheduler.cpp
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, Max Planck Gesellschaft.
+ * @brief Triggers the control loop at a fixed offset after the boards sent
+ * their measurements.
+ */
+
+#include "blmc_drivers/phase_locked_scheduler.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include <real_time_tools/timer.hpp>
+
+#include "blmc_drivers/utils/tracing.hpp"
+
+namespace blmc_drivers
+{
+namespace
+{
+std::vector<std::shared_ptr<const PhaseLockedScheduler::ScalarTimeseries>>
+get_references(const std::vector<std::shared_ptr<MotorBoardInterface>>& boards,
+               const int& measurement_index)
+{
+    std::vector<std::shared_ptr<const PhaseLockedScheduler::ScalarTimeseries>>
+        references;
+    for (const std::shared_ptr<MotorBoardInterface>& board : boards)
+    {
+        references.push_back(board->get_measurement(measurement_index));
+    }
+    return references;
+}
+
+/**
+ * @brief Tell the CPU that this is a busy-wait loop, which saves power and
+ * leaves the core to the other hyper-thread.
+ */
+inline void relax_cpu()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+}  // namespace
+
+PhaseLockedScheduler::PhaseLockedScheduler(
+    const std::vector<std::shared_ptr<const ScalarTimeseries>>& references,
+    const double& offset_s,
+    const double& busy_wait_s)
+    : offset_s_(offset_s),
+      busy_wait_s_(std::max(busy_wait_s, 0.0)),
+      data_time_s_(std::numeric_limits<double>::quiet_NaN())
+{
+    if (references.empty())
+    {
+        throw std::invalid_argument(
+            "PhaseLockedScheduler needs at least one reference");
+    }
+    for (const std::shared_ptr<const ScalarTimeseries>& series : references)
+    {
+        references_.push_back({series, -1});
+    }
+    reset_statistics();
+}
+
+PhaseLockedScheduler::PhaseLockedScheduler(
+    const std::vector<std::shared_ptr<MotorBoardInterface>>& boards,
+    const double& offset_s,
+    const double& busy_wait_s,
+    const int& measurement_index)
+    : PhaseLockedScheduler(
+          get_references(boards, measurement_index), offset_s, busy_wait_s)
+{
+}
+
+bool PhaseLockedScheduler::wait_for_fresh_data()
+{
+    TraceScope trace_scope("PhaseLockedScheduler::wait_for_fresh_data");
+    tick_count_++;
+
+    double oldest_arrival_s = std::numeric_limits<double>::infinity();
+    double newest_arrival_s = -std::numeric_limits<double>::infinity();
+    bool is_late = false;
+    for (Reference& reference : references_)
+    {
+        double arrival_s;
+        bool was_waiting;
+        if (!wait_for_reference(reference, arrival_s, was_waiting))
+        {
+            return false;
+        }
+        oldest_arrival_s = std::min(oldest_arrival_s, arrival_s);
+        newest_arrival_s = std::max(newest_arrival_s, arrival_s);
+        is_late = is_late || was_waiting;
+    }
+    data_time_s_ = oldest_arrival_s;
+    if (is_late)
+    {
+        overrun_count_++;
+    }
+
+    wait_until(newest_arrival_s + offset_s_, int64_t(busy_wait_s_ * 1e9));
+    return true;
+}
+
+void PhaseLockedScheduler::notify_sent()
+{
+    loop_delays_.record(real_time_tools::Timer::get_current_time_sec() -
+                        data_time_s_);
+}
+
+bool PhaseLockedScheduler::wait_for_reference(Reference& reference,
+                                              double& arrival_s,
+                                              bool& was_waiting)
+{
+    const ScalarTimeseries& series = *reference.series;
+
+    Index newest_index =
+        series.length() > 0 ? series.newest_timeindex(false) : -1;
+    if (reference.last_index < 0)
+    {
+        // first tick, only data arriving from now on is fresh.
+        reference.last_index = newest_index;
+    }
+    Index next_index = reference.last_index + 1;
+    was_waiting = newest_index >= next_index;
+
+    double predicted_s = std::numeric_limits<double>::quiet_NaN();
+    if (newest_index < next_index)
+    {
+        // sleep until shortly before the frame is expected, then poll for
+        // it until shortly after.
+        double period_s = estimate_period(series);
+        if (!std::isnan(period_s))
+        {
+            predicted_s = series.timestamp_s(newest_index) + period_s;
+            wait_until(predicted_s - busy_wait_s_, 0);
+            double now_s = real_time_tools::Timer::get_current_time_sec();
+            while (series.newest_timeindex(false) < next_index &&
+                   now_s < predicted_s + busy_wait_s_)
+            {
+                // back off between polls, so that the board thread gets
+                // the mutex of the series.
+                double next_poll_s = now_s + POLL_INTERVAL_S;
+                do
+                {
+                    relax_cpu();
+                    now_s = real_time_tools::Timer::get_current_time_sec();
+                } while (now_s < next_poll_s);
+            }
+        }
+        if (series.newest_timeindex(false) < next_index)
+        {
+            unpredicted_frame_count_++;
+            if (!series.wait_for_timeindex(next_index, DATA_TIMEOUT_S))
+            {
+                return false;
+            }
+        }
+        newest_index = series.newest_timeindex(false);
+    }
+
+    skipped_frame_count_ += newest_index - next_index;
+    arrival_s = series.timestamp_s(newest_index);
+    if (!std::isnan(predicted_s))
+    {
+        phase_errors_.record(std::fabs(arrival_s - predicted_s));
+    }
+    reference.last_index = newest_index;
+    return true;
+}
+
+double PhaseLockedScheduler::estimate_period(const ScalarTimeseries& series)
+{
+    if (series.length() < 2)
+    {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    Index newest_index = series.newest_timeindex(false);
+    Index first_index = std::max(series.oldest_timeindex(false),
+                                 newest_index - PERIOD_WINDOW);
+    return (series.timestamp_s(newest_index) -
+            series.timestamp_s(first_index)) /
+           (newest_index - first_index);
+}
+
+void PhaseLockedScheduler::wait_until(const double& time_s,
+                                      const int64_t& busy_wait_ns)
+{
+    // the time series are stamped by the clock of real_time_tools, convert
+    // the deadline to the monotonic clock of the spinner.
+    double remaining_s =
+        time_s - real_time_tools::Timer::get_current_time_sec();
+    if (remaining_s <= 0)
+    {
+        return;
+    }
+    HybridSpinner::wait_until(HybridSpinner::get_monotonic_time_ns() +
+                                  int64_t(std::llround(remaining_s * 1e9)),
+                              busy_wait_ns);
+}
+
+void PhaseLockedScheduler::reset_statistics()
+{
+    tick_count_ = 0;
+    overrun_count_ = 0;
+    skipped_frame_count_ = 0;
+    unpredicted_frame_count_ = 0;
+    loop_delays_.reset();
+    phase_errors_.reset();
+}
+
+void PhaseLockedScheduler::print_statistics() const
+{
+    rt_printf(
+        "ticks: %lu, overruns: %lu, skipped frames: %lu, unpredicted frames: "
+        "%lu (offset %.1f us)\n",
+        (unsigned long)tick_count_,
+        (unsigned long)overrun_count_,
+        (unsigned long)skipped_frame_count_,
+        (unsigned long)unpredicted_frame_count_,
+        offset_s_ * 1e6);
+    rt_printf("%16s %10s %10s %10s %10s %10s\n",
+              "[us]",
+              "min",
+              "p50",
+              "p99",
+              "p99.9",
+              "max");
+    rt_printf("%16s %10.1f %10.1f %10.1f %10.1f %10.1f\n",
+              "loop delay",
+              loop_delays_.get_min() * 1e6,
+              loop_delays_.get_percentile(50) * 1e6,
+              loop_delays_.get_percentile(99) * 1e6,
+              loop_delays_.get_percentile(99.9) * 1e6,
+              loop_delays_.get_max() * 1e6);
+    rt_printf("%16s %10.1f %10.1f %10.1f %10.1f %10.1f\n",
+              "phase error",
+              phase_errors_.get_min() * 1e6,
+              phase_errors_.get_percentile(50) * 1e6,
+              phase_errors_.get_percentile(99) * 1e6,
+              phase_errors_.get_percentile(99.9) * 1e6,
+              phase_errors_.get_max() * 1e6);
+}
+
+}  // namespace blmc_drivers
@@ -0,0 +1,120 @@
+/**
+ * \file
+ * \brief Driver daemon owning the CAN buses of a robot.
+ *
+ * Opens the given CAN interfaces, drives the motor board on each of them and
+ * makes the boards available to other processes through shared memory (see
+ * SharedMemoryMotorBoard).  The board on `<can>` is served as `blmc_<can>`,
+ * once all boards and motors are ready.
+ * Controllers can thus be restarted or crash without closing the buses and
+ * re-initializing the boards.
+ *
+ * With `--lock-memory` all memory of the daemon is locked in RAM once the
+ * buses and boards are set up (see lock_memory()).
+ *
+ * \copyright Copyright (c) 2026 Max Planck Gesellschaft.
+ */
+#include <signal.h>
+#include <atomic>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <real_time_tools/timer.hpp>
+
+#include <blmc_drivers/devices/can_bus.hpp>
+#include <blmc_drivers/devices/motor_board.hpp>
+#include <blmc_drivers/devices/shared_memory_motor_board.hpp>
+#include <blmc_drivers/utils/memory_locking.hpp>
+
+using namespace blmc_drivers;
+
+/**
+ * @brief This boolean is here to stop cleanly the daemon upon ctrl+c
+ */
+std::atomic_bool StopDaemon(false);
+
+/**
+ * @brief This function is the callback upon a ctrl+c call from the terminal.
+ */
+void my_handler(int)
+{
+    StopDaemon = true;
+}
+
+int main(int argc, char *argv[])
+{
+    bool should_lock_memory = false;
+    std::vector<std::string> can_interfaces;
+    for (int i = 1; i < argc; i++)
+    {
+        if (std::string(argv[i]) == "--lock-memory")
+        {
+            should_lock_memory = true;
+        }
+        else
+        {
+            can_interfaces.push_back(argv[i]);
+        }
+    }
+    if (can_interfaces.empty())
+    {
+        std::cout << "Usage: " << argv[0]
+                  << " [--lock-memory] <can interface> [...]" << std::endl;
+        return 1;
+    }
+
+    // make sure we catch the ctrl+c signal to stop the daemon properly.
+    struct sigaction sigIntHandler;
+    sigIntHandler.sa_handler = my_handler;
+    sigemptyset(&sigIntHandler.sa_mask);
+    sigIntHandler.sa_flags = 0;
+    sigaction(SIGINT, &sigIntHandler, NULL);
+    sigaction(SIGTERM, &sigIntHandler, NULL);
+
+    std::vector<std::shared_ptr<CanBus>> can_buses;
+    std::vector<std::shared_ptr<CanBusMotorBoard>> boards;
+    std::vector<std::unique_ptr<MotorBoardServer>> servers;
+    for (const std::string &can_interface : can_interfaces)
+    {
+        can_buses.push_back(std::make_shared<CanBus>(can_interface));
+        boards.push_back(std::make_shared<CanBusMotorBoard>(can_buses.back()));
+    }
+
+    // serve the boards only once they are enabled, so that clients never
+    // connect to a board which is still initializing.
+    for (size_t i = 0; i < boards.size(); i++)
+    {
+        boards[i]->wait_until_ready();
+    }
+
+    for (size_t i = 0; i < boards.size(); i++)
+    {
+        const std::string &can_interface = can_interfaces[i];
+        servers.push_back(std::make_unique<MotorBoardServer>(
+            boards[i], "blmc_" + can_interface));
+        rt_printf("serving the board on %s as blmc_%s\n",
+                  can_interface.c_str(),
+                  can_interface.c_str());
+    }
+
+    if (should_lock_memory)
+    {
+        MemoryLockReport report = lock_memory();
+        rt_printf("locked %lu MB of memory\n",
+                  (unsigned long)(report.locked_bytes >> 20));
+    }
+
+    while (!StopDaemon)
+    {
+        real_time_tools::Timer::sleep_sec(0.1);
+    }
+
+    // stop serving before the boards are disabled.
+    servers.clear();
+    boards.clear();
+    can_buses.clear();
+
+    return 0;
+}
@@ -0,0 +1,173 @@
+/**
+ * \file
+ * \brief Measure the latencies of the communication with a motor board.
+ *
+ * Sends zero current references at a fixed rate to the board on the given
+ * CAN interface (or to a LoopbackCanBus, which needs no hardware) and prints
+ * percentiles of the latencies recorded by the bus and the board, followed by
+ * the traffic statistics of the bus.
+ *
+ * With `--lock-memory` the memory is locked before the measurement (see
+ * lock_memory()), the page faults of the control loop are printed in any
+ * case.
+ *
+ * With `--trace <file>` the activity of the bus, board and control threads is
+ * recorded and written to the file as Chrome trace (see tracing.hpp), to be
+ * opened in https://ui.perfetto.dev.
+ *
+ * \copyright Copyright (c) 2026 Max Planck Gesellschaft.
+ */
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <real_time_tools/timer.hpp>
+
+#include <blmc_drivers/devices/can_bus.hpp>
+#include <blmc_drivers/devices/loopback_can_bus.hpp>
+#include <blmc_drivers/devices/motor_board.hpp>
+#include <blmc_drivers/utils/hybrid_spinner.hpp>
+#include <blmc_drivers/utils/memory_locking.hpp>
+#include <blmc_drivers/utils/tracing.hpp>
+
+using namespace blmc_drivers;
+
+/**
+ * @brief Print count, percentiles and max of a histogram in microseconds.
+ */
+void print_latencies(const std::string &name,
+                     const LatencyHistogram &histogram)
+{
+    rt_printf("%-32s %8lu", name.c_str(), (unsigned long)histogram.get_count());
+    for (double percentile : {50.0, 90.0, 99.0, 99.9})
+    {
+        rt_printf(" %9.1f", histogram.get_percentile(percentile) * 1e6);
+    }
+    rt_printf(" %9.1f\n", histogram.get_max() * 1e6);
+}
+
+int main(int argc, char *argv[])
+{
+    bool should_lock_memory = false;
+    std::string trace_path;
+    std::vector<std::string> arguments;
+    for (int i = 1; i < argc; i++)
+    {
+        if (std::string(argv[i]) == "--lock-memory")
+        {
+            should_lock_memory = true;
+        }
+        else if (std::string(argv[i]) == "--trace" && i + 1 < argc)
+        {
+            trace_path = argv[++i];
+        }
+        else
+        {
+            arguments.push_back(argv[i]);
+        }
+    }
+    if (arguments.size() < 1 || arguments.size() > 3)
+    {
+        std::cout << "Usage: " << argv[0]
+                  << " [--lock-memory] [--trace <file>]"
+                     " <can interface | loopback>"
+                     " [<duration in s>] [<control rate in Hz>]"
+                  << std::endl;
+        return 1;
+    }
+
+    std::string can_interface = arguments[0];
+    double duration_s =
+        (arguments.size() >= 2) ? std::stod(arguments[1]) : 10.0;
+    double rate_hz =
+        (arguments.size() >= 3) ? std::stod(arguments[2]) : 1000.0;
+
+    std::shared_ptr<CanBusInterface> can_bus;
+    const LatencyHistogram *bus_send_latency;
+    const CanBusStatistics *bus_statistics;
+    if (can_interface == "loopback")
+    {
+        auto loopback_can_bus = std::make_shared<LoopbackCanBus>();
+        bus_send_latency = &loopback_can_bus->get_send_latency();
+        bus_statistics = &loopback_can_bus->get_statistics();
+        can_bus = loopback_can_bus;
+    }
+    else
+    {
+        auto real_can_bus = std::make_shared<CanBus>(can_interface);
+        bus_send_latency = &real_can_bus->get_send_latency();
+        bus_statistics = &real_can_bus->get_statistics();
+        can_bus = real_can_bus;
+    }
+    auto board = std::make_shared<CanBusMotorBoard>(can_bus);
+
+    if (should_lock_memory)
+    {
+        MemoryLockReport report = lock_memory();
+        rt_printf("locked %lu MB of memory\n",
+                  (unsigned long)(report.locked_bytes >> 20));
+    }
+
+    set_trace_thread_name("control");
+    set_tracing_enabled(!trace_path.empty());
+
+    uint64_t page_fault_count = get_thread_page_fault_count();
+    HybridSpinner spinner(1.0 / rate_hz);
+    double end_time_s =
+        real_time_tools::Timer::get_current_time_sec() + duration_s;
+    while (real_time_tools::Timer::get_current_time_sec() < end_time_s)
+    {
+        {
+            TraceScope trace_scope("control tick");
+            board->set_control(0.0, MotorBoardInterface::current_target_0);
+            board->set_control(0.0, MotorBoardInterface::current_target_1);
+            board->send_if_input_changed();
+        }
+        spinner.spin();
+    }
+    page_fault_count = get_thread_page_fault_count() - page_fault_count;
+    set_tracing_enabled(false);
+
+    const MotorBoardLatencies &latencies = board->get_latencies();
+    rt_printf("%-32s %8s %9s %9s %9s %9s %9s\n",
+              "latency [us]",
+              "count",
+              "p50",
+              "p90",
+              "p99",
+              "p99.9",
+              "max");
+    print_latencies("bus: input to sent", *bus_send_latency);
+    print_latencies("board: control to sent", latencies.control_to_sent);
+    print_latencies("board: sent to current",
+                    latencies.sent_to_current_measurement);
+    print_latencies("board: control to current",
+                    latencies.control_to_current_measurement);
+    print_latencies("board: received to measurement",
+                    latencies.received_to_measurement);
+
+    rt_printf("\n");
+    spinner.print_statistics();
+    rt_printf("page faults of the control loop: %lu\n",
+              (unsigned long)page_fault_count);
+
+    rt_printf("\n");
+    bus_statistics->print(real_time_tools::Timer::get_current_time_sec());
+
+    if (!trace_path.empty())
+    {
+        if (!write_chrome_trace(trace_path))
+        {
+            rt_printf("could not write the trace to %s\n", trace_path.c_str());
+            return 1;
+        }
+        rt_printf(
+            "\ntrace written to %s (%lu events dropped, %lu overwritten)\n",
+            trace_path.c_str(),
+            (unsigned long)get_dropped_trace_event_count(),
+            (unsigned long)get_overwritten_trace_event_count());
+    }
+
+    return 0;
+}
@@ -29,13 +29,6 @@ public:
     static constexpr double ONE_MOTOR_ROTATION_DISTANCE =
         2.0 * M_PI / GEAR_RATIO;
 
-    //! The max. mrev position of a joint (i.e. the point where the position
-    //! measurement of the board rolls over.
-    static constexpr double MAX_MOTOR_POSITION_MREV = 100;
-    //! The max. position transformed to joint radian.
-    static constexpr double MAX_JOINT_POSITION_RAD =
-        MAX_MOTOR_POSITION_MREV * 2 * M_PI / GEAR_RATIO;
-
     EncoderIndexTester(const std::string &can_port,
                        int motor_index,
                        double torque,
@@ -55,6 +48,9 @@ public:
         // set up motor board
         motor_board_ = std::make_shared<CanBusMotorBoard>(can_bus, 1000, 10);
         motor_board_->wait_until_ready();
+        // positions are unwrapped on the host, so the board does not need to
+        // stop at its position limit.
+        motor_board_->disable_position_rollover_error();
 
         std::shared_ptr<MotorInterface> motor =
             std::make_shared<Motor>(motor_board_, motor_index);
@@ -111,8 +107,9 @@ public:
 
         // Do not print, rotate N times, count index ticks
         // check after each rotation if tick was found
-        while (rollover_safe_distance(initial_position,
-                                      joint_module_->get_measured_angle()) <
+        // positions are unwrapped by the board driver, so there is no need
+        // to care about rollovers here.
+        while (joint_module_->get_measured_angle() - initial_position <
                move_distance)
         {
             // check for board errors
@@ -153,33 +150,6 @@ private:
     unsigned int number_of_revolutions_;
     std::shared_ptr<CanBusMotorBoard> motor_board_;
     std::unique_ptr<BlmcJointModule> joint_module_;
-
-    /**
-     * @brief Compute distance between positions with rollover-compensation.
-     *
-     * The result is only correct under the following constraints:
-     *
-     *  - The difference is positive, i.e. p1 < p2 without rollover.
-     *  - There is at most one rollover between p1 and p2.
-     *
-     * @param p1 Joint angle [rad] of the lower position.
-     * @param p2 Joint angle [rad] of the higher position.
-     *
-     * @return Distance between p1 and p2 assuming the above constraints are
-     *         fulfilled.
-     */
-    double rollover_safe_distance(double p1, double p2)
-    {
-        // p2 is expected to be greater than p1.  If this is not the case, there
-        // was a rollover
-        if (p2 < p1)
-        {
-            p2 += 2 * MAX_JOINT_POSITION_RAD;
-        }
-        double diff = p2 - p1;
-
-        return diff;
-    }
 };
 
 int main(int argc, char *argv[])
@@ -206,20 +176,12 @@ int main(int argc, char *argv[])
         return 1;
     }
 
-    constexpr int num_revolutions_limit =
-        2 * EncoderIndexTester::MAX_MOTOR_POSITION_MREV;
     if (num_revolutions < 0)
     {
         std::cout << "Invalid Input: Number of revolutions has to be positive."
                   << std::endl;
         return 1;
     }
-    else if (num_revolutions >= num_revolutions_limit)
-    {
-        std::cout << "Invalid Input: Number of revolutions has to be < "
-                  << num_revolutions_limit << std::endl;
-        return 1;
-    }
 
     EncoderIndexTester tester(can_port, motor_index, torque, num_revolutions);
 
@@ -0,0 +1,67 @@
+/**
+ * \file
+ * \brief Print the state of a motor board exported to shared memory.
+ *
+ * Attaches to the ring of a MotorBoardStatePublisher (possibly running in
+ * another process) and prints the newest snapshot at a fixed rate.
+ *
+ * \copyright Copyright (c) 2026 Max Planck Gesellschaft.
+ */
+#include <iostream>
+#include <string>
+
+#include <real_time_tools/timer.hpp>
+
+#include <blmc_drivers/devices/motor_board_state_publisher.hpp>
+
+using namespace blmc_drivers;
+
+int main(int argc, char *argv[])
+{
+    if (argc != 2 && argc != 3)
+    {
+        std::cout << "Usage: " << argv[0]
+                  << " <shared memory name> [<print period in s>]" << std::endl;
+        return 1;
+    }
+
+    std::string name = argv[1];
+    double period_s = (argc == 3) ? std::stod(argv[2]) : 0.5;
+
+    MotorBoardStateReader reader(name);
+    MotorBoardStateRecord record;
+    int64_t last_index = -1;
+
+    while (true)
+    {
+        int64_t index = reader.read_newest(record);
+        if (index >= 0 && index != last_index)
+        {
+            rt_printf("[%ld] t: %.3f rx: %ld tx: %ld\n",
+                      long(index),
+                      record.timestamp_s,
+                      long(record.can_bus_received_frames),
+                      long(record.can_bus_sent_frames));
+            for (int i = 0; i < 2; i++)
+            {
+                rt_printf(
+                    "  motor %d: current: %8f position: %8f velocity: %8f "
+                    "sent current target: %8f\n",
+                    i,
+                    record.measurements[MotorBoardInterface::current_0 + i],
+                    record.measurements[MotorBoardInterface::position_0 + i],
+                    record.measurements[MotorBoardInterface::velocity_0 + i],
+                    record.sent_controls[MotorBoardInterface::current_target_0 +
+                                         i]);
+            }
+            if (record.has_status)
+            {
+                record.status.print();
+            }
+            last_index = index;
+        }
+        real_time_tools::Timer::sleep_sec(period_s);
+    }
+
+    return 0;
+}
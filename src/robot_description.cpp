@@ -0,0 +1,392 @@
+/**
+ * @file robot_description.cpp
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, Max Planck Gesellschaft.
+ * @brief Description of the buses, boards, joints and sensors of a robot,
+ * loaded from a file (see doc/robot_description.md).
+ */
+
+#include "blmc_drivers/robot_description.hpp"
+
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <set>
+#include <stdexcept>
+#include <utility>
+
+namespace blmc_drivers
+{
+namespace
+{
+/**
+ * @brief Sets one member of a description from its text.
+ */
+typedef std::function<void(const std::string&)> Setter;
+
+/**
+ * @brief Position in the parsed stream, for error messages.
+ */
+struct Location
+{
+    std::string source;
+    size_t line;
+
+    std::runtime_error error(const std::string& message) const
+    {
+        return std::runtime_error(source + ":" + std::to_string(line) + ": " +
+                                  message);
+    }
+};
+
+std::string trim(const std::string& text)
+{
+    const char* whitespace = " \t\r\n";
+    size_t begin = text.find_first_not_of(whitespace);
+    if (begin == std::string::npos)
+    {
+        return "";
+    }
+    size_t end = text.find_last_not_of(whitespace);
+    return text.substr(begin, end - begin + 1);
+}
+
+long parse_integer(const std::string& text)
+{
+    char* end;
+    long value = std::strtol(text.c_str(), &end, 10);
+    if (text.empty() || *end != '\0')
+    {
+        throw std::invalid_argument("expected an integer, got \"" + text +
+                                    "\"");
+    }
+    return value;
+}
+
+double parse_double(const std::string& text)
+{
+    char* end;
+    double value = std::strtod(text.c_str(), &end);
+    if (text.empty() || *end != '\0')
+    {
+        throw std::invalid_argument("expected a number, got \"" + text + "\"");
+    }
+    return value;
+}
+
+bool parse_bool(const std::string& text)
+{
+    if (text == "true" || text == "yes" || text == "1")
+    {
+        return true;
+    }
+    if (text == "false" || text == "no" || text == "0")
+    {
+        return false;
+    }
+    throw std::invalid_argument("expected true or false, got \"" + text +
+                                "\"");
+}
+
+/*
+ * Setters of the members of the descriptions.
+ */
+
+Setter set(std::string& member)
+{
+    return [&member](const std::string& text) { member = text; };
+}
+
+Setter set(int& member)
+{
+    return [&member](const std::string& text) {
+        member = parse_integer(text);
+    };
+}
+
+Setter set(size_t& member)
+{
+    return [&member](const std::string& text) {
+        long value = parse_integer(text);
+        if (value < 0)
+        {
+            throw std::invalid_argument("expected a positive integer");
+        }
+        member = value;
+    };
+}
+
+Setter set(double& member)
+{
+    return [&member](const std::string& text) {
+        member = parse_double(text);
+    };
+}
+
+Setter set(bool& member)
+{
+    return [&member](const std::string& text) { member = parse_bool(text); };
+}
+
+/**
+ * @brief Setters of the keys of a section, by key.
+ */
+typedef std::map<std::string, Setter> SectionKeys;
+
+SectionKeys get_keys(CanBusDescription& bus)
+{
+    return {{"interface", set(bus.interface)},
+            {"cpu", set(bus.cpu_id)},
+            {"priority", set(bus.priority)},
+            {"bitrate", set(bus.bitrate)},
+            {"history_length", set(bus.history_length)}};
+}
+
+SectionKeys get_keys(MotorBoardDescription& board)
+{
+    return {{"bus", set(board.bus)},
+            {"cpu", set(board.cpu_id)},
+            {"priority", set(board.priority)},
+            {"control_timeout_ms", set(board.control_timeout_ms)},
+            {"history_length", set(board.history_length)},
+            {"publish", set(board.publish)},
+            {"serve", set(board.serve)}};
+}
+
+SectionKeys get_keys(JointDescription& joint)
+{
+    return {{"board", set(joint.board)},
+            {"motor", set(joint.motor_index)},
+            {"motor_constant", set(joint.motor_constant)},
+            {"gear_ratio", set(joint.gear_ratio)},
+            {"zero_angle", set(joint.zero_angle)},
+            {"reverse_polarity", set(joint.reverse_polarity)},
+            {"max_current", set(joint.max_current)},
+            {"max_velocity", set(joint.max_velocity)},
+            {"continuous_current", set(joint.continuous_current)},
+            {"winding_time_constant_s", set(joint.winding_time_constant_s)},
+            {"housing_time_constant_s", set(joint.housing_time_constant_s)},
+            {"winding_fraction", set(joint.winding_fraction)},
+            {"history_length", set(joint.history_length)}};
+}
+
+SectionKeys get_keys(AnalogSensorDescription& sensor)
+{
+    return {{"board", set(sensor.board)},
+            {"sensor", set(sensor.sensor_index)}};
+}
+
+/**
+ * @brief Add a named section to the given list.
+ *
+ * @return SectionKeys of the new section.
+ */
+template <typename Description>
+SectionKeys add_section(std::vector<Description>& descriptions,
+                        const std::string& name,
+                        const Location& location)
+{
+    if (name.empty())
+    {
+        throw location.error("section needs a name");
+    }
+    for (const Description& description : descriptions)
+    {
+        if (description.name == name)
+        {
+            throw location.error("duplicate name \"" + name + "\"");
+        }
+    }
+    descriptions.emplace_back();
+    descriptions.back().name = name;
+    return get_keys(descriptions.back());
+}
+
+/**
+ * @brief Check the references between the sections.
+ */
+void validate(const RobotDescription& robot, const std::string& source)
+{
+    auto error = [&source](const std::string& message) {
+        return std::runtime_error(source + ": " + message);
+    };
+
+    std::set<std::string> buses;
+    for (const CanBusDescription& bus : robot.buses)
+    {
+        if (bus.interface.empty())
+        {
+            throw error("bus \"" + bus.name + "\" has no interface");
+        }
+        buses.insert(bus.name);
+    }
+
+    std::set<std::string> boards;
+    std::set<std::string> used_buses;
+    for (const MotorBoardDescription& board : robot.boards)
+    {
+        if (buses.count(board.bus) == 0)
+        {
+            throw error("board \"" + board.name + "\" is on unknown bus \"" +
+                        board.bus + "\"");
+        }
+        if (!used_buses.insert(board.bus).second)
+        {
+            throw error("bus \"" + board.bus + "\" has more than one board");
+        }
+        boards.insert(board.name);
+    }
+
+    std::set<std::pair<std::string, int>> motor_slots;
+    for (const JointDescription& joint : robot.joints)
+    {
+        if (boards.count(joint.board) == 0)
+        {
+            throw error("joint \"" + joint.name + "\" is on unknown board \"" +
+                        joint.board + "\"");
+        }
+        if (joint.motor_index != 0 && joint.motor_index != 1)
+        {
+            throw error("motor of joint \"" + joint.name + "\" must be 0 or 1");
+        }
+        if (!motor_slots.insert({joint.board, joint.motor_index}).second)
+        {
+            throw error("motor " + std::to_string(joint.motor_index) +
+                        " of board \"" + joint.board + "\" is used twice");
+        }
+        if (!(joint.max_current > 0) || !(joint.gear_ratio > 0) ||
+            !(joint.motor_constant > 0))
+        {
+            throw error("joint \"" + joint.name +
+                        "\" needs a positive max_current, gear_ratio and "
+                        "motor_constant");
+        }
+        if (joint.continuous_current > joint.max_current)
+        {
+            throw error("continuous_current of joint \"" + joint.name +
+                        "\" is above its max_current");
+        }
+    }
+
+    std::set<std::pair<std::string, int>> sensor_slots;
+    for (const AnalogSensorDescription& sensor : robot.analog_sensors)
+    {
+        if (boards.count(sensor.board) == 0)
+        {
+            throw error("sensor \"" + sensor.name +
+                        "\" is on unknown board \"" + sensor.board + "\"");
+        }
+        if (sensor.sensor_index != 0 && sensor.sensor_index != 1)
+        {
+            throw error("port of sensor \"" + sensor.name +
+                        "\" must be 0 or 1");
+        }
+        if (!sensor_slots.insert({sensor.board, sensor.sensor_index}).second)
+        {
+            throw error("sensor " + std::to_string(sensor.sensor_index) +
+                        " of board \"" + sensor.board + "\" is used twice");
+        }
+    }
+}
+
+}  // namespace
+
+RobotDescription parse_robot_description(std::istream& stream,
+                                         const std::string& source)
+{
+    RobotDescription robot;
+    Location location{source.empty() ? "robot description" : source, 0};
+    SectionKeys keys;
+    bool is_in_section = false;
+
+    std::string line;
+    while (std::getline(stream, line))
+    {
+        location.line++;
+        line = trim(line.substr(0, line.find('#')));
+        if (line.empty())
+        {
+            continue;
+        }
+
+        if (line.front() == '[')
+        {
+            if (line.back() != ']')
+            {
+                throw location.error("expected ']'");
+            }
+            std::string header = trim(line.substr(1, line.size() - 2));
+            size_t separator = header.find_first_of(" \t");
+            std::string type = header.substr(0, separator);
+            std::string name =
+                separator == std::string::npos
+                    ? ""
+                    : trim(header.substr(separator));
+
+            if (type == "bus")
+            {
+                keys = add_section(robot.buses, name, location);
+            }
+            else if (type == "board")
+            {
+                keys = add_section(robot.boards, name, location);
+            }
+            else if (type == "joint")
+            {
+                keys = add_section(robot.joints, name, location);
+            }
+            else if (type == "sensor")
+            {
+                keys = add_section(robot.analog_sensors, name, location);
+            }
+            else
+            {
+                throw location.error("unknown section \"" + header + "\"");
+            }
+            is_in_section = true;
+            continue;
+        }
+
+        size_t equal_sign = line.find('=');
+        if (equal_sign == std::string::npos)
+        {
+            throw location.error("expected 'key = value'");
+        }
+        if (!is_in_section)
+        {
+            throw location.error("key outside of a section");
+        }
+        std::string key = trim(line.substr(0, equal_sign));
+        std::string value = trim(line.substr(equal_sign + 1));
+
+        auto setter = keys.find(key);
+        if (setter == keys.end())
+        {
+            throw location.error("unknown key \"" + key + "\"");
+        }
+        try
+        {
+            setter->second(value);
+        }
+        catch (const std::invalid_argument& e)
+        {
+            throw location.error(key + ": " + e.what());
+        }
+    }
+
+    validate(robot, location.source);
+    return robot;
+}
+
+RobotDescription load_robot_description(const std::string& path)
+{
+    std::ifstream file(path);
+    if (!file)
+    {
+        throw std::runtime_error("could not open robot description " + path);
+    }
+    return parse_robot_description(file, path);
+}
+
+}  // namespace blmc_drivers
@@ -0,0 +1,154 @@
+/**
+ * @file robot_state_aggregator.cpp
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, Max Planck Gesellschaft.
+ * @brief Joint state of a whole robot, collected over all buses with the
+ * skew between the joints and optionally aligned to a common instant.
+ */
+
+#include "blmc_drivers/robot_state_aggregator.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace blmc_drivers
+{
+namespace
+{
+const double NaN = std::numeric_limits<double>::quiet_NaN();
+
+/**
+ * @brief Value of a measurement at the given time, interpolated linearly
+ * between its two newest samples.
+ */
+double interpolate(const double& previous_value,
+                   const double& previous_timestamp_s,
+                   const double& value,
+                   const double& timestamp_s,
+                   const double& time_s)
+{
+    double period_s = timestamp_s - previous_timestamp_s;
+    if (std::isnan(previous_value) || !(period_s > 0))
+    {
+        return value;
+    }
+    // extrapolate by at most one period.
+    double dt = std::max(-period_s, std::min(time_s - timestamp_s, period_s));
+    return value + (value - previous_value) / period_s * dt;
+}
+
+}  // namespace
+
+RobotStateAggregator::RobotStateAggregator(
+    const std::vector<std::shared_ptr<BlmcJointModule>>& joints)
+    : joints_(joints), samples_(joints.size())
+{
+    state_.positions.setConstant(joints_.size(), NaN);
+    state_.velocities.setConstant(joints_.size(), NaN);
+    state_.torques.setConstant(joints_.size(), NaN);
+    state_.timestamps_s.setConstant(joints_.size(), NaN);
+}
+
+void RobotStateAggregator::update()
+{
+    collect_samples();
+    set_newest_state();
+}
+
+void RobotStateAggregator::update_aligned(double time_s)
+{
+    collect_samples();
+    set_newest_state();
+    if (std::isnan(time_s))
+    {
+        time_s = state_.time_s;
+    }
+    if (std::isnan(time_s))
+    {
+        // no measurement yet.
+        return;
+    }
+
+    Eigen::VectorXd* values[] = {
+        &state_.positions, &state_.velocities, &state_.torques};
+    for (size_t i = 0; i < joints_.size(); i++)
+    {
+        for (size_t j = 0; j < MEASUREMENTS.size(); j++)
+        {
+            const Samples& samples = samples_[i][j];
+            (*values[j])[i] = interpolate(samples.previous_value,
+                                          samples.previous_timestamp_s,
+                                          samples.value,
+                                          samples.timestamp_s,
+                                          time_s);
+        }
+    }
+    state_.timestamps_s.setConstant(time_s);
+    state_.time_s = time_s;
+    state_.is_aligned = true;
+}
+
+void RobotStateAggregator::collect_samples()
+{
+    for (size_t i = 0; i < joints_.size(); i++)
+    {
+        for (size_t j = 0; j < MEASUREMENTS.size(); j++)
+        {
+            Samples& samples = samples_[i][j];
+            samples = {NaN, NaN, NaN, NaN};
+
+            long int newest_index =
+                joints_[i]->get_motor_measurement_index(MEASUREMENTS[j]);
+            if (newest_index < 0 ||
+                !joints_[i]->get_joint_sample(MEASUREMENTS[j],
+                                              newest_index,
+                                              samples.value,
+                                              samples.timestamp_s))
+            {
+                continue;
+            }
+            if (!joints_[i]->get_joint_sample(MEASUREMENTS[j],
+                                              newest_index - 1,
+                                              samples.previous_value,
+                                              samples.previous_timestamp_s))
+            {
+                samples.previous_value = NaN;
+                samples.previous_timestamp_s = NaN;
+            }
+        }
+    }
+}
+
+void RobotStateAggregator::set_newest_state()
+{
+    double oldest_time_s = std::numeric_limits<double>::infinity();
+    double newest_time_s = -std::numeric_limits<double>::infinity();
+    for (size_t i = 0; i < joints_.size(); i++)
+    {
+        state_.positions[i] = samples_[i][0].value;
+        state_.velocities[i] = samples_[i][1].value;
+        state_.torques[i] = samples_[i][2].value;
+
+        double timestamp_s = samples_[i][0].timestamp_s;
+        state_.timestamps_s[i] = timestamp_s;
+        if (!std::isnan(timestamp_s))
+        {
+            oldest_time_s = std::min(oldest_time_s, timestamp_s);
+            newest_time_s = std::max(newest_time_s, timestamp_s);
+        }
+    }
+
+    state_.is_aligned = false;
+    if (newest_time_s < oldest_time_s)
+    {
+        // no position yet.
+        state_.time_s = NaN;
+        state_.skew_s = NaN;
+        return;
+    }
+    state_.time_s = newest_time_s;
+    state_.skew_s = newest_time_s - oldest_time_s;
+    skews_.record(state_.skew_s);
+}
+
+}  // namespace blmc_drivers
@@ -0,0 +1,251 @@
+/**
+ * @file shared_memory_motor_board.cpp
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, Max Planck Gesellschaft.
+ * @brief Access to a motor board driven by another process through shared
+ * memory.
+ */
+
+#include <blmc_drivers/devices/shared_memory_motor_board.hpp>
+#include <blmc_drivers/utils/rt_safety.hpp>
+#include <blmc_drivers/utils/tracing.hpp>
+
+namespace blmc_drivers
+{
+void MotorBoardServer::EventForwarder::on_measurement(const int& index,
+                                                      const double& value)
+{
+    MotorBoardEvent event;
+    event.measurement_index = index;
+    event.value = value;
+    event.status = MotorBoardStatus();
+    events_.append(event, false);
+}
+
+void MotorBoardServer::EventForwarder::on_status(const MotorBoardStatus& status)
+{
+    MotorBoardEvent event;
+    event.measurement_index = -1;
+    event.value = 0;
+    event.status = status;
+    events_.append(event, false);
+}
+
+void MotorBoardServer::EventForwarder::on_batch_end()
+{
+    // one wake-up per batch rather than per event, the board thread is
+    // real-time.
+    events_.notify_readers();
+}
+
+MotorBoardServer::MotorBoardServer(std::shared_ptr<CanBusMotorBoard> board,
+                                   const std::string& name,
+                                   const size_t& capacity,
+                                   const int& cpu_id)
+    : board_(board),
+      event_forwarder_(std::make_shared<EventForwarder>(name, capacity)),
+      requests_(get_motor_board_request_ring_name(name), capacity)
+{
+    board_->add_listener(event_forwarder_);
+
+    // requests appended once the constructor returned must not be missed,
+    // even if the thread starts later.
+    first_request_index_ = requests_.newest_index() + 1;
+    is_loop_active_ = true;
+    if (cpu_id >= 0)
+    {
+        thread_.parameters_.cpu_id_.push_back(cpu_id);
+    }
+    thread_.create_realtime_thread(&MotorBoardServer::loop, this);
+}
+
+MotorBoardServer::~MotorBoardServer()
+{
+    is_loop_active_ = false;
+    thread_.join();
+    board_->remove_listener(event_forwarder_);
+}
+
+void MotorBoardServer::loop()
+{
+    set_trace_thread_name("MotorBoardServer::loop");
+    MotorBoardRequest request;
+    int64_t index = first_request_index_;
+    while (is_loop_active_)
+    {
+        // wake up regularly to check if we should stop.
+        if (!requests_.wait_for_index(index, 0.1))
+        {
+            continue;
+        }
+        RtSection rt_section("MotorBoardServer::loop");
+        if (!requests_.read(index, request))
+        {
+            int64_t oldest_index = requests_.oldest_index();
+            rt_printf("lost %ld requests of the client\n",
+                      long(oldest_index - index));
+            index = oldest_index;
+            continue;
+        }
+        index++;
+
+        switch (request.type)
+        {
+            case MotorBoardRequest::CONTROLS:
+                for (size_t i = 0; i < request.controls.size(); i++)
+                {
+                    board_->set_control(request.controls[i], i);
+                }
+                break;
+            case MotorBoardRequest::COMMAND:
+                board_->set_command(request.command);
+                break;
+            default:
+                rt_printf("ignoring request of unknown type %d\n",
+                          int(request.type));
+                continue;
+        }
+        board_->send_if_input_changed();
+    }
+}
+
+SharedMemoryMotorBoard::SharedMemoryMotorBoard(const std::string& name,
+                                               const size_t& history_length,
+                                               const int& cpu_id)
+    : events_(get_motor_board_event_ring_name(name)),
+      requests_(get_motor_board_request_ring_name(name))
+{
+    measurement_ = create_vector_of_pointers<ScalarTimeseries>(
+        measurement_count, history_length);
+    status_ = std::make_shared<StatusTimeseries>(history_length, 0, false);
+    control_ = create_vector_of_pointers<ScalarTimeseries>(control_count,
+                                                           history_length);
+    command_ = std::make_shared<CommandTimeseries>(history_length, 0, false);
+    sent_control_ = create_vector_of_pointers<ScalarTimeseries>(control_count,
+                                                                history_length);
+    sent_command_ =
+        std::make_shared<CommandTimeseries>(history_length, 0, false);
+
+    // events appended once the constructor returned must not be missed, even
+    // if the thread starts later.
+    first_event_index_ = events_.newest_index() + 1;
+    is_loop_active_ = true;
+    if (cpu_id >= 0)
+    {
+        thread_.parameters_.cpu_id_.push_back(cpu_id);
+    }
+    thread_.create_realtime_thread(&SharedMemoryMotorBoard::loop, this);
+}
+
+SharedMemoryMotorBoard::~SharedMemoryMotorBoard()
+{
+    is_loop_active_ = false;
+    thread_.join();
+}
+
+void SharedMemoryMotorBoard::send_if_input_changed()
+{
+    MotorBoardRequest request;
+
+    // send command if a new one has been set ----------------------------------
+    if (command_->has_changed_since_tag())
+    {
+        Index timeindex = command_->newest_timeindex();
+        request.type = MotorBoardRequest::COMMAND;
+        request.command = (*command_)[timeindex];
+        command_->tag(timeindex);
+        sent_command_->append(request.command);
+
+        requests_.append(request);
+    }
+
+    // send controls if a new one has been set ---------------------------------
+    bool controls_have_changed = false;
+    for (auto control : control_)
+    {
+        if (control->has_changed_since_tag()) controls_have_changed = true;
+    }
+    if (controls_have_changed)
+    {
+        request.type = MotorBoardRequest::CONTROLS;
+        for (size_t i = 0; i < control_.size(); i++)
+        {
+            if (control_[i]->length() == 0)
+            {
+                rt_printf(
+                    "you tried to send control but no control has been set\n");
+                exit(-1);
+            }
+
+            Index timeindex = control_[i]->newest_timeindex();
+            request.controls[i] = (*control_[i])[timeindex];
+            control_[i]->tag(timeindex);
+
+            sent_control_[i]->append(request.controls[i]);
+        }
+
+        requests_.append(request);
+    }
+}
+
+void SharedMemoryMotorBoard::wait_until_ready()
+{
+    rt_printf("waiting for board and motors to be ready \n");
+    time_series::Index time_index = status_->newest_timeindex();
+    bool is_ready = false;
+    while (!is_ready)
+    {
+        MotorBoardStatus status = (*status_)[time_index];
+        time_index++;
+
+        is_ready = status.is_ready();
+    }
+    rt_printf("board and motors are ready \n");
+}
+
+bool SharedMemoryMotorBoard::is_ready()
+{
+    if (status_->length() == 0)
+    {
+        return false;
+    }
+    else
+    {
+        return status_->newest_element().is_ready();
+    }
+}
+
+void SharedMemoryMotorBoard::loop()
+{
+    MotorBoardEvent event;
+    int64_t index = first_event_index_;
+    while (is_loop_active_)
+    {
+        // wake up regularly to check if we should stop.
+        if (!events_.wait_for_index(index, 0.1))
+        {
+            continue;
+        }
+        RtSection rt_section("SharedMemoryMotorBoard::loop");
+        if (!events_.read(index, event))
+        {
+            int64_t oldest_index = events_.oldest_index();
+            rt_printf("lost %ld measurements of the board\n",
+                      long(oldest_index - index));
+            index = oldest_index;
+            continue;
+        }
+        index++;
+
+        if (event.measurement_index < 0)
+        {
+            status_->append(event.status);
+        }
+        else if (event.measurement_index < measurement_count)
+        {
+            measurement_[event.measurement_index]->append(event.value);
+        }
+    }
+}
+
+}  // namespace blmc_drivers
@@ -0,0 +1,222 @@
+/**
+ * @file can_bus_statistics.cpp
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, Max Planck Gesellschaft.
+ * @brief Lock-free traffic statistics of a CAN bus.
+ */
+
+#include "blmc_drivers/utils/can_bus_statistics.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <limits>
+
+namespace blmc_drivers
+{
+namespace
+{
+/**
+ * @brief Flag of extended ids, as in linux/can.h.
+ */
+constexpr uint32_t EXTENDED_ID_FLAG = 0x80000000U;
+
+}  // namespace
+
+CanBusStatistics::CanBusStatistics(const double& bitrate) : bitrate_(bitrate)
+{
+    reset(std::numeric_limits<double>::quiet_NaN());
+}
+
+void CanBusStatistics::record_received(const uint32_t& id,
+                                       const uint8_t& dlc,
+                                       const double& time_s)
+{
+    // without a reset(), the load is averaged from the first received frame.
+    if (std::isnan(start_time_s_.load(std::memory_order_relaxed)))
+    {
+        start_time_s_.store(time_s, std::memory_order_relaxed);
+    }
+
+    received_frames_.fetch_add(1, std::memory_order_relaxed);
+    received_bytes_.fetch_add(dlc, std::memory_order_relaxed);
+    bus_bits_.fetch_add(get_frame_bits(id, dlc), std::memory_order_relaxed);
+
+    CanIdStatistics* slot = get_slot(id);
+    if (slot == nullptr)
+    {
+        untracked_frames_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    slot->received_frames_.fetch_add(1, std::memory_order_relaxed);
+    double last_receive_time_s =
+        slot->last_receive_time_s_.exchange(time_s, std::memory_order_relaxed);
+    if (!std::isnan(last_receive_time_s))
+    {
+        slot->inter_arrival_times_.record(time_s - last_receive_time_s);
+    }
+}
+
+void CanBusStatistics::record_sent(const uint32_t& id,
+                                   const uint8_t& dlc,
+                                   const size_t& retries)
+{
+    sent_frames_.fetch_add(1, std::memory_order_relaxed);
+    sent_bytes_.fetch_add(dlc, std::memory_order_relaxed);
+    bus_bits_.fetch_add(get_frame_bits(id, dlc), std::memory_order_relaxed);
+    transmit_retries_.fetch_add(retries, std::memory_order_relaxed);
+
+    CanIdStatistics* slot = get_slot(id);
+    if (slot == nullptr)
+    {
+        untracked_frames_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    slot->sent_frames_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void CanBusStatistics::record_send_failure()
+{
+    send_failures_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void CanBusStatistics::set_receive_overflows(const uint32_t& dropped_frames)
+{
+    receive_overflows_.store(dropped_frames, std::memory_order_relaxed);
+}
+
+double CanBusStatistics::get_bus_load(const double& time_s) const
+{
+    double duration_s = time_s - start_time_s_.load(std::memory_order_relaxed);
+    if (!(duration_s > 0))
+    {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    return get_bus_bits() / (bitrate_ * duration_s);
+}
+
+size_t CanBusStatistics::get_tracked_id_count() const
+{
+    size_t count = 0;
+    while (count < MAX_TRACKED_IDS && ids_[count].get_id() != NO_ID)
+    {
+        count++;
+    }
+    return count;
+}
+
+const CanIdStatistics* CanBusStatistics::find_id_statistics(
+    const uint32_t& id) const
+{
+    for (const CanIdStatistics& slot : ids_)
+    {
+        uint32_t slot_id = slot.get_id();
+        if (slot_id == id)
+        {
+            return &slot;
+        }
+        if (slot_id == NO_ID)
+        {
+            break;
+        }
+    }
+    return nullptr;
+}
+
+uint64_t CanBusStatistics::get_frame_bits(const uint32_t& id,
+                                          const uint8_t& dlc)
+{
+    uint64_t data_bits = 8 * uint64_t(dlc);
+    // bits from the start of frame to the crc (which are subject to
+    // stuffing) and the fixed bits after it: crc delimiter, ack, end of frame
+    // and interframe space.
+    uint64_t stuffed_bits = (id & EXTENDED_ID_FLAG ? 54 : 34) + data_bits;
+    uint64_t fixed_bits = 13;
+    return stuffed_bits + (stuffed_bits - 1) / 4 + fixed_bits;
+}
+
+void CanBusStatistics::reset(const double& time_s)
+{
+    start_time_s_.store(time_s, std::memory_order_relaxed);
+    received_frames_.store(0, std::memory_order_relaxed);
+    sent_frames_.store(0, std::memory_order_relaxed);
+    received_bytes_.store(0, std::memory_order_relaxed);
+    sent_bytes_.store(0, std::memory_order_relaxed);
+    bus_bits_.store(0, std::memory_order_relaxed);
+    transmit_retries_.store(0, std::memory_order_relaxed);
+    send_failures_.store(0, std::memory_order_relaxed);
+    receive_overflows_.store(0, std::memory_order_relaxed);
+    untracked_frames_.store(0, std::memory_order_relaxed);
+    for (CanIdStatistics& slot : ids_)
+    {
+        slot.received_frames_.store(0, std::memory_order_relaxed);
+        slot.sent_frames_.store(0, std::memory_order_relaxed);
+        slot.last_receive_time_s_.store(
+            std::numeric_limits<double>::quiet_NaN(), std::memory_order_relaxed);
+        slot.inter_arrival_times_.reset();
+        slot.id_.store(NO_ID, std::memory_order_release);
+    }
+}
+
+void CanBusStatistics::print(const double& time_s) const
+{
+    std::printf(
+        "frames received: %lu sent: %lu untracked: %lu, bytes received: %lu "
+        "sent: %lu\n",
+        (unsigned long)get_received_frames(),
+        (unsigned long)get_sent_frames(),
+        (unsigned long)get_untracked_frames(),
+        (unsigned long)get_received_bytes(),
+        (unsigned long)get_sent_bytes());
+    std::printf(
+        "bus load: %.1f%% of %.0f bit/s, transmit retries: %lu, send "
+        "failures: %lu, receive overflows: %lu\n",
+        100 * get_bus_load(time_s),
+        bitrate_,
+        (unsigned long)get_transmit_retries(),
+        (unsigned long)get_send_failures(),
+        (unsigned long)get_receive_overflows());
+    std::printf("%10s %10s %10s %12s %12s %12s\n",
+                "id",
+                "received",
+                "sent",
+                "p50 [us]",
+                "p99 [us]",
+                "max [us]");
+    for (size_t i = 0; i < get_tracked_id_count(); i++)
+    {
+        const CanIdStatistics& slot = ids_[i];
+        const LatencyHistogram& inter_arrival_times =
+            slot.get_inter_arrival_times();
+        std::printf("%#10x %10lu %10lu %12.1f %12.1f %12.1f\n",
+                    slot.get_id(),
+                    (unsigned long)slot.get_received_frames(),
+                    (unsigned long)slot.get_sent_frames(),
+                    inter_arrival_times.get_percentile(50) * 1e6,
+                    inter_arrival_times.get_percentile(99) * 1e6,
+                    inter_arrival_times.get_max() * 1e6);
+    }
+}
+
+CanIdStatistics* CanBusStatistics::get_slot(const uint32_t& id)
+{
+    for (CanIdStatistics& slot : ids_)
+    {
+        uint32_t slot_id = slot.id_.load(std::memory_order_acquire);
+        if (slot_id == NO_ID)
+        {
+            // claim the free slot, unless another thread was faster.
+            if (slot.id_.compare_exchange_strong(
+                    slot_id, id, std::memory_order_acq_rel))
+            {
+                return &slot;
+            }
+        }
+        if (slot_id == id)
+        {
+            return &slot;
+        }
+    }
+    return nullptr;
+}
+
+}  // namespace blmc_drivers
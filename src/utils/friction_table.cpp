@@ -0,0 +1,55 @@
+/**
+ * @file friction_table.cpp
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, Max Planck Gesellschaft.
+ * @brief Torque over a grid of positions and velocities, e.g. to compensate
+ * friction and cogging.
+ */
+
+#include "blmc_drivers/utils/friction_table.hpp"
+
+#include <stdexcept>
+
+namespace blmc_drivers
+{
+FrictionTable::FrictionTable(const double& position_min,
+                             const double& position_max,
+                             const size_t& position_node_count,
+                             const bool& is_periodic,
+                             const double& max_velocity,
+                             const size_t& velocity_node_count)
+    : position_min_(position_min),
+      position_node_count_(position_node_count),
+      is_periodic_(is_periodic),
+      max_velocity_(max_velocity),
+      velocity_node_count_(velocity_node_count)
+{
+    if (!(position_max > position_min) || position_node_count < 2 ||
+        !(max_velocity > 0) || velocity_node_count < 2)
+    {
+        throw std::invalid_argument(
+            "FrictionTable needs a non-empty range and at least 2 nodes per "
+            "dimension");
+    }
+
+    // a periodic grid does not repeat the first node at the end.
+    position_scale_ = (is_periodic_ ? position_node_count_
+                                    : position_node_count_ - 1) /
+                      (position_max - position_min);
+    velocity_scale_ = (velocity_node_count_ - 1) / (2 * max_velocity_);
+    values_.resize(position_node_count_ * velocity_node_count_, 0.0);
+}
+
+size_t FrictionTable::get_position_node(const double& position) const
+{
+    double p = std::round((position - position_min_) * position_scale_);
+    if (is_periodic_)
+    {
+        p -= std::floor(p / position_node_count_) * position_node_count_;
+        return size_t(p) % position_node_count_;
+    }
+    p = std::max(0.0, std::min(p, double(position_node_count_ - 1)));
+    return size_t(p);
+}
+
+}  // namespace blmc_drivers
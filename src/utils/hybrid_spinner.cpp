@@ -0,0 +1,163 @@
+/**
+ * @file hybrid_spinner.cpp
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, Max Planck Gesellschaft.
+ * @brief Periodic loop timing with absolute deadlines and a final busy-wait.
+ */
+
+#include "blmc_drivers/utils/hybrid_spinner.hpp"
+
+#include <errno.h>
+#include <time.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+#include "blmc_drivers/utils/tracing.hpp"
+
+namespace blmc_drivers
+{
+namespace
+{
+int64_t seconds_to_ns(const double& time_s)
+{
+    return int64_t(std::llround(time_s * 1e9));
+}
+
+timespec ns_to_timespec(const int64_t& time_ns)
+{
+    timespec time;
+    time.tv_sec = time_ns / 1000000000;
+    time.tv_nsec = time_ns % 1000000000;
+    return time;
+}
+
+}  // namespace
+
+HybridSpinner::HybridSpinner(const double& period_s, const double& busy_wait_s)
+    : period_ns_(0), deadline_ns_(0)
+{
+    set_period(period_s);
+    set_busy_wait(busy_wait_s);
+    reset_statistics();
+    initialize();
+}
+
+void HybridSpinner::set_period(const double& period_s)
+{
+    int64_t period_ns = seconds_to_ns(period_s);
+    // re-arm the deadline of the current period for its new length.
+    deadline_ns_ += period_ns - period_ns_;
+    period_ns_ = period_ns;
+}
+
+void HybridSpinner::set_busy_wait(const double& busy_wait_s)
+{
+    busy_wait_ns_ = std::max(seconds_to_ns(busy_wait_s), int64_t(0));
+}
+
+void HybridSpinner::initialize()
+{
+    deadline_ns_ = get_monotonic_time_ns() + period_ns_;
+    last_return_ns_ = -1;
+}
+
+void HybridSpinner::spin()
+{
+    TraceScope trace_scope("HybridSpinner::spin");
+    spin_count_++;
+
+    int64_t now_ns = get_monotonic_time_ns();
+    if (now_ns > deadline_ns_)
+    {
+        overrun_count_++;
+    }
+    else
+    {
+        now_ns = wait_until(deadline_ns_, busy_wait_ns_);
+    }
+
+    wakeup_latencies_.record_ns(now_ns - deadline_ns_);
+    if (last_return_ns_ >= 0)
+    {
+        periods_.record_ns(now_ns - last_return_ns_);
+    }
+    last_return_ns_ = now_ns;
+
+    // skip the periods we missed, the next one is a full period from now.
+    deadline_ns_ = std::max(deadline_ns_, now_ns) + period_ns_;
+}
+
+void HybridSpinner::reset_statistics()
+{
+    spin_count_ = 0;
+    overrun_count_ = 0;
+    periods_.reset();
+    wakeup_latencies_.reset();
+}
+
+void HybridSpinner::print_statistics() const
+{
+    std::printf("spins: %lu, overruns: %lu (period %.1f us)\n",
+                (unsigned long)spin_count_,
+                (unsigned long)overrun_count_,
+                get_period() * 1e6);
+    std::printf("%16s %10s %10s %10s %10s %10s\n",
+                "[us]",
+                "min",
+                "p50",
+                "p99",
+                "p99.9",
+                "max");
+    std::printf("%16s %10.1f %10.1f %10.1f %10.1f %10.1f\n",
+                "period",
+                periods_.get_min() * 1e6,
+                periods_.get_percentile(50) * 1e6,
+                periods_.get_percentile(99) * 1e6,
+                periods_.get_percentile(99.9) * 1e6,
+                periods_.get_max() * 1e6);
+    std::printf("%16s %10.1f %10.1f %10.1f %10.1f %10.1f\n",
+                "wake-up latency",
+                wakeup_latencies_.get_min() * 1e6,
+                wakeup_latencies_.get_percentile(50) * 1e6,
+                wakeup_latencies_.get_percentile(99) * 1e6,
+                wakeup_latencies_.get_percentile(99.9) * 1e6,
+                wakeup_latencies_.get_max() * 1e6);
+}
+
+int64_t HybridSpinner::get_monotonic_time_ns()
+{
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return int64_t(now.tv_sec) * 1000000000 + now.tv_nsec;
+}
+
+int64_t HybridSpinner::wait_until(const int64_t& deadline_ns,
+                                  const int64_t& busy_wait_ns)
+{
+    int64_t now_ns = get_monotonic_time_ns();
+    if (now_ns >= deadline_ns)
+    {
+        return now_ns;
+    }
+    // sleep until shortly before the deadline...
+    int64_t wakeup_ns = deadline_ns - busy_wait_ns;
+    if (now_ns < wakeup_ns)
+    {
+        timespec wakeup_time = ns_to_timespec(wakeup_ns);
+        while (clock_nanosleep(
+                   CLOCK_MONOTONIC, TIMER_ABSTIME, &wakeup_time, nullptr) ==
+               EINTR)
+        {
+        }
+    }
+    // ... and busy-wait the rest.
+    do
+    {
+        now_ns = get_monotonic_time_ns();
+    } while (now_ns < deadline_ns);
+    return now_ns;
+}
+
+}  // namespace blmc_drivers
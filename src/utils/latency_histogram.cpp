@@ -0,0 +1,178 @@
+/**
+ * @file latency_histogram.cpp
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, Max Planck Gesellschaft.
+ * @brief Fixed-size histogram of latencies with bounded relative error.
+ */
+
+#include "blmc_drivers/utils/latency_histogram.hpp"
+
+#include <cmath>
+#include <limits>
+
+namespace blmc_drivers
+{
+namespace
+{
+/**
+ * @brief log2 of LatencyHistogram::SUB_BUCKET_COUNT.
+ */
+constexpr int SUB_BUCKET_BITS = 6;
+static_assert(LatencyHistogram::SUB_BUCKET_COUNT == 1 << SUB_BUCKET_BITS,
+              "SUB_BUCKET_BITS does not match SUB_BUCKET_COUNT");
+
+constexpr int64_t HALF_SUB_BUCKET_COUNT = LatencyHistogram::SUB_BUCKET_COUNT / 2;
+
+}  // namespace
+
+LatencyHistogram::LatencyHistogram()
+{
+    reset();
+}
+
+void LatencyHistogram::record(const double& latency_s)
+{
+    if (std::isnan(latency_s))
+    {
+        return;
+    }
+    // clamp before the conversion, which is undefined beyond int64_t.
+    double latency_ns = std::min(latency_s * 1e9, 1e18);
+    record_ns(int64_t(std::llround(latency_ns)));
+}
+
+void LatencyHistogram::record_ns(const int64_t& latency_ns)
+{
+    int64_t value = latency_ns < 0 ? 0 : latency_ns;
+
+    buckets_[get_bucket_index(value)].fetch_add(1, std::memory_order_relaxed);
+    sum_ns_.fetch_add(value, std::memory_order_relaxed);
+
+    int64_t min = min_ns_.load(std::memory_order_relaxed);
+    while (value < min &&
+           !min_ns_.compare_exchange_weak(min, value, std::memory_order_relaxed))
+    {
+    }
+    int64_t max = max_ns_.load(std::memory_order_relaxed);
+    while (value > max &&
+           !max_ns_.compare_exchange_weak(max, value, std::memory_order_relaxed))
+    {
+    }
+
+    // last, so a non-zero count implies valid min and max.
+    count_.fetch_add(1, std::memory_order_release);
+}
+
+uint64_t LatencyHistogram::get_count() const
+{
+    return count_.load(std::memory_order_acquire);
+}
+
+double LatencyHistogram::get_min() const
+{
+    if (get_count() == 0)
+    {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    return min_ns_.load(std::memory_order_relaxed) * 1e-9;
+}
+
+double LatencyHistogram::get_max() const
+{
+    if (get_count() == 0)
+    {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    return max_ns_.load(std::memory_order_relaxed) * 1e-9;
+}
+
+double LatencyHistogram::get_mean() const
+{
+    uint64_t count = get_count();
+    if (count == 0)
+    {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    return double(sum_ns_.load(std::memory_order_relaxed)) / count * 1e-9;
+}
+
+double LatencyHistogram::get_percentile(const double& percentile) const
+{
+    // sum up the buckets rather than using count_, which may already include
+    // a latency whose bucket is not incremented yet.
+    uint64_t total = 0;
+    for (const auto& bucket : buckets_)
+    {
+        total += bucket.load(std::memory_order_relaxed);
+    }
+    if (total == 0)
+    {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+
+    double fraction = std::min(std::max(percentile, 0.0), 100.0) / 100.0;
+    uint64_t rank = std::max(uint64_t(std::ceil(fraction * total)), uint64_t(1));
+
+    uint64_t cumulated = 0;
+    size_t index = 0;
+    for (; index < BUCKET_COUNT - 1; index++)
+    {
+        cumulated += buckets_[index].load(std::memory_order_relaxed);
+        if (cumulated >= rank)
+        {
+            break;
+        }
+    }
+    int64_t latency_ns = std::min(get_bucket_upper_bound(index),
+                                  max_ns_.load(std::memory_order_relaxed));
+    return latency_ns * 1e-9;
+}
+
+void LatencyHistogram::reset()
+{
+    for (auto& bucket : buckets_)
+    {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    sum_ns_.store(0, std::memory_order_relaxed);
+    min_ns_.store(std::numeric_limits<int64_t>::max(),
+                  std::memory_order_relaxed);
+    max_ns_.store(0, std::memory_order_relaxed);
+    count_.store(0, std::memory_order_release);
+}
+
+size_t LatencyHistogram::get_bucket_index(const int64_t& latency_ns)
+{
+    if (latency_ns < int64_t(SUB_BUCKET_COUNT))
+    {
+        return latency_ns < 0 ? 0 : size_t(latency_ns);
+    }
+    if (latency_ns >= int64_t(1) << MAX_EXPONENT)
+    {
+        return BUCKET_COUNT - 1;
+    }
+    // keep the SUB_BUCKET_BITS - 1 bits below the most significant one.
+    int most_significant_bit = 63 - __builtin_clzll(uint64_t(latency_ns));
+    int shift = most_significant_bit - (SUB_BUCKET_BITS - 1);
+    int64_t mantissa = latency_ns >> shift;  // in [32, 64)
+    return SUB_BUCKET_COUNT + (shift - 1) * HALF_SUB_BUCKET_COUNT +
+           (mantissa - HALF_SUB_BUCKET_COUNT);
+}
+
+int64_t LatencyHistogram::get_bucket_upper_bound(const size_t& bucket_index)
+{
+    if (bucket_index < SUB_BUCKET_COUNT)
+    {
+        return bucket_index;
+    }
+    if (bucket_index >= BUCKET_COUNT - 1)
+    {
+        return std::numeric_limits<int64_t>::max();
+    }
+    int64_t offset = bucket_index - SUB_BUCKET_COUNT;
+    int shift = offset / HALF_SUB_BUCKET_COUNT + 1;
+    int64_t mantissa = offset % HALF_SUB_BUCKET_COUNT + HALF_SUB_BUCKET_COUNT;
+    return ((mantissa + 1) << shift) - 1;
+}
+
+}  // namespace blmc_drivers
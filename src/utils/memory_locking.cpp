@@ -0,0 +1,164 @@
+/**
+ * @file memory_locking.cpp
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, Max Planck Gesellschaft.
+ * @brief Lock the memory of the process in RAM, so that the real-time threads
+ * do not page fault.
+ */
+
+#include "blmc_drivers/utils/memory_locking.hpp"
+
+#include <alloca.h>
+#include <errno.h>
+#include <malloc.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace blmc_drivers
+{
+namespace
+{
+/**
+ * @brief Read a size given in kB from /proc/self/status (e.g. "VmLck").
+ */
+size_t read_status_size(const char* field)
+{
+    FILE* file = std::fopen("/proc/self/status", "r");
+    if (file == nullptr)
+    {
+        return 0;
+    }
+    size_t field_length = std::strlen(field);
+    size_t size_kb = 0;
+    char line[256];
+    while (std::fgets(line, sizeof(line), file) != nullptr)
+    {
+        if (std::strncmp(line, field, field_length) == 0 &&
+            line[field_length] == ':')
+        {
+            size_kb = std::strtoul(line + field_length + 1, nullptr, 10);
+            break;
+        }
+    }
+    std::fclose(file);
+    return size_kb * 1024;
+}
+
+}  // namespace
+
+MemoryLockReport lock_memory(const size_t& heap_reserve_bytes,
+                             const size_t& stack_reserve_bytes)
+{
+    // keep freed memory in the heap and do not mmap() large blocks, which
+    // would be unmapped again by free().
+    mallopt(M_TRIM_THRESHOLD, -1);
+    mallopt(M_MMAP_MAX, 0);
+
+    if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0)
+    {
+        throw std::runtime_error(std::string("could not lock memory: ") +
+                                 std::strerror(errno));
+    }
+    prefault_heap(heap_reserve_bytes);
+    prefault_stack(stack_reserve_bytes);
+
+    MemoryLockReport report = check_memory_residency();
+    if (report.non_resident_bytes > 0)
+    {
+        throw std::runtime_error(
+            "memory is locked, but " +
+            std::to_string(report.non_resident_bytes) +
+            " bytes are not resident");
+    }
+    return report;
+}
+
+__attribute__((noinline)) void prefault_stack(const size_t& size_bytes)
+{
+    volatile char* stack = static_cast<volatile char*>(alloca(size_bytes));
+    const size_t page_size = sysconf(_SC_PAGESIZE);
+    for (size_t i = 0; i < size_bytes; i += page_size)
+    {
+        stack[i] = 0;
+    }
+}
+
+void prefault_heap(const size_t& size_bytes)
+{
+    char* heap = static_cast<char*>(std::malloc(size_bytes));
+    if (heap == nullptr)
+    {
+        throw std::runtime_error("could not allocate the heap reserve");
+    }
+    const size_t page_size = sysconf(_SC_PAGESIZE);
+    for (size_t i = 0; i < size_bytes; i += page_size)
+    {
+        // volatile, so the writes to memory that is freed right after are
+        // not optimized away.
+        static_cast<volatile char*>(heap)[i] = 0;
+    }
+    std::free(heap);
+}
+
+MemoryLockReport check_memory_residency()
+{
+    MemoryLockReport report;
+    report.locked_bytes = read_status_size("VmLck");
+    report.writable_bytes = 0;
+    report.non_resident_bytes = 0;
+
+    FILE* maps = std::fopen("/proc/self/maps", "r");
+    if (maps == nullptr)
+    {
+        throw std::runtime_error("could not read /proc/self/maps");
+    }
+    const size_t page_size = sysconf(_SC_PAGESIZE);
+    std::vector<unsigned char> residency;
+    unsigned long start, end;
+    char permissions[8];
+    char line[512];
+    while (std::fgets(line, sizeof(line), maps) != nullptr)
+    {
+        if (std::sscanf(line, "%lx-%lx %7s", &start, &end, permissions) != 3 ||
+            permissions[1] != 'w')
+        {
+            continue;
+        }
+        size_t page_count = (end - start) / page_size;
+        residency.resize(page_count);
+        if (mincore(reinterpret_cast<void*>(start),
+                    end - start,
+                    residency.data()) != 0)
+        {
+            continue;
+        }
+        report.writable_bytes += end - start;
+        for (unsigned char page : residency)
+        {
+            if (!(page & 1))
+            {
+                report.non_resident_bytes += page_size;
+            }
+        }
+    }
+    std::fclose(maps);
+
+    return report;
+}
+
+uint64_t get_thread_page_fault_count()
+{
+    rusage usage;
+    getrusage(RUSAGE_THREAD, &usage);
+    return usage.ru_minflt + usage.ru_majflt;
+}
+
+}  // namespace blmc_drivers
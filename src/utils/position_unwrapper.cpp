@@ -0,0 +1,62 @@
+/**
+ * @file position_unwrapper.cpp
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, Max Planck Gesellschaft.
+ * @brief Multi-turn unwrapping of positions that roll over.
+ */
+
+#include <blmc_drivers/utils/position_unwrapper.hpp>
+
+#include <cmath>
+
+namespace blmc_drivers
+{
+PositionUnwrapper::PositionUnwrapper(const double& rollover_range)
+    : rollover_range_(rollover_range)
+{
+    reset();
+}
+
+double PositionUnwrapper::unwrap(const double& raw_position)
+{
+    if (has_sample_)
+    {
+        double delta = raw_position - last_raw_position_;
+        if (delta > rollover_range_ / 2)
+        {
+            turn_count_--;
+        }
+        else if (delta < -rollover_range_ / 2)
+        {
+            turn_count_++;
+        }
+    }
+    last_raw_position_ = raw_position;
+    has_sample_ = true;
+
+    return raw_position + static_cast<double>(turn_count_) * rollover_range_;
+}
+
+double PositionUnwrapper::unwrap_nearby(const double& raw_position) const
+{
+    if (!has_sample_)
+    {
+        return raw_position;
+    }
+
+    // number of ranges between the sample and the last raw position.
+    double delta = raw_position - last_raw_position_;
+    double turns =
+        static_cast<double>(turn_count_) - std::round(delta / rollover_range_);
+
+    return raw_position + turns * rollover_range_;
+}
+
+void PositionUnwrapper::reset()
+{
+    turn_count_ = 0;
+    last_raw_position_ = 0.0;
+    has_sample_ = false;
+}
+
+}  // namespace blmc_drivers
@@ -0,0 +1,85 @@
+/**
+ * @file q24_decoder.cpp
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, Max Planck Gesellschaft.
+ * @brief Batch decoding of the big-endian Q24 values sent by the BLMC boards.
+ */
+
+#include <blmc_drivers/utils/q24_decoder.hpp>
+
+#include <cstring>
+
+#ifdef __SSSE3__
+#include <tmmintrin.h>
+#endif
+
+namespace blmc_drivers
+{
+/**
+ * @brief Factor to go from the raw int32 to the normalized value.  This is a
+ * power of two, so multiplying with it (and with it times the unit scale)
+ * does not add any rounding on its own.
+ */
+static constexpr double Q24_NORMALIZATION = 1.0 / (1 << Q24_FRACTIONAL_BITS);
+
+/**
+ * @brief Read a big-endian int32 from an unaligned byte buffer.
+ */
+static inline int32_t load_big_endian_int32(const uint8_t* bytes)
+{
+    uint32_t raw;
+    std::memcpy(&raw, bytes, sizeof(raw));
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    raw = __builtin_bswap32(raw);
+#endif
+    return static_cast<int32_t>(raw);
+}
+
+void decode_q24_pairs(const uint8_t* payloads,
+                      size_t stride,
+                      size_t count,
+                      const double* scales,
+                      double* out)
+{
+    size_t i = 0;
+
+#ifdef __SSSE3__
+    // Reverse the bytes of each of the four int32 lanes.  Two payloads are
+    // packed into one register (low and high 64 bits).
+    const __m128i bswap_mask =
+        _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+
+    for (; i + 1 < count; i += 2)
+    {
+        const uint8_t* first = payloads + i * stride;
+        const uint8_t* second = first + stride;
+
+        __m128i raw = _mm_unpacklo_epi64(
+            _mm_loadl_epi64(reinterpret_cast<const __m128i*>(first)),
+            _mm_loadl_epi64(reinterpret_cast<const __m128i*>(second)));
+        __m128i swapped = _mm_shuffle_epi8(raw, bswap_mask);
+
+        // int32 -> double is exact.
+        __m128d values_first = _mm_cvtepi32_pd(swapped);
+        __m128d values_second =
+            _mm_cvtepi32_pd(_mm_unpackhi_epi64(swapped, swapped));
+
+        __m128d scale_first = _mm_set1_pd(scales[i] * Q24_NORMALIZATION);
+        __m128d scale_second = _mm_set1_pd(scales[i + 1] * Q24_NORMALIZATION);
+
+        _mm_storeu_pd(out + 2 * i, _mm_mul_pd(values_first, scale_first));
+        _mm_storeu_pd(out + 2 * i + 2, _mm_mul_pd(values_second, scale_second));
+    }
+#endif
+
+    for (; i < count; i++)
+    {
+        const uint8_t* payload = payloads + i * stride;
+        const double scale = scales[i] * Q24_NORMALIZATION;
+
+        out[2 * i] = load_big_endian_int32(payload) * scale;
+        out[2 * i + 1] = load_big_endian_int32(payload + 4) * scale;
+    }
+}
+
+}  // namespace blmc_drivers
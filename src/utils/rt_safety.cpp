@@ -0,0 +1,121 @@
+/**
+ * @file rt_safety.cpp
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, Max Planck Gesellschaft.
+ * @brief Marking of real-time sections, checked by the rt_safety_checker
+ * library.
+ */
+
+#include "blmc_drivers/utils/rt_safety.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdio>
+
+namespace blmc_drivers
+{
+namespace
+{
+/**
+ * @brief Innermost section of each thread.
+ */
+thread_local const char* current_section = nullptr;
+
+std::atomic<bool> is_checker_loaded(false);
+
+std::atomic<uint64_t> violation_count(0);
+
+/**
+ * @brief The first violations.  A slot is complete once its call is set.
+ */
+std::array<std::atomic<const char*>, MAX_RECORDED_RT_SAFETY_VIOLATIONS>
+    violation_sections;
+std::array<std::atomic<const char*>, MAX_RECORDED_RT_SAFETY_VIOLATIONS>
+    violation_calls;
+
+}  // namespace
+
+namespace internal
+{
+const char* enter_rt_section(const char* name)
+{
+    const char* previous_name = current_section;
+    current_section = name;
+    return previous_name;
+}
+
+void leave_rt_section(const char* previous_name)
+{
+    current_section = previous_name;
+}
+
+void record_rt_safety_violation(const char* call)
+{
+    uint64_t index = violation_count.fetch_add(1, std::memory_order_relaxed);
+    if (index < MAX_RECORDED_RT_SAFETY_VIOLATIONS)
+    {
+        violation_sections[index].store(current_section,
+                                        std::memory_order_relaxed);
+        violation_calls[index].store(call, std::memory_order_release);
+    }
+}
+
+void set_rt_safety_checker_loaded()
+{
+    is_checker_loaded = true;
+}
+
+}  // namespace internal
+
+const char* get_current_rt_section()
+{
+    return current_section;
+}
+
+bool is_rt_safety_checker_loaded()
+{
+    return is_checker_loaded;
+}
+
+uint64_t get_rt_safety_violation_count()
+{
+    return violation_count.load(std::memory_order_relaxed);
+}
+
+RtSafetyViolation get_rt_safety_violation(const size_t& index)
+{
+    RtSafetyViolation violation;
+    violation.call = violation_calls[index].load(std::memory_order_acquire);
+    violation.section =
+        violation_sections[index].load(std::memory_order_relaxed);
+    return violation;
+}
+
+void print_rt_safety_violations()
+{
+    uint64_t count = get_rt_safety_violation_count();
+    std::printf("%lu calls inside real-time sections\n", (unsigned long)count);
+    size_t recorded_count =
+        std::min(count, uint64_t(MAX_RECORDED_RT_SAFETY_VIOLATIONS));
+    for (size_t i = 0; i < recorded_count; i++)
+    {
+        RtSafetyViolation violation = get_rt_safety_violation(i);
+        if (violation.call != nullptr)
+        {
+            std::printf("  %s() in %s\n", violation.call, violation.section);
+        }
+    }
+}
+
+void reset_rt_safety_violations()
+{
+    for (size_t i = 0; i < MAX_RECORDED_RT_SAFETY_VIOLATIONS; i++)
+    {
+        violation_sections[i].store(nullptr, std::memory_order_relaxed);
+        violation_calls[i].store(nullptr, std::memory_order_relaxed);
+    }
+    violation_count.store(0, std::memory_order_relaxed);
+}
+
+}  // namespace blmc_drivers
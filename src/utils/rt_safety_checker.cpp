@@ -0,0 +1,289 @@
+/**
+ * @file rt_safety_checker.cpp
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, Max Planck Gesellschaft.
+ * @brief Library interposing malloc(), printing, sleeping and throwing to
+ * detect such calls inside real-time sections (see RtSection).
+ *
+ * Only for debugging and tests: load it with LD_PRELOAD or link against it
+ * (with --no-as-needed, nothing references it).
+ */
+
+#include <dlfcn.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <typeinfo>
+
+#include "blmc_drivers/utils/rt_safety.hpp"
+
+extern "C"
+{
+    void* __libc_malloc(size_t size);
+    void* __libc_calloc(size_t count, size_t size);
+    void* __libc_realloc(void* pointer, size_t size);
+    void* __libc_memalign(size_t alignment, size_t size);
+    void __libc_free(void* pointer);
+}
+
+namespace
+{
+/**
+ * @brief Set while a hook does its own work (e.g. dlsym()), which must not
+ * be checked.
+ */
+thread_local bool is_in_hook = false;
+
+/**
+ * @brief Abort at the first violation (BLMC_RT_SAFETY_ABORT=1).
+ */
+bool should_abort = false;
+
+__attribute__((constructor)) void initialize_rt_safety_checker()
+{
+    const char* abort_setting = std::getenv("BLMC_RT_SAFETY_ABORT");
+    should_abort = abort_setting != nullptr && abort_setting[0] == '1';
+    blmc_drivers::internal::set_rt_safety_checker_loaded();
+}
+
+/**
+ * @brief Record the call if the calling thread is in a real-time section.
+ *
+ * @param call is the name of the intercepted function.
+ */
+void check_call(const char* call)
+{
+    if (is_in_hook)
+    {
+        return;
+    }
+    const char* section = blmc_drivers::get_current_rt_section();
+    if (section == nullptr)
+    {
+        return;
+    }
+
+    is_in_hook = true;
+    blmc_drivers::internal::record_rt_safety_violation(call);
+    if (should_abort)
+    {
+        // no stdio, it may allocate.
+        const char* parts[] = {"rt safety violation: ", call, "() in ",
+                               section, "\n"};
+        for (const char* part : parts)
+        {
+            ssize_t ret = ::write(STDERR_FILENO, part, std::strlen(part));
+            (void)ret;
+        }
+        std::abort();
+    }
+    is_in_hook = false;
+}
+
+/**
+ * @brief Get the next definition of an intercepted function (the one of
+ * libc or libstdc++).
+ *
+ * @param name of the function.
+ * @param cache of the lookup.
+ */
+template <typename Function>
+Function get_next_function(const char* name, std::atomic<void*>& cache)
+{
+    void* function = cache.load(std::memory_order_relaxed);
+    if (function == nullptr)
+    {
+        // dlsym() may allocate.
+        bool was_in_hook = is_in_hook;
+        is_in_hook = true;
+        function = dlsym(RTLD_NEXT, name);
+        is_in_hook = was_in_hook;
+        if (function == nullptr)
+        {
+            std::abort();
+        }
+        cache.store(function, std::memory_order_relaxed);
+    }
+    return reinterpret_cast<Function>(function);
+}
+
+int call_next_vfprintf(FILE* stream, const char* format, va_list arguments)
+{
+    static std::atomic<void*> next(nullptr);
+    return get_next_function<decltype(&vfprintf)>("vfprintf", next)(
+        stream, format, arguments);
+}
+
+}  // namespace
+
+extern "C"
+{
+    // memory ------------------------------------------------------------------
+
+    void* malloc(size_t size)
+    {
+        check_call("malloc");
+        return __libc_malloc(size);
+    }
+
+    void* calloc(size_t count, size_t size)
+    {
+        check_call("calloc");
+        return __libc_calloc(count, size);
+    }
+
+    void* realloc(void* pointer, size_t size)
+    {
+        check_call("realloc");
+        return __libc_realloc(pointer, size);
+    }
+
+    void free(void* pointer)
+    {
+        if (pointer != nullptr)
+        {
+            check_call("free");
+        }
+        __libc_free(pointer);
+    }
+
+    int posix_memalign(void** pointer, size_t alignment, size_t size)
+    {
+        check_call("posix_memalign");
+        if (alignment % sizeof(void*) != 0 ||
+            (alignment & (alignment - 1)) != 0)
+        {
+            return EINVAL;
+        }
+        void* memory = __libc_memalign(alignment, size);
+        if (memory == nullptr)
+        {
+            return ENOMEM;
+        }
+        *pointer = memory;
+        return 0;
+    }
+
+    void* aligned_alloc(size_t alignment, size_t size)
+    {
+        check_call("aligned_alloc");
+        return __libc_memalign(alignment, size);
+    }
+
+    // printing ----------------------------------------------------------------
+
+    int printf(const char* format, ...)
+    {
+        check_call("printf");
+        va_list arguments;
+        va_start(arguments, format);
+        int ret = call_next_vfprintf(stdout, format, arguments);
+        va_end(arguments);
+        return ret;
+    }
+
+    int fprintf(FILE* stream, const char* format, ...)
+    {
+        check_call("fprintf");
+        va_list arguments;
+        va_start(arguments, format);
+        int ret = call_next_vfprintf(stream, format, arguments);
+        va_end(arguments);
+        return ret;
+    }
+
+    int vprintf(const char* format, va_list arguments)
+    {
+        check_call("vprintf");
+        return call_next_vfprintf(stdout, format, arguments);
+    }
+
+    int vfprintf(FILE* stream, const char* format, va_list arguments)
+    {
+        check_call("vfprintf");
+        return call_next_vfprintf(stream, format, arguments);
+    }
+
+    int puts(const char* string)
+    {
+        check_call("puts");
+        static std::atomic<void*> next(nullptr);
+        return get_next_function<decltype(&puts)>("puts", next)(string);
+    }
+
+    int fputs(const char* string, FILE* stream)
+    {
+        check_call("fputs");
+        static std::atomic<void*> next(nullptr);
+        return get_next_function<decltype(&fputs)>("fputs", next)(string,
+                                                                  stream);
+    }
+
+    size_t fwrite(const void* data, size_t size, size_t count, FILE* stream)
+    {
+        check_call("fwrite");
+        static std::atomic<void*> next(nullptr);
+        return get_next_function<decltype(&fwrite)>("fwrite", next)(
+            data, size, count, stream);
+    }
+
+    int fflush(FILE* stream)
+    {
+        check_call("fflush");
+        static std::atomic<void*> next(nullptr);
+        return get_next_function<decltype(&fflush)>("fflush", next)(stream);
+    }
+
+    ssize_t write(int fd, const void* data, size_t size)
+    {
+        check_call("write");
+        static std::atomic<void*> next(nullptr);
+        return get_next_function<decltype(&write)>("write", next)(
+            fd, data, size);
+    }
+
+    // sleeping ----------------------------------------------------------------
+
+    unsigned int sleep(unsigned int seconds)
+    {
+        check_call("sleep");
+        static std::atomic<void*> next(nullptr);
+        return get_next_function<decltype(&sleep)>("sleep", next)(seconds);
+    }
+
+    int usleep(useconds_t microseconds)
+    {
+        check_call("usleep");
+        static std::atomic<void*> next(nullptr);
+        return get_next_function<decltype(&usleep)>("usleep", next)(
+            microseconds);
+    }
+
+    int nanosleep(const struct timespec* duration, struct timespec* remaining)
+    {
+        check_call("nanosleep");
+        static std::atomic<void*> next(nullptr);
+        return get_next_function<decltype(&nanosleep)>("nanosleep", next)(
+            duration, remaining);
+    }
+
+    // exceptions --------------------------------------------------------------
+
+    __attribute__((noreturn)) void __cxa_throw(void* exception,
+                                               std::type_info* type,
+                                               void (*destructor)(void*))
+    {
+        check_call("__cxa_throw");
+        typedef void (*ThrowFunction)(void*, std::type_info*, void (*)(void*));
+        static std::atomic<void*> next(nullptr);
+        get_next_function<ThrowFunction>("__cxa_throw", next)(
+            exception, type, destructor);
+        __builtin_unreachable();
+    }
+}
@@ -0,0 +1,216 @@
+/**
+ * @file shared_memory_ring.cpp
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, Max Planck Gesellschaft.
+ * @brief Mapping, writer registration and wake-up of shared memory rings.
+ */
+
+#include "blmc_drivers/utils/shared_memory_ring.hpp"
+
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+namespace blmc_drivers
+{
+namespace internal
+{
+namespace
+{
+/**
+ * @brief Check whether the process with the given pid exists.
+ */
+bool is_process_alive(const int32_t& pid)
+{
+    return kill(pid, 0) == 0 || errno != ESRCH;
+}
+
+/**
+ * @brief The futex words are shared between processes, so the non-private
+ * futex operations are used.
+ */
+long futex(std::atomic<uint32_t>* word,
+           const int& operation,
+           const uint32_t& value,
+           const struct timespec* timeout)
+{
+    return syscall(SYS_futex,
+                   reinterpret_cast<uint32_t*>(word),
+                   operation,
+                   value,
+                   timeout,
+                   nullptr,
+                   0);
+}
+
+}  // namespace
+
+void* create_shared_memory(const std::string& name, const size_t& size)
+{
+    // start from a fresh segment, processes attached to an old one keep their
+    // mapping.
+    shm_unlink(name.c_str());
+    int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0)
+    {
+        throw std::runtime_error("shm_open(" + name +
+                                 ") failed: " + std::strerror(errno));
+    }
+    if (ftruncate(fd, size) != 0)
+    {
+        int error = errno;
+        close(fd);
+        shm_unlink(name.c_str());
+        throw std::runtime_error("ftruncate(" + name +
+                                 ") failed: " + std::strerror(error));
+    }
+    void* memory =
+        mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (memory == MAP_FAILED)
+    {
+        shm_unlink(name.c_str());
+        throw std::runtime_error("mmap(" + name +
+                                 ") failed: " + std::strerror(errno));
+    }
+
+    // touch all pages now rather than in the real-time path.
+    std::memset(memory, 0, size);
+
+    return memory;
+}
+
+void* attach_shared_memory(const std::string& name, size_t& size)
+{
+    // read-write, waiting readers register themselves in the header.
+    int fd = shm_open(name.c_str(), O_RDWR, 0);
+    if (fd < 0)
+    {
+        throw std::runtime_error("shm_open(" + name +
+                                 ") failed: " + std::strerror(errno));
+    }
+    struct stat file_status;
+    if (fstat(fd, &file_status) != 0 ||
+        size_t(file_status.st_size) < sizeof(SharedMemoryRingHeader))
+    {
+        close(fd);
+        throw std::runtime_error(name + " is not a shared memory ring");
+    }
+    size = file_status.st_size;
+
+    void* memory =
+        mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (memory == MAP_FAILED)
+    {
+        throw std::runtime_error("mmap(" + name +
+                                 ") failed: " + std::strerror(errno));
+    }
+    return memory;
+}
+
+void claim_ring_writer(SharedMemoryRingHeader* header, const std::string& name)
+{
+    const int32_t pid = getpid();
+    int32_t writer_pid = header->writer_pid.load();
+    while (true)
+    {
+        if (writer_pid != 0 && is_process_alive(writer_pid))
+        {
+            throw std::runtime_error(name + " is already written by process " +
+                                     std::to_string(writer_pid));
+        }
+        // the previous writer is gone (or crashed), take over.
+        if (header->writer_pid.compare_exchange_weak(writer_pid, pid))
+        {
+            return;
+        }
+    }
+}
+
+void release_ring_writer(SharedMemoryRingHeader* header)
+{
+    int32_t pid = getpid();
+    header->writer_pid.compare_exchange_strong(pid, 0);
+}
+
+void notify_ring_readers(SharedMemoryRingHeader* header)
+{
+    header->wakeup_count.fetch_add(1, std::memory_order_seq_cst);
+    if (header->waiter_count.load(std::memory_order_seq_cst) > 0)
+    {
+        futex(&header->wakeup_count, FUTEX_WAKE, INT32_MAX, nullptr);
+    }
+}
+
+bool wait_for_ring_index(SharedMemoryRingHeader* header,
+                         const uint64_t& index,
+                         const double& timeout_s)
+{
+    struct timespec deadline;
+    if (!std::isnan(timeout_s))
+    {
+        clock_gettime(CLOCK_MONOTONIC, &deadline);
+        double seconds = std::floor(timeout_s);
+        deadline.tv_sec += time_t(seconds);
+        deadline.tv_nsec += long((timeout_s - seconds) * 1e9);
+        if (deadline.tv_nsec >= 1000000000)
+        {
+            deadline.tv_sec += 1;
+            deadline.tv_nsec -= 1000000000;
+        }
+    }
+
+    header->waiter_count.fetch_add(1, std::memory_order_seq_cst);
+    bool is_appended = false;
+    while (true)
+    {
+        // read the futex word before checking, so an append in between makes
+        // the FUTEX_WAIT return immediately.
+        uint32_t wakeup_count =
+            header->wakeup_count.load(std::memory_order_seq_cst);
+        if (header->next_index.load(std::memory_order_acquire) > index)
+        {
+            is_appended = true;
+            break;
+        }
+
+        struct timespec timeout;
+        struct timespec* timeout_pointer = nullptr;
+        if (!std::isnan(timeout_s))
+        {
+            struct timespec now;
+            clock_gettime(CLOCK_MONOTONIC, &now);
+            timeout.tv_sec = deadline.tv_sec - now.tv_sec;
+            timeout.tv_nsec = deadline.tv_nsec - now.tv_nsec;
+            if (timeout.tv_nsec < 0)
+            {
+                timeout.tv_sec -= 1;
+                timeout.tv_nsec += 1000000000;
+            }
+            if (timeout.tv_sec < 0)
+            {
+                break;
+            }
+            timeout_pointer = &timeout;
+        }
+        // relative timeout (FUTEX_WAIT measures it on CLOCK_MONOTONIC).
+        futex(&header->wakeup_count, FUTEX_WAIT, wakeup_count, timeout_pointer);
+    }
+    header->waiter_count.fetch_sub(1, std::memory_order_seq_cst);
+
+    return is_appended;
+}
+
+}  // namespace internal
+}  // namespace blmc_drivers
@@ -0,0 +1,94 @@
+/**
+ * @file thermal_limiter.cpp
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, Max Planck Gesellschaft.
+ * @brief I²t model of the winding temperature of a motor, limiting its
+ * current.
+ */
+
+#include "blmc_drivers/utils/thermal_limiter.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace blmc_drivers
+{
+namespace
+{
+/**
+ * @brief Exact step of a first order stage towards the given input.
+ */
+void integrate_stage(double& load,
+                     const double& input,
+                     const double& dt_s,
+                     const double& time_constant_s)
+{
+    load += (input - load) * -std::expm1(-dt_s / time_constant_s);
+}
+
+}  // namespace
+
+ThermalLimiter::ThermalLimiter(const ThermalLimiterParameters& parameters)
+    : parameters_(parameters)
+{
+    if (!(parameters_.continuous_current > 0) ||
+        !(parameters_.peak_current >= parameters_.continuous_current))
+    {
+        throw std::invalid_argument(
+            "ThermalLimiter needs 0 < continuous_current <= peak_current");
+    }
+    if (!(parameters_.winding_time_constant_s > 0) ||
+        !(parameters_.housing_time_constant_s >= 0))
+    {
+        throw std::invalid_argument(
+            "ThermalLimiter needs positive time constants");
+    }
+    if (!(parameters_.winding_fraction > 0 &&
+          parameters_.winding_fraction <= 1) ||
+        !(parameters_.derating_start >= 0 && parameters_.derating_start < 1))
+    {
+        throw std::invalid_argument(
+            "ThermalLimiter needs winding_fraction in (0, 1] and "
+            "derating_start in [0, 1)");
+    }
+
+    winding_fraction_ = parameters_.housing_time_constant_s > 0
+                            ? parameters_.winding_fraction
+                            : 1.0;
+    reset();
+}
+
+double ThermalLimiter::update(const double& current, const double& dt_s)
+{
+    if (dt_s > 0)
+    {
+        double relative_current = current / parameters_.continuous_current;
+        double input = relative_current * relative_current;
+        integrate_stage(
+            winding_load_, input, dt_s, parameters_.winding_time_constant_s);
+        if (winding_fraction_ < 1.0)
+        {
+            integrate_stage(housing_load_,
+                            input,
+                            dt_s,
+                            parameters_.housing_time_constant_s);
+        }
+    }
+
+    double headroom = (1.0 - get_load()) / (1.0 - parameters_.derating_start);
+    headroom = std::max(0.0, std::min(headroom, 1.0));
+    current_limit_ =
+        parameters_.continuous_current +
+        (parameters_.peak_current - parameters_.continuous_current) * headroom;
+    return current_limit_;
+}
+
+void ThermalLimiter::reset()
+{
+    winding_load_ = 0.0;
+    housing_load_ = 0.0;
+    current_limit_ = parameters_.peak_current;
+}
+
+}  // namespace blmc_drivers
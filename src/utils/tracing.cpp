@@ -0,0 +1,287 @@
+/**
+ * @file tracing.cpp
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, Max Planck Gesellschaft.
+ * @brief Recording of the activity of the driver threads, exported as Chrome
+ * trace.
+ */
+
+#include "blmc_drivers/utils/tracing.hpp"
+
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace blmc_drivers
+{
+namespace
+{
+/**
+ * @brief A recorded event.
+ */
+struct TraceEvent
+{
+    const char* name;
+    //! @brief Time of CLOCK_MONOTONIC (ns).
+    int64_t time_ns;
+    char phase;
+};
+
+/**
+ * @brief The events of one thread, in a ring buffer which overwrites the
+ * oldest events.  Only the thread appends, the number of events is published
+ * after the event is written.
+ */
+struct ThreadTrace
+{
+    //! @brief Id of the thread in the operating system.
+    long thread_id;
+    std::atomic<const char*> name;
+    //! @brief Number of events recorded since the last reset_trace().
+    std::atomic<size_t> event_count;
+    //! @brief The buffer, nullptr until tracing is enabled.
+    std::atomic<TraceEvent*> events;
+    std::unique_ptr<std::array<TraceEvent, TRACE_BUFFER_SIZE>> buffer;
+};
+
+/**
+ * @brief Protects the list of the traces of the threads and the allocation
+ * of their buffers.
+ */
+std::mutex thread_traces_mutex;
+
+/**
+ * @brief The traces of all registered threads.  They are kept after their
+ * thread ended, until the end of the program.
+ */
+std::vector<std::unique_ptr<ThreadTrace>> thread_traces;
+
+/**
+ * @brief Trace of the calling thread, nullptr until set_trace_thread_name().
+ */
+thread_local ThreadTrace* thread_trace = nullptr;
+
+std::atomic<uint64_t> dropped_event_count(0);
+
+/**
+ * @brief Allocate (and pre-fault) the buffer of a trace, if it has none.
+ * The caller holds thread_traces_mutex.
+ */
+void allocate_buffer(ThreadTrace& trace)
+{
+    if (trace.buffer)
+    {
+        return;
+    }
+    // value-initialized, which also pre-faults the buffer.
+    trace.buffer.reset(new std::array<TraceEvent, TRACE_BUFFER_SIZE>());
+    trace.events.store(trace.buffer->data(), std::memory_order_release);
+}
+
+int64_t get_time_ns()
+{
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return int64_t(time.tv_sec) * 1000000000 + time.tv_nsec;
+}
+
+/**
+ * @brief Write a string as JSON string.
+ */
+void write_json_string(std::ostream& stream, const char* string)
+{
+    stream << '"';
+    for (const char* c = string; *c; c++)
+    {
+        if (*c == '"' || *c == '\\')
+        {
+            stream << '\\';
+        }
+        stream << *c;
+    }
+    stream << '"';
+}
+
+}  // namespace
+
+namespace internal
+{
+std::atomic<bool> is_tracing_enabled(false);
+
+void record_trace_event(const char* name, const char& phase)
+{
+    ThreadTrace* trace = thread_trace;
+    TraceEvent* events =
+        trace ? trace->events.load(std::memory_order_acquire) : nullptr;
+    if (!events)
+    {
+        // not registered or no buffer yet, allocating would lock.
+        dropped_event_count.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    size_t count = trace->event_count.load(std::memory_order_relaxed);
+    events[count % TRACE_BUFFER_SIZE] = {name, get_time_ns(), phase};
+    trace->event_count.store(count + 1, std::memory_order_release);
+}
+
+}  // namespace internal
+
+void set_tracing_enabled(const bool& is_enabled)
+{
+    if (is_enabled)
+    {
+        std::lock_guard<std::mutex> lock(thread_traces_mutex);
+        for (const auto& trace : thread_traces)
+        {
+            allocate_buffer(*trace);
+        }
+    }
+    internal::is_tracing_enabled.store(is_enabled, std::memory_order_relaxed);
+}
+
+void set_trace_thread_name(const char* name)
+{
+    if (thread_trace)
+    {
+        thread_trace->name = name;
+        return;
+    }
+
+    std::unique_ptr<ThreadTrace> trace(new ThreadTrace());
+    trace->thread_id = syscall(SYS_gettid);
+    trace->name = name;
+    trace->event_count = 0;
+    trace->events = nullptr;
+
+    std::lock_guard<std::mutex> lock(thread_traces_mutex);
+    if (is_tracing_enabled())
+    {
+        allocate_buffer(*trace);
+    }
+    thread_trace = trace.get();
+    thread_traces.push_back(std::move(trace));
+}
+
+uint64_t get_dropped_trace_event_count()
+{
+    return dropped_event_count;
+}
+
+uint64_t get_overwritten_trace_event_count()
+{
+    std::lock_guard<std::mutex> lock(thread_traces_mutex);
+    uint64_t overwritten_count = 0;
+    for (const auto& trace : thread_traces)
+    {
+        size_t event_count = trace->event_count;
+        if (event_count > TRACE_BUFFER_SIZE)
+        {
+            overwritten_count += event_count - TRACE_BUFFER_SIZE;
+        }
+    }
+    return overwritten_count;
+}
+
+size_t write_chrome_trace(std::ostream& stream)
+{
+    std::lock_guard<std::mutex> lock(thread_traces_mutex);
+
+    const long process_id = getpid();
+    size_t written_count = 0;
+    const char* separator = "\n";
+    stream << "{\"traceEvents\":[";
+    stream << std::fixed << std::setprecision(3);
+    for (const auto& trace : thread_traces)
+    {
+        const char* name = trace->name;
+        if (name)
+        {
+            stream << separator << "{\"name\":\"thread_name\",\"ph\":\"M\","
+                   << "\"pid\":" << process_id
+                   << ",\"tid\":" << trace->thread_id << ",\"args\":{\"name\":";
+            write_json_string(stream, name);
+            stream << "}}";
+            separator = ",\n";
+        }
+
+        const TraceEvent* events = trace->events.load();
+        if (!events)
+        {
+            continue;
+        }
+
+        // copy the newest events, then skip the ones the thread may have
+        // overwritten meanwhile.  While tracing is enabled, the thread may
+        // also be writing the next event over the oldest one.
+        size_t end = trace->event_count.load(std::memory_order_acquire);
+        size_t begin = end > TRACE_BUFFER_SIZE ? end - TRACE_BUFFER_SIZE : 0;
+        std::vector<TraceEvent> copied_events;
+        copied_events.reserve(end - begin);
+        for (size_t i = begin; i < end; i++)
+        {
+            copied_events.push_back(events[i % TRACE_BUFFER_SIZE]);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        size_t new_end = trace->event_count.load(std::memory_order_relaxed);
+        if (is_tracing_enabled())
+        {
+            new_end++;
+        }
+        size_t skipped_count = 0;
+        if (new_end > begin + TRACE_BUFFER_SIZE)
+        {
+            skipped_count = std::min(new_end - (begin + TRACE_BUFFER_SIZE),
+                                     copied_events.size());
+        }
+
+        for (size_t i = skipped_count; i < copied_events.size(); i++)
+        {
+            const TraceEvent& event = copied_events[i];
+            stream << separator << "{\"name\":";
+            write_json_string(stream, event.name);
+            stream << ",\"ph\":\"" << event.phase << "\",\"ts\":"
+                   << event.time_ns * 1e-3 << ",\"pid\":" << process_id
+                   << ",\"tid\":" << trace->thread_id;
+            if (event.phase == 'i')
+            {
+                stream << ",\"s\":\"t\"";
+            }
+            stream << "}";
+            separator = ",\n";
+        }
+        written_count += copied_events.size() - skipped_count;
+    }
+    stream << "\n]}\n";
+    return written_count;
+}
+
+bool write_chrome_trace(const std::string& path)
+{
+    std::ofstream file(path);
+    if (!file)
+    {
+        return false;
+    }
+    write_chrome_trace(file);
+    return bool(file);
+}
+
+void reset_trace()
+{
+    std::lock_guard<std::mutex> lock(thread_traces_mutex);
+    for (const auto& trace : thread_traces)
+    {
+        trace->event_count = 0;
+    }
+    dropped_event_count = 0;
+}
+
+}  // namespace blmc_drivers
@@ -0,0 +1,109 @@
+/**
+ * @file scripted_can_bus.hpp
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, Max Planck Gesellschaft.
+ * @brief CAN bus for the tests, on which the test plays the motor board.
+ */
+#pragma once
+
+#include <cmath>
+#include <memory>
+
+#include "blmc_drivers/devices/can_bus.hpp"
+
+namespace blmc_drivers
+{
+/**
+ * @brief CAN bus on which the test plays the board, by appending the frames
+ * the board would send.
+ */
+class ScriptedCanBus : public CanBusInterface
+{
+public:
+    //! @brief Ids of the frames sent by the board.
+    static constexpr can_id_t STATUSMSG = 0x10;
+    static constexpr can_id_t POS = 0x30;
+    static constexpr can_id_t SPEED = 0x40;
+    static constexpr can_id_t ENC_INDEX = 0x60;
+
+    ScriptedCanBus()
+    {
+        input_ = std::make_shared<CanframeTimeseries>(100, 0, false);
+        sent_input_ = std::make_shared<CanframeTimeseries>(100, 0, false);
+        output_ = std::make_shared<CanframeTimeseries>(100, 0, false);
+    }
+
+    std::shared_ptr<const CanframeTimeseries> get_output_frame() const override
+    {
+        return output_;
+    }
+
+    std::shared_ptr<const CanframeTimeseries> get_input_frame() override
+    {
+        return input_;
+    }
+
+    std::shared_ptr<const CanframeTimeseries> get_sent_input_frame() override
+    {
+        return sent_input_;
+    }
+
+    void set_input_frame(const CanBusFrame& input_frame) override
+    {
+        input_->append(input_frame);
+    }
+
+    void send_if_input_changed() override
+    {
+    }
+
+    /**
+     * @brief Receive a frame with two Q24 values (in the units of the
+     * board), returns its time index.
+     */
+    time_series::Index receive(const can_id_t& id,
+                               const double& value_0,
+                               const double& value_1)
+    {
+        CanBusFrame frame;
+        frame.id = id;
+        frame.dlc = 8;
+        write_q24(value_0, &frame.data[0]);
+        write_q24(value_1, &frame.data[4]);
+        output_->append(frame);
+        return output_->newest_timeindex();
+    }
+
+    /**
+     * @brief Receive the encoder index of a motor (position in
+     * rotations), returns its time index.
+     */
+    time_series::Index receive_index(const uint8_t& motor,
+                                     const double& position)
+    {
+        CanBusFrame frame;
+        frame.id = ENC_INDEX;
+        frame.dlc = 5;
+        frame.data.fill(0);
+        write_q24(position, &frame.data[0]);
+        frame.data[4] = motor;
+        output_->append(frame);
+        return output_->newest_timeindex();
+    }
+
+private:
+    static void write_q24(const double& value, uint8_t* bytes)
+    {
+        uint32_t q24 = uint32_t(int32_t(std::lround(value * (1 << 24))));
+        for (int i = 0; i < 4; i++)
+        {
+            bytes[i] = (q24 >> (24 - 8 * i)) & 0xFF;
+        }
+    }
+
+    std::shared_ptr<CanframeTimeseries> input_;
+    std::shared_ptr<CanframeTimeseries> sent_input_;
+    std::shared_ptr<CanframeTimeseries> output_;
+};
+
+}  // namespace blmc_drivers
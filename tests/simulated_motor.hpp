@@ -0,0 +1,144 @@
+/**
+ * @file simulated_motor.hpp
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, Max Planck Gesellschaft.
+ * @brief Motor for the tests, simulating a joint driven by the current
+ * targets.
+ */
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <memory>
+
+#include "blmc_drivers/devices/motor.hpp"
+
+namespace blmc_drivers
+{
+/**
+ * @brief Joint with inertia and friction, integrated at each current target,
+ * which sees an encoder index at each crossing of
+ * index_position + n * index_spacing.
+ */
+class SimulatedMotor : public MotorInterface
+{
+public:
+    /**
+     * @brief Friction torque (Nm) at a position (rad) and velocity (rad/s).
+     */
+    typedef double (*FrictionModel)(const double& position,
+                                    const double& velocity);
+
+    /**
+     * @brief Viscous friction, the default FrictionModel.
+     */
+    static double get_viscous_friction(const double& /*position*/,
+                                       const double& velocity)
+    {
+        return 0.05 * velocity;
+    }
+
+    SimulatedMotor(const double& start_position = 0.0,
+                   const double& index_position = 0.0,
+                   const double& index_spacing = 1.0)
+        : position_(start_position),
+          velocity_(0.0),
+          index_position_(index_position),
+          index_spacing_(index_spacing),
+          friction_(&get_viscous_friction)
+    {
+        for (auto& measurement : measurements_)
+        {
+            measurement = std::make_shared<ScalarTimeseries>(100, 0, false);
+        }
+        current_target_ = std::make_shared<ScalarTimeseries>(100, 0, false);
+        measure(0.0);
+    }
+
+    void send_if_input_changed() override
+    {
+    }
+
+    Ptr<const ScalarTimeseries> get_measurement(
+        const int& index = 0) const override
+    {
+        return measurements_[index];
+    }
+
+    Ptr<const ScalarTimeseries> get_current_target() const override
+    {
+        return current_target_;
+    }
+
+    Ptr<const ScalarTimeseries> get_sent_current_target() const override
+    {
+        return current_target_;
+    }
+
+    /**
+     * @brief Apply the current (= torque) for 1 ms.
+     */
+    void set_current_target(const double& current_target) override
+    {
+        current_target_->append(current_target);
+
+        const double dt_s = 0.001;
+        const double inertia = 0.01;
+        double acceleration =
+            (current_target - friction_(position_, velocity_)) / inertia;
+        velocity_ += acceleration * dt_s;
+        double previous_position = position_;
+        position_ += velocity_ * dt_s;
+
+        double previous_index = get_index_count(previous_position);
+        double index = get_index_count(position_);
+        if (index != previous_index)
+        {
+            measurements_[MotorInterface::encoder_index]->append(
+                index_position_ +
+                std::max(index, previous_index) * index_spacing_);
+        }
+        measure(current_target);
+    }
+
+    void set_command(const MotorBoardCommand&) override
+    {
+    }
+
+    /**
+     * @brief Replace the viscous friction, e.g. by one with cogging.
+     */
+    void set_friction(FrictionModel friction)
+    {
+        friction_ = friction;
+    }
+
+    double get_position() const
+    {
+        return position_;
+    }
+
+private:
+    double get_index_count(const double& position) const
+    {
+        return std::floor((position - index_position_) / index_spacing_);
+    }
+
+    void measure(const double& current)
+    {
+        measurements_[MotorInterface::position]->append(position_);
+        measurements_[MotorInterface::velocity]->append(velocity_);
+        measurements_[MotorInterface::current]->append(current);
+    }
+
+    double position_;
+    double velocity_;
+    double index_position_;
+    double index_spacing_;
+    FrictionModel friction_;
+    std::array<Ptr<ScalarTimeseries>, measurement_count> measurements_;
+    Ptr<ScalarTimeseries> current_target_;
+};
+
+}  // namespace blmc_drivers
@@ -0,0 +1,69 @@
+/**
+ * @file test_alpha_beta_gamma_filter.cpp
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, Max Planck Gesellschaft.
+ * @brief Tests for the AlphaBetaGammaFilter.
+ */
+#include <gtest/gtest.h>
+#include <cmath>
+
+#include "blmc_drivers/utils/alpha_beta_gamma_filter.hpp"
+
+using namespace blmc_drivers;
+
+/*! A constant acceleration trajectory is tracked without error */
+TEST(TestAlphaBetaGammaFilter, tracks_constant_acceleration)
+{
+    typedef AlphaBetaGammaFilter<2>::Vector Vector;
+    AlphaBetaGammaFilter<2> filter;
+
+    Vector times, positions;
+    for (int k = 0; k < 3000; k++)
+    {
+        double t = k * 0.001;
+        times << t, t;
+        positions << 1.0 + 2.0 * t, -0.5 * 3.0 * t * t;
+        filter.update(times, positions);
+    }
+
+    // extrapolate 2 ms into the future
+    Vector p, v, a;
+    filter.predict(2.999 + 0.002, p, v, a);
+    ASSERT_NEAR(1.0 + 2.0 * 3.001, p[0], 1e-6);
+    ASSERT_NEAR(2.0, v[0], 1e-6);
+    ASSERT_NEAR(0.0, a[0], 1e-6);
+    ASSERT_NEAR(-1.5 * 3.001 * 3.001, p[1], 1e-6);
+    ASSERT_NEAR(-3.0 * 3.001, v[1], 1e-6);
+    ASSERT_NEAR(-3.0, a[1], 1e-6);
+}
+
+/*! Channels without (new) samples are left untouched */
+TEST(TestAlphaBetaGammaFilter, skips_missing_samples)
+{
+    AlphaBetaGammaFilter<Eigen::Dynamic> filter(2);
+    Eigen::VectorXd times(2), positions(2), p(2), v(2), a(2);
+
+    times << 0.0, NAN;
+    positions << 1.0, 5.0;
+    filter.update(times, positions);
+    filter.predict(1.0, p, v, a);
+    ASSERT_EQ(1.0, p[0]);
+    ASSERT_EQ(0.0, v[0]);
+    ASSERT_TRUE(std::isnan(p[1]));
+
+    // same timestamp again, must be ignored
+    positions << 3.0, 5.0;
+    filter.update(times, positions);
+    filter.predict(0.0, p, v, a);
+    ASSERT_EQ(1.0, p[0]);
+
+    filter.reset();
+    filter.predict(0.0, p, v, a);
+    ASSERT_TRUE(std::isnan(p[0]));
+}
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
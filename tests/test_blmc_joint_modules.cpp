@@ -0,0 +1,106 @@
+/**
+ * @file test_blmc_joint_modules.cpp
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, Max Planck Gesellschaft.
+ * @brief Tests for BlmcJointModules with a number of joints known only at
+ * runtime.
+ */
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+
+#include "blmc_drivers/blmc_joint_module.hpp"
+#include "blmc_drivers/devices/loopback_can_bus.hpp"
+#include "blmc_drivers/devices/motor_board.hpp"
+
+using namespace blmc_drivers;
+
+typedef BlmcJointModules<Eigen::Dynamic> DynamicJointModules;
+
+class TestBlmcJointModules : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // three joints on two boards.
+        for (size_t i = 0; i < 2; i++)
+        {
+            can_buses_[i] = std::make_shared<LoopbackCanBus>();
+            boards_[i] = std::make_shared<CanBusMotorBoard>(can_buses_[i]);
+        }
+        motors_.push_back(std::make_shared<Motor>(boards_[0], 0));
+        motors_.push_back(std::make_shared<Motor>(boards_[0], 1));
+        motors_.push_back(std::make_shared<Motor>(boards_[1], 0));
+        for (size_t i = 0; i < 2; i++)
+        {
+            boards_[i]->wait_until_ready();
+        }
+    }
+
+    std::shared_ptr<LoopbackCanBus> can_buses_[2];
+    std::shared_ptr<CanBusMotorBoard> boards_[2];
+    DynamicJointModules::MotorArray motors_;
+};
+
+/*! The number of joints is the number of motors */
+TEST_F(TestBlmcJointModules, dynamic_size)
+{
+    Eigen::VectorXd ones = Eigen::VectorXd::Ones(3);
+    DynamicJointModules joints(motors_, ones, ones, 0 * ones, ones);
+    ASSERT_EQ(3u, joints.size());
+    ASSERT_EQ(3, joints.get_measured_angles().size());
+    ASSERT_EQ(3, joints.get_max_torques().size());
+    ASSERT_EQ(3, joints.get_estimated_angles().size());
+
+    Eigen::VectorXd angles;
+    joints.get_measured_angles(angles);
+    ASSERT_EQ(3, angles.size());
+}
+
+/*! The parameters need one entry per motor */
+TEST_F(TestBlmcJointModules, size_mismatch)
+{
+    Eigen::VectorXd ones = Eigen::VectorXd::Ones(3);
+    Eigen::VectorXd twos = Eigen::VectorXd::Constant(2, 2.0);
+    ASSERT_THROW(DynamicJointModules(motors_, ones, twos, ones, ones),
+                 std::invalid_argument);
+}
+
+/*! Torques are sent to and measured from the right motors */
+TEST_F(TestBlmcJointModules, torques)
+{
+    Eigen::VectorXd motor_constants(3), gear_ratios(3);
+    motor_constants << 0.025, 0.025, 0.025;
+    gear_ratios << 9.0, 9.0, 1.0;
+    DynamicJointModules joints(motors_,
+                               motor_constants,
+                               gear_ratios,
+                               Eigen::VectorXd::Zero(3),
+                               Eigen::VectorXd::Constant(3, 2.0));
+
+    Eigen::VectorXd torques(3);
+    torques << 0.1, -0.2, 0.01;
+    joints.set_torques(torques);
+    joints.send_torques();
+
+    Eigen::VectorXd measured_torques(3);
+    for (int i = 0; i < 1000; i++)
+    {
+        joints.get_measured_torques(measured_torques);
+        if (measured_torques.isApprox(torques, 1e-6))
+        {
+            break;
+        }
+        usleep(1000);
+    }
+    ASSERT_TRUE(measured_torques.isApprox(torques, 1e-6));
+    ASSERT_TRUE(joints.get_sent_torques().isApprox(torques, 1e-9));
+}
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
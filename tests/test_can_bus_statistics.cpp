@@ -0,0 +1,85 @@
+/**
+ * @file test_can_bus_statistics.cpp
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, Max Planck Gesellschaft.
+ * @brief Tests for the CAN bus statistics.
+ */
+#include <gtest/gtest.h>
+#include <cmath>
+
+#include "blmc_drivers/utils/can_bus_statistics.hpp"
+
+using namespace blmc_drivers;
+
+/*! Frame lengths match the CAN 2.0 frame format */
+TEST(TestCanBusStatistics, frame_bits)
+{
+    // 47 bits without stuffing, up to 8 stuff bits.
+    ASSERT_EQ(55u, CanBusStatistics::get_frame_bits(0x10, 0));
+    // 111 bits without stuffing, up to 24 stuff bits.
+    ASSERT_EQ(135u, CanBusStatistics::get_frame_bits(0x20, 8));
+    // extended: 131 bits without stuffing, up to 29 stuff bits.
+    ASSERT_EQ(160u, CanBusStatistics::get_frame_bits(0x80000020, 8));
+}
+
+/*! Frames are counted per id and in total */
+TEST(TestCanBusStatistics, counts)
+{
+    CanBusStatistics statistics(1e6);
+    statistics.reset(0.0);
+
+    // a board sending 4 frames each millisecond for 1 s.
+    for (int i = 0; i < 1000; i++)
+    {
+        for (uint32_t id : {0x20, 0x30, 0x40, 0x50})
+        {
+            statistics.record_received(id, 8, i * 1e-3);
+        }
+        statistics.record_sent(0x05, 8, i == 0 ? 3 : 0);
+    }
+    statistics.set_receive_overflows(7);
+
+    ASSERT_EQ(4000u, statistics.get_received_frames());
+    ASSERT_EQ(1000u, statistics.get_sent_frames());
+    ASSERT_EQ(32000u, statistics.get_received_bytes());
+    ASSERT_EQ(3u, statistics.get_transmit_retries());
+    ASSERT_EQ(7u, statistics.get_receive_overflows());
+    ASSERT_EQ(0u, statistics.get_untracked_frames());
+    ASSERT_NEAR(5000 * 135 / 1e6, statistics.get_bus_load(1.0), 1e-9);
+
+    ASSERT_EQ(5u, statistics.get_tracked_id_count());
+    const CanIdStatistics* position = statistics.find_id_statistics(0x30);
+    ASSERT_NE(nullptr, position);
+    ASSERT_EQ(1000u, position->get_received_frames());
+    ASSERT_EQ(0u, position->get_sent_frames());
+    ASSERT_EQ(999u, position->get_inter_arrival_times().get_count());
+    ASSERT_NEAR(1e-3, position->get_inter_arrival_times().get_percentile(50),
+                1e-3 * 0.04);
+    ASSERT_EQ(1000u, statistics.find_id_statistics(0x05)->get_sent_frames());
+    ASSERT_EQ(nullptr, statistics.find_id_statistics(0x60));
+}
+
+/*! Ids beyond the tracked ones are only counted in the totals */
+TEST(TestCanBusStatistics, untracked_ids)
+{
+    CanBusStatistics statistics;
+    for (uint32_t id = 0; id < CanBusStatistics::MAX_TRACKED_IDS + 3; id++)
+    {
+        statistics.record_received(id, 1, id * 1e-3);
+    }
+    ASSERT_EQ(CanBusStatistics::MAX_TRACKED_IDS,
+              statistics.get_tracked_id_count());
+    ASSERT_EQ(3u, statistics.get_untracked_frames());
+    ASSERT_EQ(CanBusStatistics::MAX_TRACKED_IDS + 3,
+              statistics.get_received_frames());
+
+    statistics.reset(0.0);
+    ASSERT_EQ(0u, statistics.get_tracked_id_count());
+    ASSERT_EQ(0u, statistics.get_received_frames());
+}
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,105 @@
+/**
+ * @file test_can_controller_monitor.cpp
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, Max Planck Gesellschaft.
+ * @brief Tests for the error state tracking of the CAN controller.
+ */
+#include <gtest/gtest.h>
+
+#include "blmc_drivers/devices/can_bus.hpp"
+
+using namespace blmc_drivers;
+
+namespace
+{
+/**
+ * @brief Make an error frame as reported by SocketCAN.
+ *
+ * @param error_class are the CAN_ERR_* bits of the id.
+ * @param controller_error are the CAN_ERR_CRTL_* bits (data[1]).
+ */
+CanBusFrame make_error_frame(const can_id_t& error_class,
+                             const uint8_t& controller_error = 0)
+{
+    CanBusFrame frame;
+    frame.data.fill(0);
+    frame.data[1] = controller_error;
+    frame.dlc = CAN_ERR_DLC;
+    frame.id = CAN_ERR_FLAG | error_class;
+    return frame;
+}
+
+}  // namespace
+
+/*! Controller errors move the state between active, warning and passive */
+TEST(TestCanControllerMonitor, error_levels)
+{
+    CanControllerMonitor monitor("test", 0.1);
+    ASSERT_EQ(CanBusInterface::ERROR_ACTIVE, monitor.get_state());
+
+    ASSERT_FALSE(monitor.process_error_frame(
+        make_error_frame(CAN_ERR_CRTL, CAN_ERR_CRTL_TX_WARNING), 0.0));
+    ASSERT_EQ(CanBusInterface::ERROR_WARNING, monitor.get_state());
+
+    ASSERT_FALSE(monitor.process_error_frame(
+        make_error_frame(CAN_ERR_CRTL,
+                         CAN_ERR_CRTL_RX_WARNING | CAN_ERR_CRTL_RX_PASSIVE),
+        0.0));
+    ASSERT_EQ(CanBusInterface::ERROR_PASSIVE, monitor.get_state());
+
+    ASSERT_FALSE(monitor.process_error_frame(
+        make_error_frame(CAN_ERR_CRTL, CAN_ERR_CRTL_ACTIVE), 0.0));
+    ASSERT_EQ(CanBusInterface::ERROR_ACTIVE, monitor.get_state());
+
+    // transmit timeouts and buffer overflows do not change the state.
+    ASSERT_FALSE(
+        monitor.process_error_frame(make_error_frame(CAN_ERR_TX_TIMEOUT), 0.0));
+    ASSERT_FALSE(monitor.process_error_frame(
+        make_error_frame(CAN_ERR_CRTL, CAN_ERR_CRTL_RX_OVERFLOW), 0.0));
+    ASSERT_EQ(CanBusInterface::ERROR_ACTIVE, monitor.get_state());
+    ASSERT_EQ(0u, monitor.get_bus_off_count());
+}
+
+/*! A bus-off is counted once and the restart is requested periodically */
+TEST(TestCanControllerMonitor, bus_off_and_restart)
+{
+    CanControllerMonitor monitor("test", 0.1);
+    ASSERT_FALSE(monitor.should_restart(10.0));
+
+    ASSERT_TRUE(
+        monitor.process_error_frame(make_error_frame(CAN_ERR_BUSOFF), 1.0));
+    ASSERT_EQ(CanBusInterface::BUS_OFF, monitor.get_state());
+    ASSERT_EQ(1u, monitor.get_bus_off_count());
+
+    // repeated reports of the same bus-off.
+    ASSERT_FALSE(
+        monitor.process_error_frame(make_error_frame(CAN_ERR_BUSOFF), 1.05));
+    ASSERT_EQ(1u, monitor.get_bus_off_count());
+
+    // restart after the delay, and again if the first one had no effect.
+    ASSERT_FALSE(monitor.should_restart(1.05));
+    ASSERT_TRUE(monitor.should_restart(1.125));
+    ASSERT_FALSE(monitor.should_restart(1.2));
+    ASSERT_TRUE(monitor.should_restart(1.25));
+    ASSERT_EQ(CanBusInterface::BUS_OFF, monitor.get_state());
+
+    ASSERT_FALSE(
+        monitor.process_error_frame(make_error_frame(CAN_ERR_RESTARTED), 1.3));
+    ASSERT_EQ(CanBusInterface::ERROR_ACTIVE, monitor.get_state());
+    ASSERT_FALSE(monitor.should_restart(2.0));
+
+    // a second bus-off, ended by a regular frame without restart report.
+    ASSERT_TRUE(
+        monitor.process_error_frame(make_error_frame(CAN_ERR_BUSOFF), 3.0));
+    ASSERT_EQ(2u, monitor.get_bus_off_count());
+    monitor.process_frame();
+    ASSERT_EQ(CanBusInterface::ERROR_ACTIVE, monitor.get_state());
+    ASSERT_FALSE(monitor.should_restart(4.0));
+    ASSERT_EQ(2u, monitor.get_bus_off_count());
+}
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
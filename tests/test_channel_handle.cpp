@@ -0,0 +1,88 @@
+/**
+ * @file test_channel_handle.cpp
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, Max Planck Gesellschaft.
+ * @brief Tests for the channel handles of the motors.
+ */
+#include <gtest/gtest.h>
+#include <memory>
+
+#include "blmc_drivers/devices/loopback_can_bus.hpp"
+#include "blmc_drivers/devices/motor.hpp"
+#include "blmc_drivers/devices/motor_board.hpp"
+#include "blmc_drivers/utils/channel_handle.hpp"
+
+using namespace blmc_drivers;
+
+/*! A default constructed handle is invalid */
+TEST(TestChannelHandle, invalid_by_default)
+{
+    ScalarChannel channel;
+    ASSERT_FALSE(channel.is_valid());
+}
+
+/*! Reading through a handle gives the same data as through the time series */
+TEST(TestChannelHandle, reads_time_series)
+{
+    ScalarChannel::Timeseries timeseries(10, 0, false);
+    ScalarChannel channel(&timeseries);
+    ASSERT_TRUE(channel.is_valid());
+    ASSERT_EQ(0.5, channel.newest_element_or(0.5));
+
+    timeseries.append(1.0);
+    timeseries.append(2.0);
+    ASSERT_EQ(2u, channel.length());
+    ASSERT_EQ(2.0, channel.newest_element());
+    ASSERT_EQ(2.0, channel.newest_element_or(0.5));
+    ASSERT_EQ(1, channel.newest_timeindex());
+    ASSERT_EQ(1.0, channel[0]);
+}
+
+/*! The handles of a motor refer to the time series of its board */
+TEST(TestChannelHandle, motor_channels)
+{
+    auto can_bus = std::make_shared<LoopbackCanBus>();
+    auto board = std::make_shared<CanBusMotorBoard>(can_bus);
+    auto motor = std::make_shared<Motor>(board, 1);
+
+    ASSERT_EQ(board->get_measurement(MotorBoardInterface::position_1).get(),
+              &motor->get_measurement_channel(Motor::position).get());
+    ASSERT_EQ(
+        board->get_measurement(MotorBoardInterface::encoder_index_1).get(),
+        &motor->get_measurement_channel(Motor::encoder_index).get());
+    ASSERT_EQ(board->get_control(MotorBoardInterface::current_target_1).get(),
+              &motor->get_current_target_channel().get());
+    ASSERT_EQ(
+        board->get_sent_control(MotorBoardInterface::current_target_1).get(),
+        &motor->get_sent_current_target_channel().get());
+    ASSERT_THROW(motor->get_measurement_channel(Motor::measurement_count),
+                 std::invalid_argument);
+
+    // copying a handle does not touch the reference count.
+    auto position = motor->get_measurement(Motor::position);
+    long use_count = position.use_count();
+    ScalarChannel channel = motor->get_measurement_channel(Motor::position);
+    ScalarChannel copy = channel;
+    ASSERT_TRUE(copy.is_valid());
+    ASSERT_EQ(use_count, position.use_count());
+}
+
+/*! SafeMotor exposes its own (not yet limited) current targets */
+TEST(TestChannelHandle, safe_motor_current_target)
+{
+    auto can_bus = std::make_shared<LoopbackCanBus>();
+    auto board = std::make_shared<CanBusMotorBoard>(can_bus);
+    auto motor = std::make_shared<SafeMotor>(board, 0, 1.0);
+
+    motor->set_current_target(3.0);
+    ASSERT_EQ(3.0, motor->get_current_target_channel().newest_element());
+    ASSERT_EQ(1.0,
+              board->get_control(MotorBoardInterface::current_target_0)
+                  ->newest_element());
+}
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,131 @@
+/**
+ * @file test_encoder_index_events.cpp
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, Max Planck Gesellschaft.
+ * @brief Tests for the encoder index events of the motor board and their use
+ * by the homing.
+ */
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <cmath>
+#include <memory>
+
+#include "blmc_drivers/blmc_joint_module.hpp"
+#include "blmc_drivers/devices/motor.hpp"
+#include "blmc_drivers/devices/motor_board.hpp"
+#include "scripted_can_bus.hpp"
+
+using namespace blmc_drivers;
+
+class TestEncoderIndexEvents : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        can_bus_ = std::make_shared<ScriptedCanBus>();
+        board_ = std::make_shared<CanBusMotorBoard>(can_bus_, 100);
+
+        // the board processes the frames from the newest one when its
+        // thread starts, wait until it did.
+        can_bus_->receive(ScriptedCanBus::STATUSMSG, 0.0, 0.0);
+        ASSERT_TRUE(board_->get_status()->wait_for_timeindex(0, 1.0));
+    }
+
+    std::shared_ptr<ScriptedCanBus> can_bus_;
+    std::shared_ptr<CanBusMotorBoard> board_;
+};
+
+/*! The event carries the samples before the index and the interpolated time
+ * at which it was passed */
+TEST_F(TestEncoderIndexEvents, interpolation)
+{
+    auto events = board_->get_encoder_index_events(1);
+    ASSERT_EQ(0u, events->length());
+
+    // motor 1 at 0 rad, turning at one rotation per second.
+    time_series::Index position_frame =
+        can_bus_->receive(ScriptedCanBus::POS, 0.0, 0.0);
+    can_bus_->receive(ScriptedCanBus::SPEED, 0.0, 0.06);
+    usleep(200000);
+    // index after a tenth of a rotation.
+    time_series::Index index_frame = can_bus_->receive_index(1, 0.1);
+
+    ASSERT_TRUE(events->wait_for_timeindex(0, 1.0));
+    EncoderIndexEvent event = (*events)[0];
+    auto frames = can_bus_->get_output_frame();
+    double position_time_s = frames->timestamp_s(position_frame);
+    ASSERT_EQ(1, event.motor);
+    ASSERT_NEAR(0.2 * M_PI, event.index_position, 1e-6);
+    ASSERT_NEAR(0.0, event.previous_position, 1e-6);
+    ASSERT_NEAR(2 * M_PI, event.velocity, 1e-6);
+    ASSERT_DOUBLE_EQ(position_time_s, event.previous_position_time_s);
+    ASSERT_DOUBLE_EQ(frames->timestamp_s(index_frame), event.received_time_s);
+    ASSERT_NEAR(position_time_s + 0.1, event.crossing_time_s, 1e-6);
+
+    // the measurement is appended as well, the other motor saw nothing.
+    ASSERT_NEAR(0.2 * M_PI,
+                board_->get_measurement(CanBusMotorBoard::encoder_index_1)
+                    ->newest_element(),
+                1e-6);
+    ASSERT_EQ(0u, board_->get_encoder_index_events(0)->length());
+}
+
+/*! Without velocity, the index is placed at the reception of the frame */
+TEST_F(TestEncoderIndexEvents, no_velocity)
+{
+    time_series::Index index_frame = can_bus_->receive_index(0, 0.1);
+
+    auto events = board_->get_encoder_index_events(0);
+    ASSERT_TRUE(events->wait_for_timeindex(0, 1.0));
+    EncoderIndexEvent event = (*events)[0];
+    ASSERT_TRUE(std::isnan(event.previous_position));
+    ASSERT_TRUE(std::isnan(event.velocity));
+    ASSERT_DOUBLE_EQ(can_bus_->get_output_frame()->timestamp_s(index_frame),
+                     event.crossing_time_s);
+}
+
+/*! The homing can wait for the index and reacts to its event */
+TEST_F(TestEncoderIndexEvents, homing)
+{
+    auto motor = std::make_shared<Motor>(board_, 1);
+    ASSERT_EQ(board_->get_encoder_index_events(1),
+              motor->get_encoder_index_events());
+    BlmcJointModule joint(motor, 1.0, 2.0, 0.0, false, 2.0);
+    ASSERT_NE(nullptr, joint.get_encoder_index_events());
+
+    can_bus_->receive(ScriptedCanBus::POS, 0.0, 0.0);
+    ASSERT_TRUE(board_->get_measurement(CanBusMotorBoard::position_1)
+                    ->wait_for_timeindex(0, 1.0));
+
+    // nothing to wait for without homing.
+    ASSERT_FALSE(joint.wait_for_pending_encoder_index(0.01));
+
+    joint.init_homing(0, 1.0, 0.1);
+    ASSERT_FALSE(joint.has_pending_encoder_index());
+    ASSERT_FALSE(joint.wait_for_pending_encoder_index(0.01));
+    ASSERT_EQ(HomingReturnCode::RUNNING, joint.update_homing());
+
+    can_bus_->receive_index(1, 0.1);
+    ASSERT_TRUE(joint.wait_for_pending_encoder_index(1.0));
+    ASSERT_TRUE(joint.has_pending_encoder_index());
+
+    ASSERT_EQ(HomingReturnCode::SUCCEEDED, joint.update_homing());
+    ASSERT_FALSE(joint.has_pending_encoder_index());
+    // the index is at a tenth of a motor rotation, i.e. 0.1 * M_PI joint rad.
+    ASSERT_NEAR(0.1 * M_PI + 0.1, joint.get_zero_angle(), 1e-6);
+
+    // in joint angles the index is where the homing put it.
+    long int index =
+        joint.get_motor_measurement_index(MotorInterface::encoder_index);
+    ASSERT_LE(0, index);
+    double angle, timestamp_s;
+    ASSERT_TRUE(joint.get_joint_sample(
+        MotorInterface::encoder_index, index, angle, timestamp_s));
+    ASSERT_NEAR(-0.1, angle, 1e-6);
+}
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
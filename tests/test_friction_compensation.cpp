@@ -0,0 +1,136 @@
+/**
+ * @file test_friction_compensation.cpp
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, Max Planck Gesellschaft.
+ * @brief Tests for the friction table and its calibration.
+ */
+#include <gtest/gtest.h>
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+
+#include "blmc_drivers/blmc_joint_module.hpp"
+#include "blmc_drivers/utils/friction_table.hpp"
+#include "simulated_motor.hpp"
+
+using namespace blmc_drivers;
+
+namespace
+{
+/**
+ * @brief Friction and cogging torque (Nm) of the simulated joint.
+ */
+double get_friction(const double& position, const double& velocity)
+{
+    return 0.1 * std::tanh(velocity / 0.01) + 0.05 * velocity +
+           0.02 * std::sin(4 * position);
+}
+
+}  // namespace
+
+/*! The table interpolates between its nodes and clamps outside */
+TEST(TestFrictionTable, lookup)
+{
+    FrictionTable table(0.0, 2.0, 3, false, 1.0, 3);
+    ASSERT_EQ(1.0, table.get_position(1));
+    ASSERT_EQ(-1.0, table.get_velocity(0));
+    for (size_t i = 0; i < 3; i++)
+    {
+        for (size_t j = 0; j < 3; j++)
+        {
+            table.set_value(i, j, 10.0 * i + j);
+        }
+    }
+
+    ASSERT_DOUBLE_EQ(11.0, table.lookup(1.0, 0.0));
+    ASSERT_DOUBLE_EQ(16.5, table.lookup(1.5, 0.5));
+    ASSERT_DOUBLE_EQ(20.0, table.lookup(5.0, -3.0));
+    ASSERT_DOUBLE_EQ(2.0, table.lookup(-1.0, 3.0));
+    ASSERT_EQ(0.0, table.lookup(NAN, 0.0));
+    ASSERT_EQ(2u, table.get_position_node(1.7));
+    ASSERT_EQ(0u, table.get_position_node(-1.0));
+}
+
+/*! A periodic table wraps around */
+TEST(TestFrictionTable, periodic)
+{
+    FrictionTable table(0.0, 4.0, 4, true, 1.0, 2);
+    ASSERT_EQ(3.0, table.get_position(3));
+    for (size_t i = 0; i < 4; i++)
+    {
+        table.set_value(i, 0, i);
+        table.set_value(i, 1, i);
+    }
+
+    ASSERT_DOUBLE_EQ(1.0, table.lookup(5.0, 0.0));
+    ASSERT_DOUBLE_EQ(1.5, table.lookup(3.5, 0.0));
+    ASSERT_DOUBLE_EQ(1.5, table.lookup(-0.5, 0.0));
+    ASSERT_EQ(0u, table.get_position_node(3.9));
+    ASSERT_EQ(3u, table.get_position_node(-1.0));
+
+    ASSERT_THROW(FrictionTable(0.0, 0.0, 4, true, 1.0, 2),
+                 std::invalid_argument);
+}
+
+/*! The calibration finds the friction and cogging of a simulated joint, and
+ * the compensation adds it to the torques */
+TEST(TestFrictionCalibration, simulated_joint)
+{
+    auto motor = std::make_shared<SimulatedMotor>();
+    motor->set_friction(&get_friction);
+    BlmcJointModule joint(motor, 1.0, 1.0, 0.0, false, 2.0);
+
+    FrictionCalibrationParameters parameters;
+    parameters.position_min = -1.0;
+    parameters.position_max = 1.0;
+    parameters.position_node_count = 41;
+    parameters.max_velocity = 1.0;
+    parameters.velocity_level_count = 2;
+    parameters.max_torque = 1.0;
+    joint.init_friction_calibration(parameters);
+
+    CalibrationReturnCode status = CalibrationReturnCode::RUNNING;
+    for (int i = 0; i < 60000 && status == CalibrationReturnCode::RUNNING; i++)
+    {
+        status = joint.update_friction_calibration();
+    }
+    ASSERT_EQ(CalibrationReturnCode::SUCCEEDED, status);
+
+    std::shared_ptr<FrictionTable> table =
+        joint.get_friction_calibration_table();
+    ASSERT_EQ(5u, table->get_velocity_node_count());
+    for (double position = -0.9; position < 0.85; position += 0.1)
+    {
+        for (double velocity : {-1.0, -0.5, 0.5, 1.0})
+        {
+            ASSERT_NEAR(get_friction(position, velocity),
+                        table->lookup(position, velocity),
+                        0.01)
+                << "at " << position << " rad, " << velocity << " rad/s";
+        }
+        // only the cogging at standstill.
+        ASSERT_NEAR(0.02 * std::sin(4 * position),
+                    table->lookup(position, 0.0),
+                    0.01);
+    }
+
+    // the compensation is added to the torque.
+    joint.set_friction_compensation(table);
+    double position = joint.get_measured_angle();
+    double velocity = joint.get_measured_velocity();
+    joint.set_torque(0.1);
+    ASSERT_DOUBLE_EQ(0.1 + table->lookup(position, velocity),
+                     motor->get_current_target()->newest_element());
+
+    // but limited to the max. current.
+    double max_torque =
+        table->lookup(position, velocity) > 0 ? 2.0 : -2.0;
+    joint.set_torque(max_torque);
+    ASSERT_DOUBLE_EQ(max_torque, motor->get_current_target()->newest_element());
+}
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
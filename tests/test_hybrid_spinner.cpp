@@ -0,0 +1,86 @@
+/**
+ * @file test_hybrid_spinner.cpp
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, Max Planck Gesellschaft.
+ * @brief Tests for the hybrid spinner.
+ */
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include "blmc_drivers/utils/hybrid_spinner.hpp"
+
+using namespace blmc_drivers;
+
+/*! A 4 kHz loop keeps its period on average and never returns early */
+TEST(TestHybridSpinner, keeps_period)
+{
+    const double period_s = 250e-6;
+    const int spin_count = 400;
+    HybridSpinner spinner(period_s);
+
+    int64_t start_ns = HybridSpinner::get_monotonic_time_ns();
+    for (int i = 0; i < spin_count; i++)
+    {
+        spinner.spin();
+    }
+    double duration_s =
+        (HybridSpinner::get_monotonic_time_ns() - start_ns) * 1e-9;
+
+    ASSERT_EQ(uint64_t(spin_count), spinner.get_spin_count());
+    ASSERT_EQ(uint64_t(spin_count - 1), spinner.get_periods().get_count());
+    ASSERT_EQ(uint64_t(spin_count), spinner.get_wakeup_latencies().get_count());
+    ASSERT_GE(spinner.get_wakeup_latencies().get_min(), 0.0);
+    // without overruns the deadlines do not drift.
+    ASSERT_GE(duration_s, spin_count * period_s * 0.99);
+    if (spinner.get_overrun_count() == 0)
+    {
+        ASSERT_NEAR(
+            period_s, spinner.get_periods().get_mean(), 0.05 * period_s);
+    }
+}
+
+/*! Late calls are counted and missed periods are skipped */
+TEST(TestHybridSpinner, overruns)
+{
+    const double period_s = 0.001;
+    HybridSpinner spinner(period_s);
+
+    for (int i = 0; i < 5; i++)
+    {
+        usleep(2500);
+        spinner.spin();
+    }
+    ASSERT_EQ(5u, spinner.get_overrun_count());
+    // the next deadline is a full period after the last overrun.
+    int64_t start_ns = HybridSpinner::get_monotonic_time_ns();
+    spinner.spin();
+    double wait_s = (HybridSpinner::get_monotonic_time_ns() - start_ns) * 1e-9;
+    ASSERT_GE(wait_s, period_s * 0.9);
+    ASSERT_EQ(5u, spinner.get_overrun_count());
+
+    spinner.reset_statistics();
+    ASSERT_EQ(0u, spinner.get_overrun_count());
+    ASSERT_EQ(0u, spinner.get_periods().get_count());
+}
+
+/*! A new period also applies to the current one */
+TEST(TestHybridSpinner, set_period)
+{
+    HybridSpinner spinner(0.001);
+    int64_t start_ns = spinner.get_deadline_ns() - 1000000;
+
+    spinner.set_period(0.05);
+    ASSERT_EQ(start_ns + 50000000, spinner.get_deadline_ns());
+    spinner.set_period(0.002);
+    ASSERT_EQ(start_ns + 2000000, spinner.get_deadline_ns());
+
+    spinner.spin();
+    ASSERT_GE(HybridSpinner::get_monotonic_time_ns(), start_ns + 2000000);
+    ASSERT_NEAR(0.002, spinner.get_period(), 1e-12);
+}
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
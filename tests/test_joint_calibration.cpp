@@ -0,0 +1,134 @@
+/**
+ * @file test_joint_calibration.cpp
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, Max Planck Gesellschaft.
+ * @brief Tests for the calibration of the joints on their encoder index.
+ */
+#include <gtest/gtest.h>
+#include <cmath>
+#include <memory>
+
+#include "blmc_drivers/blmc_joint_module.hpp"
+#include "simulated_motor.hpp"
+
+using namespace blmc_drivers;
+
+typedef BlmcJointModules<Eigen::Dynamic> DynamicJointModules;
+
+/*! With mechanical calibration, the joint finds the index and returns to
+ * where it started */
+TEST(TestJointCalibration, mechanical_calibration)
+{
+    auto motor = std::make_shared<SimulatedMotor>(0.1, 0.4);
+    BlmcJointModule joint(motor, 1.0, 1.0, 0.0, false, 2.0);
+
+    CalibrationParameters parameters;
+    parameters.return_duration_s = 0.5;
+    joint.init_calibration(0, 0.0, true, parameters);
+
+    CalibrationReturnCode status = CalibrationReturnCode::RUNNING;
+    int step_count = 0;
+    for (; step_count < 20000 && status == CalibrationReturnCode::RUNNING;
+         step_count++)
+    {
+        status = joint.update_calibration();
+    }
+    ASSERT_EQ(CalibrationReturnCode::SUCCEEDED, status);
+    ASSERT_NEAR(0.4, joint.get_calibration_index_angle(), 1e-9);
+    ASSERT_NEAR(0.3, joint.get_calibration_angle_zero_to_index(), 1e-9);
+    ASSERT_NEAR(0.1, joint.get_zero_angle(), 1e-9);
+    ASSERT_NEAR(0.1, motor->get_position(), 1e-2);
+
+    // the joint is held at the zero position afterwards.
+    for (int i = 0; i < 1000; i++)
+    {
+        ASSERT_EQ(CalibrationReturnCode::SUCCEEDED, joint.update_calibration());
+    }
+    ASSERT_NEAR(0.0, joint.get_measured_angle(), 1e-2);
+}
+
+/*! The search can go in negative direction */
+TEST(TestJointCalibration, negative_search)
+{
+    auto motor = std::make_shared<SimulatedMotor>(0.1, 0.4);
+    BlmcJointModule joint(motor, 1.0, 1.0, 0.0, false, 2.0);
+
+    CalibrationParameters parameters;
+    parameters.search_velocity = -0.8;
+    parameters.return_duration_s = 0.5;
+    joint.init_calibration(0, 0.2, false, parameters);
+
+    CalibrationReturnCode status = CalibrationReturnCode::RUNNING;
+    for (int i = 0; i < 20000 && status == CalibrationReturnCode::RUNNING; i++)
+    {
+        status = joint.update_calibration();
+    }
+    ASSERT_EQ(CalibrationReturnCode::SUCCEEDED, status);
+    ASSERT_NEAR(-0.6, joint.get_calibration_index_angle(), 1e-9);
+    ASSERT_NEAR(-0.8, joint.get_zero_angle(), 1e-9);
+    ASSERT_NEAR(-0.8, motor->get_position(), 1e-2);
+}
+
+/*! Without index, the calibration fails after the timeout and stops the
+ * joint */
+TEST(TestJointCalibration, timeout)
+{
+    auto motor = std::make_shared<SimulatedMotor>(0.0, 0.5, 1e6);
+    BlmcJointModule joint(motor, 1.0, 1.0, 0.0, false, 2.0);
+
+    ASSERT_EQ(CalibrationReturnCode::NOT_INITIALIZED,
+              joint.update_calibration());
+
+    CalibrationParameters parameters;
+    parameters.timeout_s = 0.2;
+    joint.init_calibration(0, 0.0, false, parameters);
+
+    int step_count = 0;
+    while (joint.update_calibration() == CalibrationReturnCode::RUNNING)
+    {
+        step_count++;
+    }
+    ASSERT_EQ(200, step_count);
+    ASSERT_EQ(CalibrationReturnCode::FAILED, joint.update_calibration());
+    ASSERT_EQ(0.0, motor->get_current_target()->newest_element());
+}
+
+/*! All joints are calibrated in the same loop */
+TEST(TestJointCalibration, calibrate_all)
+{
+    auto first_motor = std::make_shared<SimulatedMotor>(0.0, 0.3);
+    auto second_motor = std::make_shared<SimulatedMotor>(0.5, 0.3);
+    DynamicJointModules::MotorArray motors = {first_motor, second_motor};
+    Eigen::VectorXd ones = Eigen::VectorXd::Ones(2);
+    DynamicJointModules joints(motors, ones, ones, 0 * ones, 2 * ones);
+
+    DynamicJointModules::Array<CalibrationParameters> parameters(2);
+    parameters[0].return_duration_s = 0.2;
+    parameters[1].return_duration_s = 0.2;
+    parameters[1].gain_p = 5.0;
+
+    Eigen::VectorXd angle_zero_to_index(2), index_angle(2);
+    angle_zero_to_index << 0.1, -0.2;
+    ASSERT_EQ(CalibrationReturnCode::SUCCEEDED,
+              joints.calibrate_all(
+                  angle_zero_to_index, index_angle, false, parameters));
+
+    ASSERT_NEAR(0.3, index_angle[0], 1e-9);
+    ASSERT_NEAR(1.3, index_angle[1], 1e-9);
+    ASSERT_DOUBLE_EQ(0.1, angle_zero_to_index[0]);
+    ASSERT_DOUBLE_EQ(-0.2, angle_zero_to_index[1]);
+    ASSERT_NEAR(0.2, joints.get_zero_angles()[0], 1e-9);
+    ASSERT_NEAR(1.5, joints.get_zero_angles()[1], 1e-9);
+    ASSERT_NEAR(0.0, joints.get_measured_angles()[0], 2e-2);
+    ASSERT_NEAR(0.0, joints.get_measured_angles()[1], 2e-2);
+
+    // zero torques at the end.
+    ASSERT_EQ(0.0, joints.get_sent_torques()[0]);
+    ASSERT_EQ(0.0, joints.get_sent_torques()[1]);
+}
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,99 @@
+/**
+ * @file test_latency_histogram.cpp
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, Max Planck Gesellschaft.
+ * @brief Tests for the latency histogram.
+ */
+#include <gtest/gtest.h>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+#include "blmc_drivers/utils/latency_histogram.hpp"
+
+using namespace blmc_drivers;
+
+/*! Every latency lies in its bucket and the buckets are contiguous */
+TEST(TestLatencyHistogram, buckets)
+{
+    int64_t lower_bound = 0;
+    for (size_t i = 0; i < LatencyHistogram::BUCKET_COUNT - 1; i++)
+    {
+        int64_t upper_bound = LatencyHistogram::get_bucket_upper_bound(i);
+        ASSERT_GE(upper_bound, lower_bound);
+        ASSERT_EQ(i, LatencyHistogram::get_bucket_index(lower_bound));
+        ASSERT_EQ(i, LatencyHistogram::get_bucket_index(upper_bound));
+        // bounded relative error.
+        ASSERT_LE(upper_bound - lower_bound,
+                  std::max<int64_t>(lower_bound * 2 /
+                                        LatencyHistogram::SUB_BUCKET_COUNT,
+                                    0));
+        lower_bound = upper_bound + 1;
+    }
+    // the regular buckets cover the whole range, the last bucket takes all
+    // larger latencies.
+    ASSERT_EQ(int64_t(1) << LatencyHistogram::MAX_EXPONENT, lower_bound);
+    ASSERT_EQ(LatencyHistogram::BUCKET_COUNT - 1,
+              LatencyHistogram::get_bucket_index(lower_bound));
+    ASSERT_EQ(LatencyHistogram::BUCKET_COUNT - 1,
+              LatencyHistogram::get_bucket_index(int64_t(1) << 50));
+}
+
+/*! The percentiles of a uniform distribution are within the precision */
+TEST(TestLatencyHistogram, percentiles)
+{
+    LatencyHistogram histogram;
+    ASSERT_EQ(0u, histogram.get_count());
+    ASSERT_TRUE(std::isnan(histogram.get_percentile(50)));
+
+    // 1 us to 10 ms
+    for (int64_t i = 1; i <= 10000; i++)
+    {
+        histogram.record(i * 1e-6);
+    }
+    ASSERT_EQ(10000u, histogram.get_count());
+    ASSERT_NEAR(1e-6, histogram.get_min(), 1e-12);
+    ASSERT_NEAR(10e-3, histogram.get_max(), 1e-12);
+    ASSERT_NEAR(5.0005e-3, histogram.get_mean(), 1e-9);
+
+    for (double percentile : {1.0, 10.0, 50.0, 90.0, 99.0, 99.9})
+    {
+        double expected = percentile / 100 * 10e-3;
+        ASSERT_GE(histogram.get_percentile(percentile), expected - 1e-9);
+        ASSERT_LE(histogram.get_percentile(percentile), expected * 1.04);
+    }
+    ASSERT_DOUBLE_EQ(histogram.get_max(), histogram.get_percentile(100));
+
+    histogram.reset();
+    ASSERT_EQ(0u, histogram.get_count());
+    ASSERT_TRUE(std::isnan(histogram.get_max()));
+}
+
+/*! Concurrent recording does not lose latencies */
+TEST(TestLatencyHistogram, concurrent_record)
+{
+    LatencyHistogram histogram;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++)
+    {
+        threads.emplace_back([&histogram, t]() {
+            for (int64_t i = 0; i < 100000; i++)
+            {
+                histogram.record_ns(t * 1000 + i % 1000);
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    ASSERT_EQ(400000u, histogram.get_count());
+    ASSERT_NEAR(0.0, histogram.get_min(), 1e-12);
+    ASSERT_NEAR(3999e-9, histogram.get_max(), 1e-12);
+}
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,132 @@
+/**
+ * @file test_leg_impedance_controller.cpp
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, Max Planck Gesellschaft.
+ * @brief Tests for the impedance controller running in the board thread.
+ */
+#include <gtest/gtest.h>
+#include <cmath>
+#include <memory>
+
+#include "blmc_drivers/leg_impedance_controller.hpp"
+#include "scripted_can_bus.hpp"
+
+using namespace blmc_drivers;
+
+class TestLegImpedanceController : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        can_bus_ = std::make_shared<ScriptedCanBus>();
+        board_ = std::make_shared<CanBusMotorBoard>(can_bus_, 100);
+
+        // the board processes the frames from the newest one when its
+        // thread starts, wait until it did.
+        can_bus_->receive(ScriptedCanBus::STATUSMSG, 0.0, 0.0);
+        ASSERT_TRUE(board_->get_status()->wait_for_timeindex(0, 1.0));
+
+        parameters_.gear_ratios << 1.0, 1.0;
+        parameters_.motor_constants << 1.0, 1.0;
+    }
+
+    /**
+     * @brief Receive the positions (rotations) and then the velocities of
+     * the motors, wait until the board processed them.
+     */
+    void receive_state(const double& hip_position,
+                       const double& knee_position)
+    {
+        can_bus_->receive(ScriptedCanBus::POS, hip_position, knee_position);
+        can_bus_->receive(ScriptedCanBus::SPEED, 0.0, 0.0);
+        wait_for_board();
+    }
+
+    /**
+     * @brief Wait until the board (and the controller) processed all frames
+     * received so far.
+     */
+    void wait_for_board()
+    {
+        // the frames are processed in order, so the status comes last.
+        auto status = board_->get_status();
+        time_series::Index next_index = status->newest_timeindex() + 1;
+        can_bus_->receive(ScriptedCanBus::STATUSMSG, 0.0, 0.0);
+        ASSERT_TRUE(status->wait_for_timeindex(next_index, 1.0));
+    }
+
+    std::shared_ptr<ScriptedCanBus> can_bus_;
+    std::shared_ptr<CanBusMotorBoard> board_;
+    LegKinematicsParameters parameters_;
+};
+
+/*! The controller applies the impedance force at each new state of the leg,
+ * but only once it has a target */
+TEST_F(TestLegImpedanceController, control)
+{
+    LegImpedanceController controller(board_, 0, board_, 1, parameters_);
+
+    // hip at 0, knee at 90 degrees, i.e. the foot at (-0.16, -0.16).
+    receive_state(0.0, 0.25);
+    ASSERT_EQ(0u, controller.get_step_count());
+
+    // 1 N upwards, i.e. 0.16 Nm at both joints.
+    LegImpedanceTarget target;
+    target.stiffness.diagonal() << 100.0, 100.0;
+    target.foot_position << -0.16, -0.15;
+    controller.set_target(target);
+    receive_state(0.0, 0.25);
+    ASSERT_EQ(1u, controller.get_step_count());
+    ASSERT_NEAR(
+        0.16,
+        board_->get_control(MotorBoardInterface::current_target_0)
+            ->newest_element(),
+        1e-6);
+    ASSERT_NEAR(
+        0.16,
+        board_->get_control(MotorBoardInterface::current_target_1)
+            ->newest_element(),
+        1e-6);
+    auto leg = controller.get_leg();
+    ASSERT_NEAR(0.16,
+                leg->get_current_target(LegInterface::hip)->newest_element(),
+                1e-6);
+
+    // a position alone does not trigger a step.
+    can_bus_->receive(ScriptedCanBus::POS, 0.0, 0.25);
+    wait_for_board();
+    ASSERT_EQ(1u, controller.get_step_count());
+
+    // the feed-forward force is added.
+    target.foot_force << 0.0, 1.0;
+    controller.set_target(target);
+    can_bus_->receive(ScriptedCanBus::SPEED, 0.0, 0.0);
+    wait_for_board();
+    ASSERT_EQ(2u, controller.get_step_count());
+    ASSERT_NEAR(
+        0.32,
+        board_->get_control(MotorBoardInterface::current_target_0)
+            ->newest_element(),
+        1e-6);
+}
+
+/*! Hip and knee need different motors, the board is released again */
+TEST_F(TestLegImpedanceController, construction)
+{
+    ASSERT_THROW(LegImpedanceController(board_, 1, board_, 1, parameters_),
+                 std::invalid_argument);
+
+    {
+        LegImpedanceController controller(board_, 1, board_, 0, parameters_);
+        controller.set_target(LegImpedanceTarget());
+        receive_state(0.0, 0.0);
+        ASSERT_EQ(1u, controller.get_step_count());
+    }
+    receive_state(0.0, 0.0);
+}
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,197 @@
+/**
+ * @file test_leg_kinematics.cpp
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, Max Planck Gesellschaft.
+ * @brief Tests for the kinematics of the legs.
+ */
+#include <gtest/gtest.h>
+#include <array>
+#include <cmath>
+#include <memory>
+
+#include "blmc_drivers/leg_kinematics.hpp"
+
+using namespace blmc_drivers;
+
+namespace
+{
+/**
+ * @brief Leg whose measurements are set by the test.
+ */
+class FakeLeg : public LegInterface
+{
+public:
+    FakeLeg()
+    {
+        for (int motor = 0; motor < motor_count; motor++)
+        {
+            for (auto& measurement : measurements_[motor])
+            {
+                measurement = std::make_shared<ScalarTimeseries>(10, 0, false);
+            }
+            current_targets_[motor] =
+                std::make_shared<ScalarTimeseries>(10, 0, false);
+        }
+    }
+
+    Ptr<const ScalarTimeseries> get_motor_measurement(
+        const int& motor_index, const int& measurement_index) const override
+    {
+        return measurements_[motor_index][measurement_index];
+    }
+
+    Ptr<const ScalarTimeseries> get_current_target(
+        const int& motor_index) const override
+    {
+        return current_targets_[motor_index];
+    }
+
+    Ptr<const ScalarTimeseries> get_sent_current_target(
+        const int& motor_index) const override
+    {
+        return current_targets_[motor_index];
+    }
+
+    void set_current_target(const double& current_target,
+                            const int& motor_index) override
+    {
+        current_targets_[motor_index]->append(current_target);
+    }
+
+    void send_if_input_changed() override
+    {
+        send_count++;
+    }
+
+    void measure(const int& motor_index,
+                 const double& motor_position,
+                 const double& motor_velocity)
+    {
+        measurements_[motor_index][position]->append(motor_position);
+        measurements_[motor_index][velocity]->append(motor_velocity);
+    }
+
+    int send_count = 0;
+
+private:
+    std::array<std::array<Ptr<ScalarTimeseries>, motor_measurement_count>,
+               motor_count>
+        measurements_;
+    std::array<Ptr<ScalarTimeseries>, motor_count> current_targets_;
+};
+
+}  // namespace
+
+/*! The foot positions follow the geometry of the leg and the Jacobians
+ * their derivatives */
+TEST(TestLegKinematics, forward_kinematics)
+{
+    std::array<LegKinematicsParameters, 2> parameters;
+    parameters[1].upper_leg_length = 0.2;
+    parameters[1].lower_leg_length = 0.1;
+    LegKinematics<2> kinematics({std::make_shared<FakeLeg>(),
+                                 std::make_shared<FakeLeg>()},
+                                parameters);
+
+    // stretched down and knee bent by 90 degrees.
+    LegKinematics<2>::LegVectors angles, velocities;
+    angles << 0.0, 0.0, 0.0, M_PI / 2;
+    velocities << 1.0, 0.0, 0.0, 2.0;
+    kinematics.update(angles, velocities);
+    ASSERT_NEAR(0.0, kinematics.get_foot_positions()(0, 0), 1e-12);
+    ASSERT_NEAR(-0.32, kinematics.get_foot_positions()(1, 0), 1e-12);
+    ASSERT_NEAR(-0.1, kinematics.get_foot_positions()(0, 1), 1e-12);
+    ASSERT_NEAR(-0.2, kinematics.get_foot_positions()(1, 1), 1e-12);
+
+    // the hip turns the straight leg backwards, the knee moves the foot up.
+    ASSERT_NEAR(-0.32, kinematics.get_foot_velocities()(0, 0), 1e-12);
+    ASSERT_NEAR(0.0, kinematics.get_foot_velocities()(1, 0), 1e-12);
+    ASSERT_NEAR(0.0, kinematics.get_foot_velocities()(0, 1), 1e-12);
+    ASSERT_NEAR(0.2, kinematics.get_foot_velocities()(1, 1), 1e-12);
+
+    // compare the Jacobians to finite differences.
+    angles << 0.3, -0.4, 1.2, -0.7;
+    kinematics.update(angles, velocities);
+    LegKinematics<2>::LegVectors foot_positions =
+        kinematics.get_foot_positions();
+    std::array<Eigen::Matrix2d, 2> jacobians = {kinematics.get_jacobian(0),
+                                                kinematics.get_jacobian(1)};
+    const double delta = 1e-7;
+    for (int joint = 0; joint < 2; joint++)
+    {
+        LegKinematics<2>::LegVectors moved_angles = angles;
+        moved_angles.row(joint).array() += delta;
+        kinematics.update(moved_angles, velocities);
+        for (int leg = 0; leg < 2; leg++)
+        {
+            Eigen::Vector2d derivative =
+                (kinematics.get_foot_positions().col(leg) -
+                 foot_positions.col(leg)) /
+                delta;
+            ASSERT_TRUE(
+                derivative.isApprox(jacobians[leg].col(joint), 1e-5));
+        }
+    }
+}
+
+/*! Foot forces are mapped to the motor currents with the transposed
+ * Jacobian, gear ratios and motor constants */
+TEST(TestLegKinematics, foot_forces)
+{
+    auto leg = std::make_shared<FakeLeg>();
+    LegKinematicsParameters parameters;
+    parameters.gear_ratios << 10.0, 5.0;
+    parameters.motor_constants << 0.02, 0.04;
+    parameters.zero_angles << 0.1, 0.0;
+    LegKinematics<Eigen::Dynamic> kinematics({leg}, {parameters});
+    ASSERT_EQ(1u, kinematics.size());
+
+    // no measurement yet.
+    kinematics.update();
+    ASSERT_TRUE(std::isnan(kinematics.get_foot_positions()(0, 0)));
+
+    leg->measure(LegInterface::hip, 1.0, 10.0);
+    leg->measure(LegInterface::knee, M_PI / 2 * 5.0, 0.0);
+    kinematics.update();
+    ASSERT_NEAR(0.0, kinematics.get_joint_angles()(0, 0), 1e-12);
+    ASSERT_NEAR(M_PI / 2, kinematics.get_joint_angles()(1, 0), 1e-12);
+    ASSERT_NEAR(1.0, kinematics.get_joint_velocities()(0, 0), 1e-12);
+    ASSERT_NEAR(-0.16, kinematics.get_foot_positions()(0, 0), 1e-12);
+    ASSERT_NEAR(-0.16, kinematics.get_foot_positions()(1, 0), 1e-12);
+
+    Eigen::Matrix<double, 2, Eigen::Dynamic> forces(2, 1), torques(2, 1);
+    forces << 0.0, 10.0;
+    kinematics.get_joint_torques(forces, torques);
+    ASSERT_TRUE(torques.isApprox(
+        kinematics.get_jacobian(0).transpose() * forces, 1e-12));
+    ASSERT_NEAR(1.6, torques(0, 0), 1e-12);
+    ASSERT_NEAR(1.6, torques(1, 0), 1e-12);
+
+    kinematics.set_foot_forces(forces);
+    ASSERT_NEAR(1.6 / (10.0 * 0.02),
+                leg->get_current_target(LegInterface::hip)->newest_element(),
+                1e-12);
+    ASSERT_NEAR(1.6 / (5.0 * 0.04),
+                leg->get_current_target(LegInterface::knee)->newest_element(),
+                1e-12);
+    kinematics.send_if_input_changed();
+    ASSERT_EQ(1, leg->send_count);
+}
+
+/*! Wrong parameters are refused */
+TEST(TestLegKinematics, invalid_parameters)
+{
+    auto leg = std::make_shared<FakeLeg>();
+    LegKinematicsParameters parameters;
+    ASSERT_THROW(LegKinematics<Eigen::Dynamic>({leg}, {}),
+                 std::invalid_argument);
+    parameters.gear_ratios[1] = 0.0;
+    ASSERT_THROW(LegKinematics<Eigen::Dynamic>({leg}, {parameters}),
+                 std::invalid_argument);
+}
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
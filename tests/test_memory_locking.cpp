@@ -0,0 +1,54 @@
+/**
+ * @file test_memory_locking.cpp
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, Max Planck Gesellschaft.
+ * @brief Tests for the memory locking.
+ */
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "blmc_drivers/utils/memory_locking.hpp"
+
+using namespace blmc_drivers;
+
+/*! Once the memory is locked, allocating and using buffers does not page
+ * fault */
+TEST(TestMemoryLocking, no_page_faults_after_locking)
+{
+    std::vector<double> buffer_before_locking(100000);
+
+    MemoryLockReport report;
+    try
+    {
+        report = lock_memory(4 * 1024 * 1024, 256 * 1024);
+    }
+    catch (const std::runtime_error& error)
+    {
+        GTEST_SKIP() << error.what();
+    }
+    ASSERT_GT(report.locked_bytes, 0u);
+    ASSERT_GT(report.writable_bytes, 0u);
+    ASSERT_EQ(0u, report.non_resident_bytes);
+
+    uint64_t page_fault_count = get_thread_page_fault_count();
+    for (size_t i = 0; i < buffer_before_locking.size(); i++)
+    {
+        buffer_before_locking[i] = i;
+    }
+    std::vector<double> buffer_after_locking(100000, 1.0);
+    prefault_stack(128 * 1024);
+    ASSERT_EQ(page_fault_count, get_thread_page_fault_count());
+
+    // the stacks of new threads are locked as well.
+    std::thread thread([]() { prefault_stack(128 * 1024); });
+    thread.join();
+    ASSERT_EQ(0u, check_memory_residency().non_resident_bytes);
+}
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
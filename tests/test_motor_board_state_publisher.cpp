@@ -0,0 +1,77 @@
+/**
+ * @file test_motor_board_state_publisher.cpp
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, Max Planck Gesellschaft.
+ * @brief Tests for the export of the state of a motor board.
+ */
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <cmath>
+#include <memory>
+
+#include <real_time_tools/timer.hpp>
+
+#include "blmc_drivers/devices/motor_board_state_publisher.hpp"
+#include "scripted_can_bus.hpp"
+
+using namespace blmc_drivers;
+
+/*! A snapshot is published by the board thread for each position */
+TEST(TestMotorBoardStatePublisher, snapshot_per_position)
+{
+    auto can_bus = std::make_shared<ScriptedCanBus>();
+    auto board = std::make_shared<CanBusMotorBoard>(can_bus, 100);
+    can_bus->receive(ScriptedCanBus::STATUSMSG, 0.0, 0.0);
+    ASSERT_TRUE(board->get_status()->wait_for_timeindex(0, 1.0));
+
+    MotorBoardStatePublisher publisher(
+        board, can_bus, "blmc_drivers_test_board_state", 100);
+    MotorBoardStateReader reader("blmc_drivers_test_board_state");
+    MotorBoardStateRecord record;
+    ASSERT_EQ(-1, reader.read_newest(record));
+
+    board->set_control(1.0, MotorBoardInterface::current_target_0);
+    board->set_control(-2.0, MotorBoardInterface::current_target_1);
+    board->send_if_input_changed();
+
+    // speeds alone do not make a snapshot.
+    can_bus->receive(ScriptedCanBus::SPEED, 0.0, 0.0);
+    ASSERT_TRUE(board->get_measurement(MotorBoardInterface::velocity_0)
+                    ->wait_for_timeindex(0, 1.0));
+    can_bus->receive(ScriptedCanBus::STATUSMSG, 0.0, 0.0);
+    ASSERT_TRUE(board->get_status()->wait_for_timeindex(1, 1.0));
+    usleep(10000);
+    ASSERT_EQ(-1, reader.read_newest(record));
+
+    can_bus->receive(ScriptedCanBus::POS, 0.25, 0.5);
+    double end_time_s = real_time_tools::Timer::get_current_time_sec() + 5.0;
+    while (reader.read_newest(record) < 0 &&
+           real_time_tools::Timer::get_current_time_sec() < end_time_s)
+    {
+        usleep(1000);
+    }
+    ASSERT_EQ(0, reader.read_newest(record));
+
+    ASSERT_EQ(1, record.measurement_counts[MotorBoardInterface::position_0]);
+    ASSERT_EQ(1, record.measurement_counts[MotorBoardInterface::velocity_0]);
+    ASSERT_EQ(0, record.measurement_counts[MotorBoardInterface::current_0]);
+    ASSERT_EQ(board->get_measurement(MotorBoardInterface::position_1)
+                  ->newest_element(),
+              record.measurements[MotorBoardInterface::position_1]);
+    ASSERT_TRUE(
+        std::isnan(record.measurements[MotorBoardInterface::current_0]));
+    ASSERT_EQ(1.0,
+              record.sent_controls[MotorBoardInterface::current_target_0]);
+    ASSERT_EQ(-2.0,
+              record.sent_controls[MotorBoardInterface::current_target_1]);
+    ASSERT_TRUE(record.has_status);
+    // the counters are only available for a CanBus.
+    ASSERT_EQ(-1, record.can_bus_received_frames);
+    ASSERT_EQ(-1, record.can_bus_sent_frames);
+}
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,117 @@
+/**
+ * @file test_phase_locked_scheduler.cpp
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, Max Planck Gesellschaft.
+ * @brief Tests for the phase-locked scheduler.
+ */
+#include <gtest/gtest.h>
+#include <atomic>
+#include <memory>
+#include <thread>
+
+#include "blmc_drivers/phase_locked_scheduler.hpp"
+
+using namespace blmc_drivers;
+
+typedef PhaseLockedScheduler::ScalarTimeseries ScalarTimeseries;
+
+namespace
+{
+/**
+ * @brief Appends to a time series at a fixed rate, like a board.
+ */
+class FakeBoard
+{
+public:
+    FakeBoard(const double& period_s)
+        : series_(std::make_shared<ScalarTimeseries>(1000, 0, false)),
+          is_running_(true)
+    {
+        thread_ = std::thread([this, period_s]() {
+            HybridSpinner spinner(period_s);
+            while (is_running_)
+            {
+                series_->append(0.0);
+                spinner.spin();
+            }
+        });
+    }
+
+    ~FakeBoard()
+    {
+        is_running_ = false;
+        thread_.join();
+    }
+
+    std::shared_ptr<ScalarTimeseries> series_;
+    std::atomic<bool> is_running_;
+    std::thread thread_;
+};
+
+}  // namespace
+
+/*! The loop runs once per frame, at the offset after the frame */
+TEST(TestPhaseLockedScheduler, locks_to_frames)
+{
+    const double period_s = 0.001;
+    const double offset_s = 200e-6;
+    FakeBoard board(period_s);
+    PhaseLockedScheduler scheduler({board.series_}, offset_s);
+
+    int tick_count = 0;
+    while (tick_count < 200 && scheduler.tick([&]() { tick_count++; }))
+    {
+    }
+
+    ASSERT_EQ(200, tick_count);
+    ASSERT_EQ(200u, scheduler.get_tick_count());
+    ASSERT_EQ(200u, scheduler.get_loop_delays().get_count());
+    // the loop is never triggered before the offset...
+    ASSERT_GE(scheduler.get_loop_delays().get_min(), offset_s * 0.99);
+    // ... and typically not much later.
+    ASSERT_LT(scheduler.get_loop_delays().get_percentile(50),
+              offset_s + period_s / 2);
+    // the loop is much faster than the frames, so it misses few of them.
+    ASSERT_LT(scheduler.get_skipped_frame_count(), 20u);
+    ASSERT_GT(scheduler.get_phase_errors().get_count(), 0u);
+
+    scheduler.reset_statistics();
+    ASSERT_EQ(0u, scheduler.get_tick_count());
+    ASSERT_EQ(0u, scheduler.get_loop_delays().get_count());
+}
+
+/*! With several boards, all of them have fresh data at each tick */
+TEST(TestPhaseLockedScheduler, several_boards)
+{
+    FakeBoard board_a(0.001);
+    FakeBoard board_b(0.001);
+    PhaseLockedScheduler scheduler({board_a.series_, board_b.series_}, 0.0);
+
+    ASSERT_TRUE(scheduler.wait_for_fresh_data());
+    for (int i = 0; i < 50; i++)
+    {
+        // the data of every board is newer than at the previous tick.
+        double data_time_s = scheduler.get_data_time();
+        ASSERT_TRUE(scheduler.wait_for_fresh_data());
+        ASSERT_GT(scheduler.get_data_time(), data_time_s);
+    }
+}
+
+/*! Without data, waiting times out */
+TEST(TestPhaseLockedScheduler, timeout)
+{
+    auto series = std::make_shared<ScalarTimeseries>(100, 0, false);
+    series->append(0.0);
+    PhaseLockedScheduler scheduler({series}, 0.0);
+
+    bool has_run = false;
+    ASSERT_FALSE(scheduler.tick([&]() { has_run = true; }));
+    ASSERT_FALSE(has_run);
+    ASSERT_EQ(1u, scheduler.get_unpredicted_frame_count());
+}
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,73 @@
+/**
+ * @file test_position_unwrapper.cpp
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, Max Planck Gesellschaft.
+ * @brief Tests for the multi-turn position unwrapping.
+ */
+#include <gtest/gtest.h>
+#include <cmath>
+
+#include "blmc_drivers/utils/position_unwrapper.hpp"
+
+using namespace blmc_drivers;
+
+/**
+ * @brief Map a continuous position to [-range/2, range/2) like the board.
+ */
+static double wrap(double position, double range)
+{
+    return position - range * std::floor(position / range + 0.5);
+}
+
+/*! Positions stay continuous over many rollovers in both directions */
+TEST(TestPositionUnwrapper, continuous_over_rollovers)
+{
+    const double range = 2 * 100 * 2 * M_PI;
+    PositionUnwrapper unwrapper(range);
+
+    double position = 0.3;
+    const double step = 7.3;  // rad per sample
+    for (int i = 0; i < 100000; i++)
+    {
+        position += step;
+        ASSERT_NEAR(position, unwrapper.unwrap(wrap(position, range)), 1e-6);
+    }
+    ASSERT_GT(unwrapper.get_turn_count(), 500);
+
+    for (int i = 0; i < 200000; i++)
+    {
+        position -= step;
+        ASSERT_NEAR(position, unwrapper.unwrap(wrap(position, range)), 1e-6);
+    }
+    ASSERT_LT(unwrapper.get_turn_count(), -500);
+}
+
+/*! Samples close to the last one are mapped to the same turn */
+TEST(TestPositionUnwrapper, unwrap_nearby)
+{
+    const double range = 10.0;
+    PositionUnwrapper unwrapper(range);
+
+    ASSERT_EQ(1.0, unwrapper.unwrap_nearby(1.0));
+
+    unwrapper.unwrap(4.0);
+    unwrapper.unwrap(-4.9);  // rolled over, continuous position is 5.1
+    ASSERT_EQ(1, unwrapper.get_turn_count());
+
+    // an index seen just before the rollover
+    ASSERT_DOUBLE_EQ(4.8, unwrapper.unwrap_nearby(4.8));
+    // and one just after
+    ASSERT_DOUBLE_EQ(5.2, unwrapper.unwrap_nearby(-4.8));
+    // state is not changed
+    ASSERT_EQ(1, unwrapper.get_turn_count());
+
+    unwrapper.reset();
+    ASSERT_EQ(0, unwrapper.get_turn_count());
+    ASSERT_EQ(-4.8, unwrapper.unwrap(-4.8));
+}
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
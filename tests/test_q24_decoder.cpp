@@ -0,0 +1,114 @@
+/**
+ * @file test_q24_decoder.cpp
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, Max Planck Gesellschaft.
+ * @brief Tests for the batch decoding of Q24 payloads.
+ */
+#include <gtest/gtest.h>
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+#include "blmc_drivers/utils/q24_decoder.hpp"
+
+using namespace blmc_drivers;
+
+/**
+ * @brief Same memory layout as a received CanBusFrame.
+ */
+struct Payload
+{
+    std::array<uint8_t, 8> data;
+    uint8_t dlc;
+    uint32_t id;
+};
+
+/**
+ * @brief Write a big-endian int32 the same way the board does.
+ */
+static void write_big_endian(int32_t value, uint8_t* bytes)
+{
+    uint32_t raw = static_cast<uint32_t>(value);
+    bytes[0] = (raw >> 24) & 0xFF;
+    bytes[1] = (raw >> 16) & 0xFF;
+    bytes[2] = (raw >> 8) & 0xFF;
+    bytes[3] = raw & 0xFF;
+}
+
+/*! Decoding must match the reference conversion for any batch size */
+TEST(TestQ24Decoder, matches_reference)
+{
+    constexpr size_t count = 7;
+    const std::array<int32_t, 2 * count> raw = {0,
+                                                 1,
+                                                 -1,
+                                                 1 << 24,
+                                                 -(1 << 24),
+                                                 INT32_MAX,
+                                                 INT32_MIN,
+                                                 123456789,
+                                                 -987654321,
+                                                 42,
+                                                 0x00FFFFFF,
+                                                 -0x00FFFFFF,
+                                                 1677721600,
+                                                 -1677721599};
+
+    std::array<Payload, count> payloads;
+    std::array<double, count> scales;
+    for (size_t i = 0; i < count; i++)
+    {
+        write_big_endian(raw[2 * i], payloads[i].data.begin());
+        write_big_endian(raw[2 * i + 1], payloads[i].data.begin() + 4);
+        scales[i] = (i % 2 == 0) ? 1.0 : 2 * M_PI;
+    }
+
+    for (size_t batch = 0; batch <= count; batch++)
+    {
+        std::array<double, 2 * count> out;
+        out.fill(std::nan(""));
+        decode_q24_pairs(payloads[0].data.begin(),
+                         sizeof(Payload),
+                         batch,
+                         scales.begin(),
+                         out.begin());
+
+        for (size_t i = 0; i < batch; i++)
+        {
+            ASSERT_DOUBLE_EQ(q24_to_double(raw[2 * i]) * scales[i],
+                             out[2 * i]);
+            ASSERT_DOUBLE_EQ(q24_to_double(raw[2 * i + 1]) * scales[i],
+                             out[2 * i + 1]);
+        }
+        for (size_t i = 2 * batch; i < out.size(); i++)
+        {
+            ASSERT_TRUE(std::isnan(out[i]));
+        }
+    }
+}
+
+/*! Large multi-turn positions keep their full resolution */
+TEST(TestQ24Decoder, keeps_full_precision)
+{
+    // 100 revolutions plus one LSB.
+    const int32_t raw = (100 << 24) + 1;
+    Payload payload;
+    write_big_endian(raw, payload.data.begin());
+    write_big_endian(-raw, payload.data.begin() + 4);
+    double scale = 1.0;
+    std::array<double, 2> out;
+
+    decode_q24_pairs(payload.data.begin(), sizeof(Payload), 1, &scale,
+                     out.begin());
+
+    ASSERT_EQ(100.0 + 1.0 / (1 << 24), out[0]);
+    ASSERT_EQ(-100.0 - 1.0 / (1 << 24), out[1]);
+    // the float conversion used before loses the last bit
+    ASSERT_NE(out[0], static_cast<double>(static_cast<float>(raw) / (1 << 24)));
+}
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
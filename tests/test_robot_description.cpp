@@ -0,0 +1,200 @@
+/**
+ * @file test_robot_description.cpp
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, Max Planck Gesellschaft.
+ * @brief Tests for loading a robot description and building its drivers.
+ */
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+
+#include "blmc_drivers/blmc_robot.hpp"
+#include "blmc_drivers/robot_description.hpp"
+
+using namespace blmc_drivers;
+
+namespace
+{
+/**
+ * @brief Robot with three joints on two simulated buses.
+ */
+const char* LOOPBACK_ROBOT = R"(
+# two legs of a robot
+[bus front]
+interface = loopback
+[bus back]
+interface = loopback
+history_length = 500
+
+[board front]
+bus = front
+control_timeout_ms = 0
+[board back]
+bus = back
+
+[joint hip]
+board = front
+motor = 0
+gear_ratio = 9
+[joint knee]
+board = front
+motor = 1
+gear_ratio = 9
+reverse_polarity = true   # mounted the other way
+[joint tail]
+board = back
+motor_constant = 0.02
+max_velocity = 10
+continuous_current = 1.5
+
+[sensor slider]
+board = back
+sensor = 1
+)";
+
+RobotDescription parse(const std::string& text)
+{
+    std::istringstream stream(text);
+    return parse_robot_description(stream, "test");
+}
+
+/**
+ * @brief Expect parsing to fail with an error message containing the given
+ * text.
+ */
+void expect_error(const std::string& text, const std::string& message)
+{
+    try
+    {
+        parse(text);
+        FAIL() << "no error for: " << text;
+    }
+    catch (const std::runtime_error& e)
+    {
+        EXPECT_NE(std::string::npos, std::string(e.what()).find(message))
+            << e.what();
+    }
+}
+
+}  // namespace
+
+/*! All sections and keys end up in the description */
+TEST(TestRobotDescription, parse)
+{
+    RobotDescription robot = parse(LOOPBACK_ROBOT);
+    ASSERT_EQ(2u, robot.buses.size());
+    ASSERT_EQ("back", robot.buses[1].name);
+    ASSERT_EQ("loopback", robot.buses[1].interface);
+    ASSERT_EQ(500u, robot.buses[1].history_length);
+    ASSERT_EQ(1000u, robot.buses[0].history_length);
+
+    ASSERT_EQ(2u, robot.boards.size());
+    ASSERT_EQ(0, robot.boards[0].control_timeout_ms);
+
+    ASSERT_EQ(3u, robot.joints.size());
+    ASSERT_EQ("knee", robot.joints[1].name);
+    ASSERT_EQ(1, robot.joints[1].motor_index);
+    ASSERT_EQ(9.0, robot.joints[1].gear_ratio);
+    ASSERT_TRUE(robot.joints[1].reverse_polarity);
+    ASSERT_FALSE(robot.joints[0].reverse_polarity);
+    ASSERT_EQ(0.02, robot.joints[2].motor_constant);
+    ASSERT_EQ(10.0, robot.joints[2].max_velocity);
+    ASSERT_TRUE(std::isnan(robot.joints[0].max_velocity));
+    ASSERT_EQ(1.5, robot.joints[2].continuous_current);
+    ASSERT_EQ(0.0, robot.joints[0].continuous_current);
+
+    ASSERT_EQ(1u, robot.analog_sensors.size());
+    ASSERT_EQ(1, robot.analog_sensors[0].sensor_index);
+}
+
+/*! Errors are reported with their line */
+TEST(TestRobotDescription, errors)
+{
+    expect_error("[bus a]\ninterface = can0\nspeed = 3\n",
+                 "test:3: unknown key \"speed\"");
+    expect_error("[motor a]\n", "test:1: unknown section");
+    expect_error("[bus]\n", "section needs a name");
+    expect_error("[bus a\n", "expected ']'");
+    expect_error("interface = can0\n", "key outside of a section");
+    expect_error("[bus a]\ninterface\n", "expected 'key = value'");
+    expect_error("[bus a]\ncpu = two\n", "test:2: cpu: expected an integer");
+    expect_error("[bus a]\nhistory_length = -1\n", "positive integer");
+    expect_error("[bus a]\ninterface = can0\n[bus a]\n", "duplicate name");
+    expect_error("[bus a]\n", "bus \"a\" has no interface");
+    expect_error("[board b]\nbus = a\n", "unknown bus \"a\"");
+    expect_error(
+        "[bus a]\ninterface = can0\n[board b]\nbus = a\n[board c]\nbus = a\n",
+        "more than one board");
+    expect_error(
+        "[bus a]\ninterface = can0\n[board b]\nbus = a\n"
+        "[joint x]\nboard = b\n[joint y]\nboard = b\n",
+        "motor 0 of board \"b\" is used twice");
+    expect_error(
+        "[bus a]\ninterface = can0\n[board b]\nbus = a\n"
+        "[joint x]\nboard = b\nmotor = 2\n",
+        "must be 0 or 1");
+    expect_error(
+        "[bus a]\ninterface = can0\n[board b]\nbus = a\n"
+        "[joint x]\nboard = b\nreverse_polarity = maybe\n",
+        "expected true or false");
+    expect_error(
+        "[bus a]\ninterface = can0\n[board b]\nbus = a\n"
+        "[joint x]\nboard = b\ncontinuous_current = 3\n",
+        "continuous_current of joint \"x\" is above its max_current");
+}
+
+/*! The drivers of a robot on simulated buses can be used right away */
+TEST(TestRobotDescription, build_robot)
+{
+    BlmcRobot robot(parse(LOOPBACK_ROBOT));
+    ASSERT_GE(robot.get_bring_up_duration_s(), 0.0);
+
+    std::vector<std::string> joint_names = robot.get_joint_names();
+    ASSERT_EQ(3u, joint_names.size());
+    ASSERT_EQ("tail", joint_names[2]);
+    ASSERT_NE(nullptr, robot.get_motor_board("back"));
+    ASSERT_NE(nullptr, robot.get_can_bus("front"));
+    ASSERT_NE(nullptr, robot.get_analog_sensor("slider"));
+    ASSERT_THROW(robot.get_motor("neck"), std::invalid_argument);
+    ASSERT_EQ(nullptr, robot.get_motor("hip")->get_thermal_limiter());
+    ASSERT_EQ(2.0,
+              robot.get_motor("tail")
+                  ->get_thermal_limiter()
+                  ->get_parameters()
+                  .peak_current);
+
+    // the loopback boards measure the requested currents.
+    auto joints = robot.get_joint_modules();
+    ASSERT_EQ(3u, joints->size());
+    Eigen::VectorXd torques(3);
+    torques << 0.1, 0.1, 0.01;
+    joints->set_torques(torques);
+    joints->send_torques();
+
+    Eigen::VectorXd measured_torques(3);
+    for (int i = 0; i < 1000; i++)
+    {
+        joints->get_measured_torques(measured_torques);
+        if (measured_torques.isApprox(torques, 1e-6))
+        {
+            break;
+        }
+        usleep(1000);
+    }
+    ASSERT_TRUE(measured_torques.isApprox(torques, 1e-6));
+
+    // the knee is reversed.
+    ASSERT_NEAR(-0.1 / 9 / 0.025,
+                robot.get_motor("knee")
+                    ->get_sent_current_target()
+                    ->newest_element(),
+                1e-9);
+}
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
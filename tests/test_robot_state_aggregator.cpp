@@ -0,0 +1,196 @@
+/**
+ * @file test_robot_state_aggregator.cpp
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, Max Planck Gesellschaft.
+ * @brief Tests for the RobotStateAggregator.
+ */
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cmath>
+#include <memory>
+
+#include "blmc_drivers/blmc_joint_module.hpp"
+#include "blmc_drivers/robot_state_aggregator.hpp"
+
+using namespace blmc_drivers;
+
+namespace
+{
+/**
+ * @brief Motor whose measurements are appended by the test.
+ */
+class FakeMotor : public MotorInterface
+{
+public:
+    FakeMotor()
+    {
+        for (auto& measurement : measurements_)
+        {
+            measurement = std::make_shared<ScalarTimeseries>(100, 0, false);
+        }
+        current_target_ = std::make_shared<ScalarTimeseries>(100, 0, false);
+    }
+
+    void send_if_input_changed() override
+    {
+    }
+
+    Ptr<const ScalarTimeseries> get_measurement(
+        const int& index = 0) const override
+    {
+        return measurements_[index];
+    }
+
+    Ptr<const ScalarTimeseries> get_current_target() const override
+    {
+        return current_target_;
+    }
+
+    Ptr<const ScalarTimeseries> get_sent_current_target() const override
+    {
+        return current_target_;
+    }
+
+    void set_current_target(const double& current_target) override
+    {
+        current_target_->append(current_target);
+    }
+
+    void set_command(const MotorBoardCommand&) override
+    {
+    }
+
+    /**
+     * @brief Append a position, velocity and current measurement.
+     */
+    void measure(const double& position,
+                 const double& velocity,
+                 const double& current)
+    {
+        measurements_[position_index]->append(position);
+        measurements_[velocity_index]->append(velocity);
+        measurements_[current_index]->append(current);
+    }
+
+    static constexpr int position_index = MotorInterface::position;
+    static constexpr int velocity_index = MotorInterface::velocity;
+    static constexpr int current_index = MotorInterface::current;
+
+    std::array<Ptr<ScalarTimeseries>, measurement_count> measurements_;
+    Ptr<ScalarTimeseries> current_target_;
+};
+
+/**
+ * @brief Expected value of a joint at time_s: linear in its two samples,
+ * extrapolated by at most one period.
+ */
+double interpolate(const double& value_0,
+                   const double& time_0_s,
+                   const double& value_1,
+                   const double& time_1_s,
+                   const double& time_s)
+{
+    double period_s = time_1_s - time_0_s;
+    double dt = std::max(-period_s, std::min(time_s - time_1_s, period_s));
+    return value_1 + (value_1 - value_0) / period_s * dt;
+}
+
+}  // namespace
+
+/*! Joints without measurements are NaN */
+TEST(TestRobotStateAggregator, no_measurements)
+{
+    auto motor = std::make_shared<FakeMotor>();
+    auto joint = std::make_shared<BlmcJointModule>(motor, 0.025, 1.0, 0.0);
+    RobotStateAggregator aggregator({joint});
+
+    aggregator.update_aligned();
+    const RobotState& state = aggregator.get_state();
+    ASSERT_EQ(1, state.positions.size());
+    ASSERT_TRUE(std::isnan(state.positions[0]));
+    ASSERT_TRUE(std::isnan(state.skew_s));
+    ASSERT_FALSE(state.is_aligned);
+}
+
+/*! The skew between joints sampled at different times is measured and
+ * removed by the alignment */
+TEST(TestRobotStateAggregator, skew_and_alignment)
+{
+    auto motor_a = std::make_shared<FakeMotor>();
+    auto motor_b = std::make_shared<FakeMotor>();
+    RobotStateAggregator aggregator(
+        {std::make_shared<BlmcJointModule>(motor_a, 0.025, 2.0, 0.0),
+         std::make_shared<BlmcJointModule>(motor_b, 0.025, 1.0, 0.0)});
+
+    // joint a moves from 0 to 1 rad, 50 ms later joint b from 0 to 2 rad.
+    motor_a->measure(0.0, 0.0, 0.0);
+    usleep(5000);
+    motor_a->measure(2.0, 2.0, 4.0);
+    usleep(50000);
+    motor_b->measure(0.0, 0.0, 0.0);
+    usleep(5000);
+    motor_b->measure(2.0, 2.0, 4.0);
+
+    auto positions_a = motor_a->get_measurement(FakeMotor::position_index);
+    auto positions_b = motor_b->get_measurement(FakeMotor::position_index);
+    double time_a0 = positions_a->timestamp_s(0);
+    double time_a1 = positions_a->timestamp_s(1);
+    double time_b1 = positions_b->timestamp_s(1);
+
+    aggregator.update();
+    const RobotState& state = aggregator.get_state();
+    ASSERT_FALSE(state.is_aligned);
+    ASSERT_DOUBLE_EQ(1.0, state.positions[0]);
+    ASSERT_DOUBLE_EQ(2.0, state.positions[1]);
+    ASSERT_DOUBLE_EQ(0.025 * 2.0 * 4.0, state.torques[0]);
+    ASSERT_DOUBLE_EQ(time_b1, state.time_s);
+    ASSERT_DOUBLE_EQ(time_b1 - time_a1, state.skew_s);
+    ASSERT_GT(state.skew_s, 0.0);
+    ASSERT_EQ(1u, aggregator.get_skews().get_count());
+
+    // in the middle of the samples of joint a, joint b is extrapolated
+    // backwards by at most one of its periods.
+    double time_s = (time_a0 + time_a1) / 2;
+    aggregator.update_aligned(time_s);
+    ASSERT_TRUE(state.is_aligned);
+    ASSERT_DOUBLE_EQ(time_s, state.time_s);
+    ASSERT_NEAR(0.5, state.positions[0], 1e-9);
+    // the velocities are timestamped slightly after the positions.
+    auto velocities_a = motor_a->get_measurement(FakeMotor::velocity_index);
+    ASSERT_NEAR(interpolate(0.0,
+                            velocities_a->timestamp_s(0),
+                            1.0,
+                            velocities_a->timestamp_s(1),
+                            time_s),
+                state.velocities[0],
+                1e-9);
+    ASSERT_NEAR(0.0, state.positions[1], 1e-9);
+    ASSERT_DOUBLE_EQ(time_s, state.timestamps_s[1]);
+
+    // at the newest sample, joint a is extrapolated by at most one period.
+    aggregator.update_aligned();
+    ASSERT_DOUBLE_EQ(time_b1, state.time_s);
+    ASSERT_NEAR(interpolate(0.0, time_a0, 1.0, time_a1, time_b1),
+                state.positions[0],
+                1e-9);
+    ASSERT_NEAR(2.0, state.positions[1], 1e-9);
+}
+
+/*! The aggregator can be built from joint modules */
+TEST(TestRobotStateAggregator, from_joint_modules)
+{
+    std::array<std::shared_ptr<MotorInterface>, 2> motors = {
+        std::make_shared<FakeMotor>(), std::make_shared<FakeMotor>()};
+    Eigen::Vector2d ones = Eigen::Vector2d::Ones();
+    BlmcJointModules<2> joints(motors, ones, ones, 0 * ones, ones);
+
+    RobotStateAggregator aggregator(joints);
+    ASSERT_EQ(2u, aggregator.size());
+}
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
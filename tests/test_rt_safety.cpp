@@ -0,0 +1,118 @@
+/**
+ * @file test_rt_safety.cpp
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, Max Planck Gesellschaft.
+ * @brief Tests for the real-time safety checker, which has to be loaded into
+ * this test.
+ */
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "blmc_drivers/devices/loopback_can_bus.hpp"
+#include "blmc_drivers/devices/motor.hpp"
+#include "blmc_drivers/devices/motor_board.hpp"
+#include "blmc_drivers/utils/rt_safety.hpp"
+
+using namespace blmc_drivers;
+
+class TestRtSafety : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        ASSERT_TRUE(is_rt_safety_checker_loaded());
+        reset_rt_safety_violations();
+    }
+};
+
+/*! Calls outside of real-time sections are fine */
+TEST_F(TestRtSafety, outside_of_sections)
+{
+    std::unique_ptr<int> value(new int(0));
+    std::string text(100, 'x');
+    ASSERT_EQ(nullptr, get_current_rt_section());
+    ASSERT_EQ(0u, get_rt_safety_violation_count());
+}
+
+/*! Allocations, printing and throwing inside a section are recorded */
+TEST_F(TestRtSafety, violations)
+{
+    const char* inner_section_name;
+    const char* outer_section_name;
+    {
+        RtSection section("outer");
+        {
+            RtSection inner_section("inner");
+            inner_section_name = get_current_rt_section();
+            // volatile, so that the allocation is not optimized away.
+            int* volatile value = new int(0);
+            delete value;
+        }
+        outer_section_name = get_current_rt_section();
+        std::printf("printing in a real-time section\n");
+        try
+        {
+            throw std::runtime_error("error");
+        }
+        catch (const std::runtime_error&)
+        {
+        }
+    }
+    ASSERT_STREQ("inner", inner_section_name);
+    ASSERT_STREQ("outer", outer_section_name);
+    ASSERT_EQ(nullptr, get_current_rt_section());
+
+    uint64_t count = get_rt_safety_violation_count();
+    ASSERT_GE(count, 4u);
+    ASSERT_STREQ("malloc", get_rt_safety_violation(0).call);
+    ASSERT_STREQ("inner", get_rt_safety_violation(0).section);
+    ASSERT_STREQ("free", get_rt_safety_violation(1).call);
+
+    bool has_thrown = false;
+    for (size_t i = 2; i < count && i < MAX_RECORDED_RT_SAFETY_VIOLATIONS; i++)
+    {
+        RtSafetyViolation violation = get_rt_safety_violation(i);
+        ASSERT_STREQ("outer", violation.section);
+        has_thrown |= std::string(violation.call) == "__cxa_throw";
+    }
+    ASSERT_TRUE(has_thrown);
+}
+
+/*! Driving a motor board over a simulated bus does not violate real-time
+ * safety, neither in the control loop nor in the threads of the drivers */
+TEST_F(TestRtSafety, motor_board_on_loopback_bus)
+{
+    {
+        auto can_bus = std::make_shared<LoopbackCanBus>();
+        auto board = std::make_shared<CanBusMotorBoard>(can_bus);
+        auto motor = std::make_shared<Motor>(board, 0);
+        board->wait_until_ready();
+        reset_rt_safety_violations();
+
+        for (int i = 0; i < 500; i++)
+        {
+            {
+                RtSection section("control loop");
+                motor->set_current_target(0.001 * i);
+                motor->send_if_input_changed();
+                motor->get_measurement(Motor::current)->newest_element();
+            }
+            usleep(200);
+        }
+        if (get_rt_safety_violation_count() > 0)
+        {
+            print_rt_safety_violations();
+        }
+        ASSERT_EQ(0u, get_rt_safety_violation_count());
+    }
+}
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
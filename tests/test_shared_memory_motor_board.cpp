@@ -0,0 +1,152 @@
+/**
+ * @file test_shared_memory_motor_board.cpp
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, Max Planck Gesellschaft.
+ * @brief Tests for the MotorBoardServer and its SharedMemoryMotorBoard
+ * clients.
+ */
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include <real_time_tools/timer.hpp>
+
+#include "blmc_drivers/devices/loopback_can_bus.hpp"
+#include "blmc_drivers/devices/shared_memory_motor_board.hpp"
+
+using namespace blmc_drivers;
+
+namespace
+{
+/**
+ * @brief Wait until the newest element of the series is the given value.
+ *
+ * @return false if it is not within the timeout.
+ */
+bool wait_for_value(
+    std::shared_ptr<const MotorBoardInterface::ScalarTimeseries> series,
+    const double& value,
+    const double& timeout_s = 5.0)
+{
+    double end_time_s = real_time_tools::Timer::get_current_time_sec() +
+                        timeout_s;
+    while (real_time_tools::Timer::get_current_time_sec() < end_time_s)
+    {
+        if (series->length() > 0 && series->newest_element() == value)
+        {
+            return true;
+        }
+        usleep(1000);
+    }
+    return false;
+}
+
+/**
+ * @brief Counts the measurements of the board.
+ */
+class CountingListener : public MotorBoardListener
+{
+public:
+    void on_measurement(const int& /*index*/, const double& /*value*/) override
+    {
+        measurement_count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void on_status(const MotorBoardStatus& /*status*/) override
+    {
+    }
+
+    std::atomic<size_t> measurement_count{0};
+};
+
+}  // namespace
+
+/*! Controls of a client reach the board, its measurements the client */
+TEST(TestSharedMemoryMotorBoard, round_trip)
+{
+    auto can_bus = std::make_shared<LoopbackCanBus>();
+    auto board = std::make_shared<CanBusMotorBoard>(can_bus);
+    // like the blmc_driver_daemon, serve the board once it is enabled.
+    board->wait_until_ready();
+    MotorBoardServer server(board, "blmc_drivers_test_board", 100);
+    SharedMemoryMotorBoard client("blmc_drivers_test_board");
+
+    // the loopback answers the currents exactly like the references.
+    client.set_control(1.5, MotorBoardInterface::current_target_0);
+    client.set_control(-0.5, MotorBoardInterface::current_target_1);
+    client.send_if_input_changed();
+
+    ASSERT_TRUE(wait_for_value(
+        client.get_measurement(MotorBoardInterface::current_0), 1.5));
+    ASSERT_TRUE(wait_for_value(
+        client.get_measurement(MotorBoardInterface::current_1), -0.5));
+    ASSERT_EQ(1.5,
+              board->get_sent_control(MotorBoardInterface::current_target_0)
+                  ->newest_element());
+    ASSERT_EQ(-0.5,
+              board->get_sent_control(MotorBoardInterface::current_target_1)
+                  ->newest_element());
+
+    // a command is answered with a status in which the board is ready.
+    client.set_command(MotorBoardCommand(MotorBoardCommand::IDs::ENABLE_SYS,
+                                         MotorBoardCommand::Contents::ENABLE));
+    client.send_if_input_changed();
+    double end_time_s = real_time_tools::Timer::get_current_time_sec() + 5.0;
+    while (!client.is_ready() &&
+           real_time_tools::Timer::get_current_time_sec() < end_time_s)
+    {
+        usleep(1000);
+    }
+    ASSERT_TRUE(client.is_ready());
+}
+
+/*! Other listeners of a served board get the data as well */
+TEST(TestSharedMemoryMotorBoard, several_listeners)
+{
+    auto can_bus = std::make_shared<LoopbackCanBus>();
+    auto board = std::make_shared<CanBusMotorBoard>(can_bus);
+    board->wait_until_ready();
+    MotorBoardServer server(board, "blmc_drivers_test_board", 100);
+    SharedMemoryMotorBoard client("blmc_drivers_test_board");
+
+    auto listener = std::make_shared<CountingListener>();
+    board->add_listener(listener);
+    ASSERT_THROW(board->add_listener(listener), std::invalid_argument);
+    ASSERT_THROW(board->add_listener(nullptr), std::invalid_argument);
+
+    client.set_control(2.5, MotorBoardInterface::current_target_0);
+    client.set_control(0.0, MotorBoardInterface::current_target_1);
+    client.send_if_input_changed();
+    ASSERT_TRUE(wait_for_value(
+        client.get_measurement(MotorBoardInterface::current_0), 2.5));
+    ASSERT_GT(listener->measurement_count.load(), 0u);
+
+    ASSERT_TRUE(board->remove_listener(listener));
+    ASSERT_FALSE(board->remove_listener(listener));
+    size_t measurement_count = listener->measurement_count.load();
+
+    // the server is still notified.
+    client.set_control(-2.5, MotorBoardInterface::current_target_0);
+    client.send_if_input_changed();
+    ASSERT_TRUE(wait_for_value(
+        client.get_measurement(MotorBoardInterface::current_0), -2.5));
+    ASSERT_EQ(measurement_count, listener->measurement_count.load());
+
+    // the server and the listeners added now fill the board.
+    std::vector<std::shared_ptr<CountingListener>> listeners;
+    for (size_t i = 1; i < CanBusMotorBoard::MAX_LISTENER_COUNT; i++)
+    {
+        listeners.push_back(std::make_shared<CountingListener>());
+        board->add_listener(listeners.back());
+    }
+    ASSERT_THROW(board->add_listener(listener), std::runtime_error);
+}
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
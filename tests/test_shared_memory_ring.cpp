@@ -0,0 +1,168 @@
+/**
+ * @file test_shared_memory_ring.cpp
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, Max Planck Gesellschaft.
+ * @brief Tests for the shared memory ring buffer.
+ */
+#include <gtest/gtest.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <array>
+#include <stdexcept>
+
+#include "blmc_drivers/utils/shared_memory_ring.hpp"
+
+using namespace blmc_drivers;
+
+/**
+ * @brief Record with a checksum so that torn reads can be detected.
+ */
+struct TestRecord
+{
+    int64_t index;
+    std::array<double, 13> values;
+    int64_t checksum;
+};
+
+static TestRecord make_record(int64_t index)
+{
+    TestRecord record;
+    record.index = index;
+    for (size_t i = 0; i < record.values.size(); i++)
+    {
+        record.values[i] = index * 13 + i;
+    }
+    record.checksum = -index;
+    return record;
+}
+
+/*! Records can be read until they are overwritten */
+TEST(TestSharedMemoryRing, append_and_read)
+{
+    SharedMemoryRingWriter<TestRecord> writer("blmc_drivers_test_ring", 4);
+    SharedMemoryRingReader<TestRecord> reader("blmc_drivers_test_ring");
+    TestRecord record;
+
+    ASSERT_EQ(-1, reader.newest_index());
+    ASSERT_EQ(-1, reader.read_newest(record));
+    ASSERT_FALSE(reader.read(0, record));
+
+    for (int64_t i = 0; i < 10; i++)
+    {
+        writer.append(make_record(i));
+    }
+    ASSERT_EQ(9, reader.newest_index());
+    ASSERT_FALSE(reader.read(5, record));
+    ASSERT_FALSE(reader.read(10, record));
+    for (int64_t i = reader.oldest_index(); i <= 9; i++)
+    {
+        ASSERT_TRUE(reader.read(i, record));
+        ASSERT_EQ(i, record.index);
+        ASSERT_EQ(make_record(i).values, record.values);
+    }
+    ASSERT_EQ(9, reader.read_newest(record));
+}
+
+/*! Attaching fails for missing segments and mismatching types */
+TEST(TestSharedMemoryRing, attach_errors)
+{
+    ASSERT_THROW(SharedMemoryRingReader<TestRecord>("blmc_drivers_no_ring"),
+                 std::runtime_error);
+
+    SharedMemoryRingWriter<TestRecord> writer("blmc_drivers_test_ring", 4);
+    ASSERT_THROW(SharedMemoryRingReader<double>("blmc_drivers_test_ring"),
+                 std::runtime_error);
+}
+
+/*! A reader in another process never sees torn records */
+TEST(TestSharedMemoryRing, concurrent_reader_process)
+{
+    SharedMemoryRingWriter<TestRecord> writer("blmc_drivers_test_ring", 8);
+
+    pid_t pid = fork();
+    if (pid == 0)
+    {
+        SharedMemoryRingReader<TestRecord> reader("blmc_drivers_test_ring");
+        TestRecord record;
+        int64_t last_index = -1;
+        while (last_index < 99999)
+        {
+            int64_t index = reader.read_newest(record);
+            if (index < 0)
+            {
+                continue;
+            }
+            if (record.index != index || record.checksum != -index ||
+                record.values != make_record(index).values || index < last_index)
+            {
+                _exit(1);
+            }
+            last_index = index;
+        }
+        _exit(0);
+    }
+
+    for (int64_t i = 0; i < 100000; i++)
+    {
+        writer.append(make_record(i));
+    }
+    int status;
+    waitpid(pid, &status, 0);
+    ASSERT_TRUE(WIFEXITED(status));
+    ASSERT_EQ(0, WEXITSTATUS(status));
+}
+
+/*! A ring created by a reader gets exactly one writer at a time */
+TEST(TestSharedMemoryRing, reader_owned_ring)
+{
+    SharedMemoryRingReader<TestRecord> reader("blmc_drivers_test_ring", 4);
+    TestRecord record;
+    {
+        SharedMemoryRingWriter<TestRecord> writer("blmc_drivers_test_ring");
+        ASSERT_THROW(
+            SharedMemoryRingWriter<TestRecord>("blmc_drivers_test_ring"),
+            std::runtime_error);
+        writer.append(make_record(0));
+    }
+    // the segment survives the writer and the next one continues.
+    SharedMemoryRingWriter<TestRecord> writer("blmc_drivers_test_ring");
+    writer.append(make_record(1));
+    ASSERT_EQ(1, reader.read_newest(record));
+    ASSERT_EQ(1, record.index);
+}
+
+/*! Waiting readers are woken up by the writer of another process */
+TEST(TestSharedMemoryRing, wait_for_index)
+{
+    SharedMemoryRingReader<TestRecord> reader("blmc_drivers_test_ring", 4);
+    ASSERT_FALSE(reader.wait_for_index(0, 0.01));
+
+    pid_t pid = fork();
+    if (pid == 0)
+    {
+        SharedMemoryRingWriter<TestRecord> writer("blmc_drivers_test_ring");
+        for (int64_t i = 0; i < 100; i++)
+        {
+            usleep(100);
+            writer.append(make_record(i));
+        }
+        _exit(0);
+    }
+
+    for (int64_t i = 0; i < 100; i++)
+    {
+        ASSERT_TRUE(reader.wait_for_index(i, 5.0));
+        ASSERT_GE(reader.newest_index(), i);
+    }
+    int status;
+    waitpid(pid, &status, 0);
+    ASSERT_TRUE(WIFEXITED(status));
+    ASSERT_EQ(0, WEXITSTATUS(status));
+    ASSERT_TRUE(reader.wait_for_index(99, 0.0));
+}
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
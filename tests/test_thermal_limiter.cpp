@@ -0,0 +1,128 @@
+/**
+ * @file test_thermal_limiter.cpp
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, Max Planck Gesellschaft.
+ * @brief Tests for the I²t current limit.
+ */
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "blmc_drivers/utils/thermal_limiter.hpp"
+
+using namespace blmc_drivers;
+
+namespace
+{
+ThermalLimiterParameters get_parameters()
+{
+    ThermalLimiterParameters parameters;
+    parameters.continuous_current = 1.0;
+    parameters.peak_current = 3.0;
+    parameters.winding_time_constant_s = 10.0;
+    return parameters;
+}
+
+/**
+ * @brief Request the given current at 1 kHz for the given time, limited by
+ * the limiter.
+ *
+ * @return double the largest load seen.
+ */
+double run(ThermalLimiter& limiter,
+           const double& current,
+           const double& duration_s)
+{
+    const double dt_s = 0.001;
+    double max_load = limiter.get_load();
+    double applied_current = 0.0;
+    for (int i = 0; i < int(duration_s / dt_s); i++)
+    {
+        double limit = limiter.update(applied_current, dt_s);
+        applied_current = std::max(-limit, std::min(current, limit));
+        max_load = std::max(max_load, limiter.get_load());
+    }
+    return max_load;
+}
+
+}  // namespace
+
+/*! A cold motor may draw the peak current for a while */
+TEST(TestThermalLimiter, peaks_while_cold)
+{
+    ThermalLimiter limiter(get_parameters());
+    ASSERT_EQ(3.0, limiter.get_current_limit());
+    ASSERT_EQ(0.0, limiter.get_load());
+
+    // 9 times the continuous power, the derating starts after about 0.9 s.
+    run(limiter, 3.0, 0.2);
+    ASSERT_EQ(3.0, limiter.get_current_limit());
+    ASSERT_NEAR(9 * (1 - std::exp(-0.02)), limiter.get_load(), 1e-3);
+}
+
+/*! Under a permanent demand above the continuous current, the limit derates
+ * to the continuous current and the load does not exceed 1 */
+TEST(TestThermalLimiter, derates_to_continuous_current)
+{
+    ThermalLimiter limiter(get_parameters());
+    double max_load = run(limiter, -5.0, 100.0);
+    ASSERT_LE(max_load, 1.0 + 1e-3);
+    ASSERT_NEAR(1.0, limiter.get_load(), 1e-2);
+    ASSERT_NEAR(1.0, limiter.get_current_limit(), 0.1);
+
+    // at the continuous current the motor stays at the limit.
+    run(limiter, 1.0, 100.0);
+    ASSERT_NEAR(1.0, limiter.get_load(), 1e-3);
+
+    // and it cools down without current.
+    run(limiter, 0.0, 50.0);
+    ASSERT_LT(limiter.get_load(), 0.01);
+    ASSERT_EQ(3.0, limiter.get_current_limit());
+
+    run(limiter, 2.0, 1.0);
+    limiter.reset();
+    ASSERT_EQ(0.0, limiter.get_load());
+}
+
+/*! With a housing, the continuous current still reaches a load of 1, but
+ * the winding cools faster after a peak */
+TEST(TestThermalLimiter, housing)
+{
+    ThermalLimiterParameters parameters = get_parameters();
+    parameters.winding_time_constant_s = 1.0;
+    parameters.housing_time_constant_s = 20.0;
+    parameters.winding_fraction = 0.5;
+    ThermalLimiter limiter(parameters);
+
+    run(limiter, 1.0, 200.0);
+    ASSERT_NEAR(1.0, limiter.get_load(), 1e-3);
+
+    limiter.reset();
+    run(limiter, 3.0, 0.1);
+    double peak_load = limiter.get_load();
+    run(limiter, 0.0, 3.0);
+    ASSERT_LT(limiter.get_load(), 0.5 * peak_load);
+}
+
+/*! Inconsistent parameters are rejected */
+TEST(TestThermalLimiter, invalid_parameters)
+{
+    ThermalLimiterParameters parameters = get_parameters();
+    parameters.peak_current = 0.5;
+    ASSERT_THROW(ThermalLimiter limiter(parameters), std::invalid_argument);
+
+    parameters = get_parameters();
+    parameters.winding_time_constant_s = 0.0;
+    ASSERT_THROW(ThermalLimiter limiter(parameters), std::invalid_argument);
+
+    parameters = get_parameters();
+    parameters.derating_start = 1.0;
+    ASSERT_THROW(ThermalLimiter limiter(parameters), std::invalid_argument);
+}
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,199 @@
+/**
+ * @file test_tracing.cpp
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, Max Planck Gesellschaft.
+ * @brief Tests for the recording of the thread activity as Chrome trace.
+ */
+#include <gtest/gtest.h>
+#include <atomic>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "blmc_drivers/utils/tracing.hpp"
+
+using namespace blmc_drivers;
+
+namespace
+{
+size_t count_occurrences(const std::string& text, const std::string& pattern)
+{
+    size_t count = 0;
+    for (size_t position = text.find(pattern); position != std::string::npos;
+         position = text.find(pattern, position + 1))
+    {
+        count++;
+    }
+    return count;
+}
+
+}  // namespace
+
+class TestTracing : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        set_trace_thread_name("test");
+        set_tracing_enabled(false);
+        reset_trace();
+    }
+
+    void TearDown() override
+    {
+        set_tracing_enabled(false);
+        reset_trace();
+    }
+
+    std::string write_trace(size_t& event_count)
+    {
+        std::ostringstream stream;
+        event_count = write_chrome_trace(stream);
+        return stream.str();
+    }
+};
+
+/*! Nothing is recorded while tracing is disabled */
+TEST_F(TestTracing, disabled)
+{
+    ASSERT_FALSE(is_tracing_enabled());
+    {
+        TraceScope trace_scope("scope");
+        trace_instant("instant");
+    }
+
+    size_t event_count;
+    std::string trace = write_trace(event_count);
+    ASSERT_EQ(0u, event_count);
+    ASSERT_EQ(std::string::npos, trace.find("\"scope\""));
+}
+
+/*! Slices and instants of several threads are written with their names */
+TEST_F(TestTracing, threads)
+{
+    set_tracing_enabled(true);
+    std::thread thread([]() {
+        set_trace_thread_name("worker");
+        TraceScope trace_scope("work");
+        trace_instant("frame");
+    });
+    thread.join();
+    {
+        TraceScope outer_scope("outer");
+        TraceScope inner_scope("inner \"quoted\"");
+    }
+    set_tracing_enabled(false);
+
+    size_t event_count;
+    std::string trace = write_trace(event_count);
+    ASSERT_EQ(7u, event_count);
+    ASSERT_EQ(0u, trace.find("{\"traceEvents\":["));
+    ASSERT_NE(std::string::npos,
+              trace.find("\"args\":{\"name\":\"worker\"}"));
+    ASSERT_NE(std::string::npos, trace.find("\"args\":{\"name\":\"test\"}"));
+    ASSERT_EQ(2u, count_occurrences(trace, "\"ph\":\"M\""));
+    ASSERT_EQ(3u, count_occurrences(trace, "\"ph\":\"B\""));
+    ASSERT_EQ(3u, count_occurrences(trace, "\"ph\":\"E\""));
+    ASSERT_EQ(1u, count_occurrences(trace, "\"ph\":\"i\",\"ts\""));
+    ASSERT_NE(std::string::npos,
+              trace.find("\"name\":\"inner \\\"quoted\\\"\""));
+
+    // the outer slice begins before and ends after the inner one.
+    ASSERT_LT(trace.find("\"outer\""), trace.find("\"inner"));
+    ASSERT_LT(trace.rfind("\"inner"), trace.rfind("\"outer\""));
+}
+
+/*! Events of threads without name are dropped and counted */
+TEST_F(TestTracing, unregistered_thread)
+{
+    set_tracing_enabled(true);
+    std::thread thread([]() {
+        TraceScope trace_scope("work");
+        trace_instant("frame");
+    });
+    thread.join();
+    set_tracing_enabled(false);
+
+    size_t event_count;
+    std::string trace = write_trace(event_count);
+    ASSERT_EQ(0u, event_count);
+    ASSERT_EQ(std::string::npos, trace.find("\"work\""));
+    ASSERT_EQ(3u, get_dropped_trace_event_count());
+}
+
+/*! A slice begun while tracing is disabled records no end either */
+TEST_F(TestTracing, enabled_within_scope)
+{
+    {
+        TraceScope trace_scope("scope");
+        set_tracing_enabled(true);
+    }
+    set_tracing_enabled(false);
+
+    size_t event_count;
+    write_trace(event_count);
+    ASSERT_EQ(0u, event_count);
+}
+
+/*! Events beyond the buffer overwrite the oldest ones */
+TEST_F(TestTracing, full_buffer)
+{
+    set_tracing_enabled(true);
+    trace_instant("first");
+    for (size_t i = 0; i < TRACE_BUFFER_SIZE; i++)
+    {
+        trace_instant("instant");
+    }
+    trace_instant("last");
+    set_tracing_enabled(false);
+
+    size_t event_count;
+    std::string trace = write_trace(event_count);
+    ASSERT_EQ(TRACE_BUFFER_SIZE, event_count);
+    ASSERT_EQ(std::string::npos, trace.find("\"first\""));
+    ASSERT_NE(std::string::npos, trace.find("\"last\""));
+    ASSERT_LT(trace.rfind("\"instant\""), trace.find("\"last\""));
+    ASSERT_EQ(0u, get_dropped_trace_event_count());
+    ASSERT_EQ(2u, get_overwritten_trace_event_count());
+
+    reset_trace();
+    ASSERT_EQ(0u, get_overwritten_trace_event_count());
+    write_trace(event_count);
+    ASSERT_EQ(0u, event_count);
+}
+
+/*! A thread registered while tracing is disabled records once enabled */
+TEST_F(TestTracing, registered_before_enabled)
+{
+    std::atomic<bool> is_registered(false);
+    std::atomic<bool> should_record(false);
+    std::thread thread([&]() {
+        set_trace_thread_name("early");
+        is_registered = true;
+        while (!should_record)
+        {
+            std::this_thread::yield();
+        }
+        trace_instant("frame");
+    });
+    while (!is_registered)
+    {
+        std::this_thread::yield();
+    }
+    set_tracing_enabled(true);
+    should_record = true;
+    thread.join();
+    set_tracing_enabled(false);
+
+    size_t event_count;
+    std::string trace = write_trace(event_count);
+    ASSERT_EQ(1u, event_count);
+    ASSERT_NE(std::string::npos, trace.find("\"frame\""));
+    ASSERT_EQ(0u, get_dropped_trace_event_count());
+}
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
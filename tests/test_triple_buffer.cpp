@@ -0,0 +1,73 @@
+/**
+ * @file test_triple_buffer.cpp
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, Max Planck Gesellschaft.
+ * @brief Tests for the TripleBuffer.
+ */
+#include <gtest/gtest.h>
+#include <thread>
+
+#include "blmc_drivers/utils/triple_buffer.hpp"
+
+using namespace blmc_drivers;
+
+/*! The reader gets the newest written value once */
+TEST(TestTripleBuffer, newest_value)
+{
+    TripleBuffer<int> buffer;
+    ASSERT_FALSE(buffer.update());
+    ASSERT_EQ(0, buffer.get());
+
+    buffer.write(1);
+    buffer.write(2);
+    ASSERT_TRUE(buffer.update());
+    ASSERT_EQ(2, buffer.get());
+    ASSERT_FALSE(buffer.update());
+    ASSERT_EQ(2, buffer.get());
+
+    buffer.write(3);
+    ASSERT_TRUE(buffer.update());
+    ASSERT_EQ(3, buffer.get());
+}
+
+/*! Values written by another thread arrive complete and in order */
+TEST(TestTripleBuffer, threads)
+{
+    struct Pair
+    {
+        int first = 0;
+        int second = 0;
+    };
+    TripleBuffer<Pair> buffer;
+    const int write_count = 100000;
+
+    std::thread writer([&buffer]() {
+        for (int i = 1; i <= write_count; i++)
+        {
+            Pair pair;
+            pair.first = i;
+            pair.second = -i;
+            buffer.write(pair);
+        }
+    });
+
+    int last_value = 0;
+    while (last_value < write_count)
+    {
+        if (buffer.update())
+        {
+            const Pair& pair = buffer.get();
+            ASSERT_EQ(-pair.first, pair.second);
+            ASSERT_GT(pair.first, last_value);
+            last_value = pair.first;
+        }
+    }
+    writer.join();
+    ASSERT_FALSE(buffer.update());
+}
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}